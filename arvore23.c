@@ -1,431 +1,667 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <pthread.h>
+#include "log.h"
+#include "conjunto.h"
+#include "contadores.h"
+#include "histograma.h"
+#include "rastro.h"
+#include "servidor.h"
+#include "ordenacao.h"
+
+// Árvore B de ordem definida em tempo de compilação. A ordem é o número máximo
+// de filhos de um nó; com ORDEM 3 (padrão) ela é exatamente a árvore 2-3.
+// Compilar com: gcc arvore23.c -o arvore23 -DORDEM=16 -pthread
+// (ORDEM 16 = 15 chaves int por nó, que ocupam uma linha de cache de 64 bytes)
+// Com -DCONTADORES=1 as operações são contadas (ver contadores.h e a opção 18)
+#ifndef ORDEM
+#define ORDEM 3
+#endif
+
+#if ORDEM < 3
+#error "ORDEM deve ser pelo menos 3"
+#endif
+
+// Agregados de subárvore (contagem, soma, mínimo e máximo do dado associado a
+// cada chave) para consultas de intervalo em O(log n). Compile com
+// -DAGREGADOS=0 para medir a árvore sem esse aumento.
+#ifndef AGREGADOS
+#define AGREGADOS 1
+#endif
+
+#define MAX_CHAVES (ORDEM - 1)              // Máximo de chaves por nó
+#define MIN_CHAVES ((ORDEM + 1) / 2 - 1)    // Mínimo de chaves (exceto a raiz)
+
+#define INTERVALO_INSTANTANEO 100000        // Operações entre instantâneos do log
+#define PREENCHIMENTO_RECONSTRUCAO 0.85     // Preenchimento das cargas de recuperação e compactação
+#define MINIMO_MARCACOES 1024               // Remoções por marcação antes de conferir a compactação
+#define FRACAO_MARCADAS 4                   // Compactar quando 1/4 das chaves estiverem marcadas
+#define MINIMO_PARALELO 4096                // Nós de um nível por thread na carga paralela
+
+// Compilado como módulo (-DSEM_MAIN, ver conjunto.h), só a interface de
+// conjunto fica: o menu, as medições e as funções que só eles usam ficam de
+// fora (#ifndef SEM_MAIN)
 
 // ===================== ESTRUTURAS DE DADOS =====================
 
-// Estrutura de um nó da Árvore 2-3
+// Agregados dos dados de um conjunto de chaves (sem as marcadas como removidas)
+typedef struct {
+    int contagem;
+    long long soma;
+    int minimo;                 // INT_MAX se não há chaves
+    int maximo;                 // INT_MIN se não há chaves
+} Agregado;
+
+// Estrutura de um nó da Árvore (o nome vem do caso 2-3)
 typedef struct No23 {
-    int chaves[2];          // Pode ter 1 ou 2 chaves
-    int numChaves;          // Quantidade atual de chaves (1 ou 2)
-    struct No23 *filhos[3]; // Pode ter 2 ou 3 filhos
-    struct No23 *pai;       // Ponteiro para o pai
-    bool ehFolha;           // Indica se é folha
+    int chaves[ORDEM];          // Até MAX_CHAVES chaves, +1 posição temporária antes da divisão
+    int numChaves;              // Quantidade atual de chaves
+    bool mortas[ORDEM];         // Chave marcada como removida (remoção preguiçosa)
+    bool ehFolha;               // Indica se é folha
+    struct No23 *filhos[ORDEM + 1]; // Até ORDEM filhos, +1 posição temporária
+    struct No23 *pai;           // Ponteiro para o pai
+#if AGREGADOS
+    int dados[ORDEM];           // Dado associado a cada chave
+    Agregado agregado;          // Agregados da subárvore inteira
+#endif
 } No23;
 
 // Estrutura da Árvore 2-3
 typedef struct {
     No23 *raiz;
+    int marcacoes;              // Remoções por marcação desde a última contagem
+    int limiteMarcacoes;        // Marcações até conferir se vale compactar
+    int compactacoes;           // Compactações feitas
 } Arvore23;
 
+// Contadores de instrumentação de todas as árvores do módulo (contadores.h)
+static Contadores contadores;
+
 // ===================== FUNÇÕES AUXILIARES =====================
 
-// Criar um novo nó
-No23* criarNo(int chave1, int chave2, bool ehFolha, No23 *pai) {
+#if AGREGADOS || !defined(SEM_MAIN)
+// Agregado de um conjunto vazio
+static Agregado agregadoVazio() {
+    Agregado agregado = { 0, 0, INT_MAX, INT_MIN };
+    return agregado;
+}
+
+// Acrescentar um dado ao agregado
+static void somarDado(Agregado *agregado, int dado) {
+    agregado->contagem++;
+    agregado->soma += dado;
+    if (dado < agregado->minimo) agregado->minimo = dado;
+    if (dado > agregado->maximo) agregado->maximo = dado;
+}
+#endif
+
+#if AGREGADOS
+// Juntar ao agregado os de outro conjunto de chaves
+static void juntarAgregados(Agregado *agregado, const Agregado *outro) {
+    agregado->contagem += outro->contagem;
+    agregado->soma += outro->soma;
+    if (outro->minimo < agregado->minimo) agregado->minimo = outro->minimo;
+    if (outro->maximo > agregado->maximo) agregado->maximo = outro->maximo;
+}
+#endif
+
+// Criar um novo nó vazio
+static No23* criarNo(bool ehFolha, No23 *pai) {
     No23 *novoNo = (No23*)malloc(sizeof(No23));
     if (novoNo == NULL) {
         printf("Erro: Falha na alocação de memória!\n");
         return NULL;
     }
+    CONTAR(contadores, alocacoes);
     
-    novoNo->chaves[0] = chave1;
-    novoNo->chaves[1] = chave2;
-    novoNo->numChaves = (chave2 == -1) ? 1 : 2;
+    novoNo->numChaves = 0;
     novoNo->ehFolha = ehFolha;
     novoNo->pai = pai;
     
-    // Inicializar todos os filhos como NULL
-    for (int i = 0; i < 3; i++) {
+    // Inicializar chaves e filhos (encontrarFilho lê todas as posições)
+    for (int i = 0; i < ORDEM; i++) {
+        novoNo->chaves[i] = 0;
+        novoNo->mortas[i] = false;
+    }
+    for (int i = 0; i <= ORDEM; i++) {
         novoNo->filhos[i] = NULL;
     }
+#if AGREGADOS
+    novoNo->agregado = agregadoVazio();
+#endif
     
     return novoNo;
 }
 
 // Inicializar árvore
-void inicializarArvore(Arvore23 *arvore) {
+static void inicializarArvore(Arvore23 *arvore) {
     arvore->raiz = NULL;
+    arvore->marcacoes = 0;
+    arvore->limiteMarcacoes = MINIMO_MARCACOES;
+    arvore->compactacoes = 0;
 }
 
+#ifndef SEM_MAIN
 // Verificar se árvore está vazia
-int arvoreVazia(Arvore23 *arvore) {
+static int arvoreVazia(Arvore23 *arvore) {
     return arvore->raiz == NULL;
 }
+#endif
+
+// Encontrar o filho apropriado para uma chave: quantas chaves do nó são
+// menores ou iguais a ela. O laço tem tamanho fixo e só soma comparações,
+// sem desvios, o que permite ao compilador vetorizá-lo (SIMD) com ORDEM grande.
+// Conta como uma visita ao nó e uma comparação por chave ocupada.
+static int encontrarFilho(No23 *no, int chave) {
+    CONTAR(contadores, nosVisitados);
+    CONTAR_VARIOS(contadores, comparacoes, no->numChaves);
+    int filho = 0;
+    for (int i = 0; i < ORDEM; i++) {
+        filho += (i < no->numChaves) & (no->chaves[i] <= chave);
+    }
+    return filho;
+}
+
+#ifndef SEM_MAIN
+// Dado associado à chave da posição indicada (sem agregados, a própria chave)
+static int dadoDe(No23 *no, int posicao) {
+#if AGREGADOS
+    return no->dados[posicao];
+#else
+    return no->chaves[posicao];
+#endif
+}
+#endif
+
+// Definir o dado associado à chave da posição indicada
+static void definirDado(No23 *no, int posicao, int dado) {
+#if AGREGADOS
+    no->dados[posicao] = dado;
+#else
+    (void)no;
+    (void)posicao;
+    (void)dado;
+#endif
+}
+
+// Copiar a chave (com marcação e dado) da posição j de origem para a posição i de destino
+static void moverChave(No23 *destino, int i, No23 *origem, int j) {
+    destino->chaves[i] = origem->chaves[j];
+    destino->mortas[i] = origem->mortas[j];
+#if AGREGADOS
+    destino->dados[i] = origem->dados[j];
+#endif
+}
+
+// Recalcular o agregado de um nó a partir das suas chaves e dos agregados dos filhos
+static void atualizarAgregado(No23 *no) {
+#if AGREGADOS
+    Agregado agregado = agregadoVazio();
+    for (int i = 0; i < no->numChaves; i++) {
+        if (!no->mortas[i]) somarDado(&agregado, no->dados[i]);
+    }
+    if (!no->ehFolha) {
+        for (int i = 0; i <= no->numChaves; i++) {
+            juntarAgregados(&agregado, &no->filhos[i]->agregado);
+        }
+    }
+    no->agregado = agregado;
+#else
+    (void)no;
+#endif
+}
 
-// Encontrar o filho apropriado para uma chave
-int encontrarFilho(No23 *no, int chave) {
-    if (no->numChaves == 1) {
-        if (chave < no->chaves[0]) return 0;
-        else return 1;
-    } else { // numChaves == 2
-        if (chave < no->chaves[0]) return 0;
-        else if (chave < no->chaves[1]) return 1;
-        else return 2;
+// Recalcular os agregados de um nó até a raiz (caminho afetado por uma operação)
+static void atualizarCaminho(No23 *no) {
+#if AGREGADOS
+    while (no != NULL) {
+        atualizarAgregado(no);
+        no = no->pai;
     }
+#else
+    (void)no;
+#endif
 }
 
-// Ordenar chaves em um nó (mantém sempre ordenado)
-void ordenarChaves(No23 *no) {
-    if (no->numChaves == 2 && no->chaves[0] > no->chaves[1]) {
-        // Troca as chaves
-        int temp = no->chaves[0];
-        no->chaves[0] = no->chaves[1];
-        no->chaves[1] = temp;
+// Acrescentar o dado de uma chave nova (ou desmarcada) aos agregados de um nó
+// e dos seus ancestrais, sem reler os filhos
+static void somarNoCaminho(No23 *no, int dado) {
+#if AGREGADOS
+    while (no != NULL) {
+        somarDado(&no->agregado, dado);
+        no = no->pai;
     }
+#else
+    (void)no;
+    (void)dado;
+#endif
+}
+
+#ifndef SEM_MAIN
+// Retirar o dado de uma chave que acabou de ser marcada dos agregados de um nó
+// e dos seus ancestrais. Só é preciso reler os filhos a partir do nó em que o
+// dado era o mínimo ou o máximo.
+static void retirarDoCaminho(No23 *no, int dado) {
+#if AGREGADOS
+    while (no != NULL) {
+        if (dado == no->agregado.minimo || dado == no->agregado.maximo) {
+            atualizarCaminho(no);
+            return;
+        }
+        no->agregado.contagem--;
+        no->agregado.soma -= dado;
+        no = no->pai;
+    }
+#else
+    (void)no;
+    (void)dado;
+#endif
+}
+#endif
+
+// Índice de um filho dentro do pai
+static int indiceNoPai(No23 *no) {
+    No23 *pai = no->pai;
+    int indice = 0;
+    while (pai->filhos[indice] != no) indice++;
+    return indice;
+}
+
+// Inserir chave (e o filho à sua direita) na posição indicada, deslocando o
+// resto; o dado associado começa igual à chave
+static void inserirNaPosicao(No23 *no, int posicao, int chave, No23 *filhoDireito) {
+    for (int i = no->numChaves; i > posicao; i--) {
+        moverChave(no, i, no, i - 1);
+        no->filhos[i + 1] = no->filhos[i];
+    }
+    no->chaves[posicao] = chave;
+    no->mortas[posicao] = false;
+    definirDado(no, posicao, chave);
+    no->filhos[posicao + 1] = filhoDireito;
+    no->numChaves++;
+}
+
+// Remover a chave da posição indicada e o filho à sua direita
+static void removerDaPosicao(No23 *no, int posicao) {
+    for (int i = posicao; i < no->numChaves - 1; i++) {
+        moverChave(no, i, no, i + 1);
+        no->filhos[i + 1] = no->filhos[i + 2];
+    }
+    no->filhos[no->numChaves] = NULL;
+    no->numChaves--;
 }
 
 // ===================== FUNÇÃO DE BUSCA =====================
 
-// Buscar uma chave na árvore
-No23* buscar(No23 *raiz, int chave, int *posicao) {
-    if (raiz == NULL) return NULL;
-    
-    // Verificar se a chave está neste nó
-    for (int i = 0; i < raiz->numChaves; i++) {
-        if (chave == raiz->chaves[i]) {
-            *posicao = i;
+// Buscar uma chave na árvore (chaves marcadas como removidas não contam)
+static No23* buscar(No23 *raiz, int chave, int *posicao) {
+    while (raiz != NULL) {
+        // A chave, se estiver neste nó, é a última menor ou igual a ela
+        int filho = encontrarFilho(raiz, chave);
+        if (filho > 0 && raiz->chaves[filho - 1] == chave) {
+            if (raiz->mortas[filho - 1]) {
+                return NULL;
+            }
+            *posicao = filho - 1;
             return raiz;
         }
+        
+        // Se é folha e não encontrou, retorna NULL
+        if (raiz->ehFolha) {
+            return NULL;
+        }
+        
+        raiz = raiz->filhos[filho];
     }
-    
-    // Se é folha e não encontrou, retorna NULL
-    if (raiz->ehFolha) {
-        return NULL;
-    }
-    
-    // Encontrar qual filho seguir
-    int filho = encontrarFilho(raiz, chave);
-    return buscar(raiz->filhos[filho], chave, posicao);
+    return NULL;
 }
 
 // ===================== FUNÇÕES DE INSERÇÃO =====================
 
-// Inserir chave em nó folha (ainda não cheio)
-void inserirEmFolha(No23 *folha, int chave) {
-    // Adiciona a nova chave
-    folha->chaves[folha->numChaves] = chave;
-    folha->numChaves++;
+// Dividir um nó com MAX_CHAVES + 1 chaves (split). A chave promovida continua
+// na posição no->numChaves do nó original, com sua marcação e seu dado.
+static No23* dividirNo(No23 *no, int *chavePromovida) {
+    CONTAR(contadores, divisoes);
     
-    // Ordena as chaves
-    ordenarChaves(folha);
-}
-
-// Dividir um nó (split)
-No23* dividirNo(No23 *no, int *chavePromovida) {
     // A chave do meio será promovida
-    *chavePromovida = no->chaves[1];
+    int meio = no->numChaves / 2;
+    *chavePromovida = no->chaves[meio];
     
-    // Criar novo nó direito com a chave maior
-    No23 *novoNo = criarNo(no->chaves[2], -1, no->ehFolha, no->pai);
+    // Criar novo nó direito com as chaves maiores
+    No23 *novoNo = criarNo(no->ehFolha, no->pai);
+    if (novoNo == NULL) {
+        exit(1);
+    }
     
-    // Atualizar o nó original para ter apenas a chave menor
-    no->chaves[1] = -1;
-    no->numChaves = 1;
+    for (int i = meio + 1; i < no->numChaves; i++) {
+        moverChave(novoNo, novoNo->numChaves++, no, i);
+    }
     
     // Se não for folha, redistribuir os filhos
     if (!no->ehFolha) {
-        novoNo->filhos[0] = no->filhos[2];
-        novoNo->filhos[1] = no->filhos[3];
-        no->filhos[2] = NULL;
-        no->filhos[3] = NULL;
-        
-        // Atualizar pais dos filhos movidos
-        if (novoNo->filhos[0] != NULL) novoNo->filhos[0]->pai = novoNo;
-        if (novoNo->filhos[1] != NULL) novoNo->filhos[1]->pai = novoNo;
+        for (int i = meio + 1; i <= no->numChaves; i++) {
+            novoNo->filhos[i - meio - 1] = no->filhos[i];
+            no->filhos[i] = NULL;
+            
+            // Atualizar pais dos filhos movidos
+            novoNo->filhos[i - meio - 1]->pai = novoNo;
+        }
     }
     
+    // Atualizar o nó original para ter apenas as chaves menores
+    no->numChaves = meio;
+    
+    // Os filhos das duas metades já estão com os agregados em dia
+    atualizarAgregado(no);
+    atualizarAgregado(novoNo);
+    
     return novoNo;
 }
 
-// Inserir chave em nó interno
-void inserirEmPai(No23 *pai, int chavePromovida, No23 *novoNo) {
+// Inserir chave promovida no pai do nó dividido (os agregados do pai e de
+// cima são recalculados por quem iniciou a inserção)
+static void inserirEmPai(No23 *no, int chavePromovida, No23 *novoNo) {
+    No23 *pai = no->pai;
+    
     if (pai == NULL) {
         // Criar nova raiz
-        No23 *novaRaiz = criarNo(chavePromovida, -1, false, NULL);
-        novaRaiz->filhos[0] = novoNo->pai; // nó original
+        No23 *novaRaiz = criarNo(false, NULL);
+        if (novaRaiz == NULL) {
+            exit(1);
+        }
+        moverChave(novaRaiz, 0, no, no->numChaves);
+        novaRaiz->numChaves = 1;
+        novaRaiz->filhos[0] = no;
         novaRaiz->filhos[1] = novoNo;
         
         // Atualizar pais
-        novoNo->pai->pai = novaRaiz;
+        no->pai = novaRaiz;
         novoNo->pai = novaRaiz;
-        
-        // Atualizar raiz da árvore
-        novoNo->pai->pai = novaRaiz; // nó original
         return;
     }
     
-    // Inserir chave promovida no pai
-    if (pai->numChaves == 1) {
-        // Pai tem espaço
-        pai->chaves[1] = chavePromovida;
-        pai->numChaves = 2;
-        ordenarChaves(pai);
-        
-        // Inserir novo filho na posição correta
-        if (novoNo->chaves[0] > pai->chaves[0]) {
-            pai->filhos[2] = novoNo;
-        } else {
-            pai->filhos[2] = pai->filhos[1];
-            pai->filhos[1] = novoNo;
-        }
-    } else {
-        // Pai também está cheio, precisa dividir
-        // Temporariamente adiciona a terceira chave
-        pai->chaves[2] = chavePromovida;
-        pai->numChaves = 3;
-        
-        // Ordenar as 3 chaves
-        if (pai->chaves[0] > pai->chaves[1]) {
-            int temp = pai->chaves[0];
-            pai->chaves[0] = pai->chaves[1];
-            pai->chaves[1] = temp;
-        }
-        if (pai->chaves[1] > pai->chaves[2]) {
-            int temp = pai->chaves[1];
-            pai->chaves[1] = pai->chaves[2];
-            pai->chaves[2] = temp;
-        }
-        if (pai->chaves[0] > pai->chaves[1]) {
-            int temp = pai->chaves[0];
-            pai->chaves[0] = pai->chaves[1];
-            pai->chaves[1] = temp;
-        }
-        
-        // Dividir o pai
+    // Inserir chave promovida e novo filho logo à direita do nó original
+    int indice = indiceNoPai(no);
+    inserirNaPosicao(pai, indice, chavePromovida, novoNo);
+    moverChave(pai, indice, no, no->numChaves);
+    
+    // Pai também está cheio, precisa dividir
+    if (pai->numChaves > MAX_CHAVES) {
         int novaChavePromovida;
         No23 *novoPai = dividirNo(pai, &novaChavePromovida);
         
-        // Configurar filhos do novo pai
-        if (chavePromovida < novaChavePromovida) {
-            novoPai->filhos[0] = pai->filhos[2];
-            novoPai->filhos[1] = pai->filhos[3];
-        } else {
-            novoPai->filhos[0] = pai->filhos[3];
-            novoPai->filhos[1] = novoNo;
-        }
-        
-        // Atualizar pais
-        if (novoPai->filhos[0] != NULL) novoPai->filhos[0]->pai = novoPai;
-        if (novoPai->filhos[1] != NULL) novoPai->filhos[1]->pai = novoPai;
-        
         // Chamar recursivamente para o avô
-        inserirEmPai(pai->pai, novaChavePromovida, novoPai);
+        inserirEmPai(pai, novaChavePromovida, novoPai);
     }
 }
 
-// Função principal de inserção
-No23* inserir(No23 *raiz, int chave) {
+// Inserir uma chave com seu dado associado, sem mensagens; *jaExiste indica
+// se a chave já estava na árvore (nesse caso o dado não muda)
+static No23* inserirComDado(No23 *raiz, int chave, int dado, bool *jaExiste) {
+    *jaExiste = false;
+    
     // Caso especial: árvore vazia
     if (raiz == NULL) {
-        return criarNo(chave, -1, true, NULL);
+        No23 *novaRaiz = criarNo(true, NULL);
+        if (novaRaiz != NULL) {
+            novaRaiz->chaves[0] = chave;
+            definirDado(novaRaiz, 0, dado);
+            novaRaiz->numChaves = 1;
+            atualizarAgregado(novaRaiz);
+        }
+        return novaRaiz;
     }
     
     // Encontrar a folha correta para inserção
     No23 *atual = raiz;
-    while (!atual->ehFolha) {
-        int filho = encontrarFilho(atual, chave);
-        atual = atual->filhos[filho];
-    }
-    
-    // Verificar se a chave já existe
-    for (int i = 0; i < atual->numChaves; i++) {
-        if (atual->chaves[i] == chave) {
-            printf("Chave %d já existe na árvore.\n", chave);
+    int filho;
+    while (true) {
+        filho = encontrarFilho(atual, chave);
+        
+        // Verificar se a chave já existe (em qualquer nível); se estava
+        // marcada como removida, basta desmarcá-la
+        if (filho > 0 && atual->chaves[filho - 1] == chave) {
+            if (atual->mortas[filho - 1]) {
+                atual->mortas[filho - 1] = false;
+                definirDado(atual, filho - 1, dado);
+                somarNoCaminho(atual, dado);
+            } else {
+                *jaExiste = true;
+            }
             return raiz;
         }
+        
+        if (atual->ehFolha) break;
+        atual = atual->filhos[filho];
     }
     
     // Inserir na folha
-    if (atual->numChaves == 1) {
-        // Folha tem espaço
-        inserirEmFolha(atual, chave);
-        return raiz;
-    } else {
-        // Folha está cheia (tem 2 chaves)
-        // Adicionar temporariamente a terceira chave
-        atual->chaves[2] = chave;
-        atual->numChaves = 3;
-        
-        // Ordenar as 3 chaves
-        if (atual->chaves[0] > atual->chaves[1]) {
-            int temp = atual->chaves[0];
-            atual->chaves[0] = atual->chaves[1];
-            atual->chaves[1] = temp;
-        }
-        if (atual->chaves[1] > atual->chaves[2]) {
-            int temp = atual->chaves[1];
-            atual->chaves[1] = atual->chaves[2];
-            atual->chaves[2] = temp;
-        }
-        if (atual->chaves[0] > atual->chaves[1]) {
-            int temp = atual->chaves[0];
-            atual->chaves[0] = atual->chaves[1];
-            atual->chaves[1] = temp;
-        }
-        
-        // Dividir a folha
+    inserirNaPosicao(atual, filho, chave, NULL);
+    definirDado(atual, filho, dado);
+    
+    // Folha estourou: dividir e subir a chave do meio
+    if (atual->numChaves > MAX_CHAVES) {
         int chavePromovida;
         No23 *novaFolha = dividirNo(atual, &chavePromovida);
-        
-        // Inserir no pai
-        inserirEmPai(atual->pai, chavePromovida, novaFolha);
+        inserirEmPai(atual, chavePromovida, novaFolha);
         
         // Retornar a raiz (pode ter mudado)
         while (raiz->pai != NULL) {
             raiz = raiz->pai;
         }
-        return raiz;
+        
+        // Os nós criados nas divisões já estão em dia; falta o caminho da folha
+        atualizarCaminho(atual);
+    } else {
+        somarNoCaminho(atual, dado);
     }
+    return raiz;
 }
 
-// ===================== FUNÇÕES DE REMOÇÃO =====================
+// Inserir sem mensagens; *jaExiste indica se a chave já estava na árvore.
+// O dado associado é a própria chave.
+static No23* inserirChave(No23 *raiz, int chave, bool *jaExiste) {
+    return inserirComDado(raiz, chave, chave, jaExiste);
+}
 
-// Encontrar predecessor (maior chave na subárvore esquerda)
-int encontrarPredecessor(No23 *no) {
-    while (!no->ehFolha) {
-        no = no->filhos[no->numChaves]; // Último filho
+#ifndef SEM_MAIN
+// Função principal de inserção; *inserida indica se a chave era nova
+static No23* inserir(No23 *raiz, int chave, bool *inserida) {
+    bool jaExiste;
+    raiz = inserirChave(raiz, chave, &jaExiste);
+    if (jaExiste) {
+        printf("Chave %d já existe na árvore.\n", chave);
     }
-    return no->chaves[no->numChaves - 1];
+    *inserida = !jaExiste;
+    return raiz;
 }
+#endif
+
+// ===================== FUNÇÕES DE REMOÇÃO =====================
 
-// Encontrar sucessor (menor chave na subárvore direita)
-int encontrarSucessor(No23 *no) {
+// Encontrar a folha com o predecessor (maior chave na subárvore esquerda)
+static No23* encontrarPredecessor(No23 *no) {
     while (!no->ehFolha) {
-        no = no->filhos[0]; // Primeiro filho
+        no = no->filhos[no->numChaves]; // Último filho
     }
-    return no->chaves[0];
+    return no;
 }
 
-// Redistribuir chaves com irmão à esquerda
-void redistribuirEsquerda(No23 *no, No23 *irmao, No23 *pai, int indiceNo) {
+// Redistribuir chaves com irmão à esquerda (o irmão cede sua maior chave)
+static void redistribuirEsquerda(No23 *no, No23 *irmao, No23 *pai, int indiceNo) {
+    CONTAR(contadores, redistribuicoes);
+    
+    // Abrir espaço no início do nó
+    for (int i = no->numChaves; i > 0; i--) {
+        moverChave(no, i, no, i - 1);
+    }
+    if (!no->ehFolha) {
+        for (int i = no->numChaves + 1; i > 0; i--) {
+            no->filhos[i] = no->filhos[i - 1];
+        }
+    }
+    
     // Mover chave do pai para o nó
-    no->chaves[1] = no->chaves[0];
-    no->chaves[0] = pai->chaves[indiceNo - 1];
-    no->numChaves = 2;
+    moverChave(no, 0, pai, indiceNo - 1);
+    no->numChaves++;
     
     // Mover chave do irmão para o pai
-    pai->chaves[indiceNo - 1] = irmao->chaves[irmao->numChaves - 1];
-    irmao->numChaves--;
+    moverChave(pai, indiceNo - 1, irmao, irmao->numChaves - 1);
     
     // Se não for folha, mover filho também
     if (!no->ehFolha) {
-        no->filhos[2] = no->filhos[1];
-        no->filhos[1] = no->filhos[0];
-        no->filhos[0] = irmao->filhos[irmao->numChaves + 1];
-        if (no->filhos[0] != NULL) no->filhos[0]->pai = no;
+        no->filhos[0] = irmao->filhos[irmao->numChaves];
+        irmao->filhos[irmao->numChaves] = NULL;
+        no->filhos[0]->pai = no;
     }
+    irmao->numChaves--;
+    
+    // O pai é recalculado no caminho até a raiz
+    atualizarAgregado(no);
+    atualizarAgregado(irmao);
 }
 
-// Redistribuir chaves com irmão à direita
-void redistribuirDireita(No23 *no, No23 *irmao, No23 *pai, int indiceNo) {
+// Redistribuir chaves com irmão à direita (o irmão cede sua menor chave)
+static void redistribuirDireita(No23 *no, No23 *irmao, No23 *pai, int indiceNo) {
+    CONTAR(contadores, redistribuicoes);
+    
     // Mover chave do pai para o nó
-    no->chaves[1] = pai->chaves[indiceNo];
-    no->numChaves = 2;
+    moverChave(no, no->numChaves, pai, indiceNo);
+    no->numChaves++;
     
     // Mover chave do irmão para o pai
-    pai->chaves[indiceNo] = irmao->chaves[0];
-    
-    // Rearranjar chaves do irmão
-    irmao->chaves[0] = irmao->chaves[1];
-    irmao->numChaves--;
+    moverChave(pai, indiceNo, irmao, 0);
     
     // Se não for folha, mover filho também
     if (!no->ehFolha) {
-        no->filhos[2] = irmao->filhos[0];
-        if (no->filhos[2] != NULL) no->filhos[2]->pai = no;
+        no->filhos[no->numChaves] = irmao->filhos[0];
+        no->filhos[no->numChaves]->pai = no;
         
         // Deslocar filhos do irmão
-        irmao->filhos[0] = irmao->filhos[1];
-        irmao->filhos[1] = irmao->filhos[2];
-        irmao->filhos[2] = NULL;
+        for (int i = 0; i < irmao->numChaves; i++) {
+            irmao->filhos[i] = irmao->filhos[i + 1];
+        }
+        irmao->filhos[irmao->numChaves] = NULL;
+    }
+    
+    // Rearranjar chaves do irmão
+    for (int i = 0; i < irmao->numChaves - 1; i++) {
+        moverChave(irmao, i, irmao, i + 1);
     }
+    irmao->numChaves--;
+    
+    // O pai é recalculado no caminho até a raiz
+    atualizarAgregado(no);
+    atualizarAgregado(irmao);
 }
 
-// Fundir nó com irmão à esquerda
-void fundirEsquerda(No23 *no, No23 *irmao, No23 *pai, int indiceNo) {
-    // Mover chave do pai para o irmão
-    irmao->chaves[1] = pai->chaves[indiceNo - 1];
-    irmao->numChaves = 2;
+// Fundir nó com irmão à esquerda (o nó é liberado)
+static void fundirEsquerda(No23 *no, No23 *irmao, No23 *pai, int indiceNo) {
+    CONTAR(contadores, fusoes);
     
-    // Mover chave do nó para o irmão
-    irmao->chaves[2] = no->chaves[0];
+    // Mover chave do pai para o irmão
+    moverChave(irmao, irmao->numChaves, pai, indiceNo - 1);
+    irmao->numChaves++;
     
-    // Ordenar chaves no irmão
-    if (irmao->chaves[1] > irmao->chaves[2]) {
-        int temp = irmao->chaves[1];
-        irmao->chaves[1] = irmao->chaves[2];
-        irmao->chaves[2] = temp;
+    // Se não for folha, mover filhos
+    if (!no->ehFolha) {
+        for (int i = 0; i <= no->numChaves; i++) {
+            irmao->filhos[irmao->numChaves + i] = no->filhos[i];
+            irmao->filhos[irmao->numChaves + i]->pai = irmao;
+        }
     }
     
-    // Remover chave do pai
-    for (int i = indiceNo - 1; i < pai->numChaves - 1; i++) {
-        pai->chaves[i] = pai->chaves[i + 1];
-        pai->filhos[i + 1] = pai->filhos[i + 2];
+    // Mover chaves do nó para o irmão
+    for (int i = 0; i < no->numChaves; i++) {
+        moverChave(irmao, irmao->numChaves++, no, i);
     }
-    pai->numChaves--;
+    atualizarAgregado(irmao);
     
-    // Se não for folha, mover filhos
-    if (!no->ehFolha) {
-        irmao->filhos[2] = no->filhos[0];
-        irmao->filhos[3] = no->filhos[1];
-        if (irmao->filhos[2] != NULL) irmao->filhos[2]->pai = irmao;
-        if (irmao->filhos[3] != NULL) irmao->filhos[3]->pai = irmao;
-    }
+    // Remover chave do pai
+    removerDaPosicao(pai, indiceNo - 1);
     
     // Liberar memória do nó
     free(no);
+    CONTAR(contadores, liberacoes);
 }
 
-// Ajustar árvore após remoção
-void ajustarAposRemocao(No23 *no) {
-    if (no == NULL || no->numChaves >= 1) return;
-    
-    // Se é a raiz e está vazia
-    if (no->pai == NULL) {
-        if (no->numChaves == 0) {
-            if (no->filhos[0] != NULL) {
-                no->filhos[0]->pai = NULL;
-                // A raiz atual vira o filho
-                No23 *temp = no;
-                no = no->filhos[0];
-                free(temp);
-            }
+// Ajustar árvore após remoção e recalcular os agregados do caminho; retorna a
+// raiz (pode ter mudado)
+static No23* ajustarAposRemocao(No23 *raiz, No23 *no) {
+    while (no->numChaves < MIN_CHAVES || no->numChaves == 0) {
+        // Se é a raiz e está vazia
+        if (no->pai == NULL) {
+            if (no->numChaves > 0) break;
+            
+            // A raiz atual vira o filho (ou a árvore fica vazia)
+            // (o filho acabou de ser fundido e já está em dia)
+            raiz = no->ehFolha ? NULL : no->filhos[0];
+            if (raiz != NULL) raiz->pai = NULL;
+            free(no);
+            CONTAR(contadores, liberacoes);
+            return raiz;
         }
-        return;
-    }
-    
-    // Encontrar índice deste nó no pai
-    No23 *pai = no->pai;
-    int indiceNo = 0;
-    while (pai->filhos[indiceNo] != no) indiceNo++;
-    
-    // Tentar redistribuição com irmão esquerdo
-    if (indiceNo > 0 && pai->filhos[indiceNo - 1]->numChaves > 1) {
-        redistribuirEsquerda(no, pai->filhos[indiceNo - 1], pai, indiceNo);
-        return;
+        
+        // Encontrar índice deste nó no pai
+        No23 *pai = no->pai;
+        int indiceNo = indiceNoPai(no);
+        
+        // Tentar redistribuição com irmão esquerdo
+        if (indiceNo > 0 && pai->filhos[indiceNo - 1]->numChaves > MIN_CHAVES) {
+            redistribuirEsquerda(no, pai->filhos[indiceNo - 1], pai, indiceNo);
+            break;
+        }
+        
+        // Tentar redistribuição com irmão direito
+        if (indiceNo < pai->numChaves && pai->filhos[indiceNo + 1]->numChaves > MIN_CHAVES) {
+            redistribuirDireita(no, pai->filhos[indiceNo + 1], pai, indiceNo);
+            break;
+        }
+        
+        // Se não pode redistribuir, fundir
+        if (indiceNo > 0) {
+            // Fundir com irmão esquerdo
+            fundirEsquerda(no, pai->filhos[indiceNo - 1], pai, indiceNo);
+        } else {
+            // Fundir irmão direito neste nó
+            fundirEsquerda(pai->filhos[1], no, pai, 1);
+        }
+        
+        // Ajustar o pai
+        no = pai;
     }
     
-    // Tentar redistribuição com irmão direito
-    if (indiceNo < pai->numChaves && pai->filhos[indiceNo + 1]->numChaves > 1) {
-        redistribuirDireita(no, pai->filhos[indiceNo + 1], pai, indiceNo);
-        return;
+    // Abaixo de no tudo já foi recalculado nas redistribuições e fusões
+    atualizarCaminho(no);
+    return raiz;
+}
+
+// Remover a chave da posição indicada de um nó (já encontrado pela busca)
+static No23* removerDoNo(No23 *raiz, No23 *no, int posicao) {
+    // Nó interno: trocar pela chave predecessora, que está numa folha
+    if (!no->ehFolha) {
+        No23 *folha = encontrarPredecessor(no->filhos[posicao]);
+        moverChave(no, posicao, folha, folha->numChaves - 1);
+        no = folha;
+        posicao = folha->numChaves - 1;
     }
     
-    // Se não pode redistribuir, fundir
-    if (indiceNo > 0) {
-        // Fundir com irmão esquerdo
-        fundirEsquerda(no, pai->filhos[indiceNo - 1], pai, indiceNo);
-    } else {
-        // Fundir com irmão direito
-        fundirEsquerda(pai->filhos[indiceNo + 1], no, pai, indiceNo + 1);
-    }
+    // Remover a chave da folha
+    removerDaPosicao(no, posicao);
     
-    // Ajustar recursivamente o pai
-    ajustarAposRemocao(pai);
+    // Ajustar se necessário
+    return ajustarAposRemocao(raiz, no);
 }
 
-// Função principal de remoção
-No23* removerChave(No23 *raiz, int chave) {
+#ifndef SEM_MAIN
+// Função principal de remoção; *removida indica se a chave estava na árvore
+static No23* removerChave(No23 *raiz, int chave, bool *removida) {
+    *removida = false;
     if (raiz == NULL) {
         printf("Árvore vazia!\n");
         return NULL;
@@ -440,165 +676,1491 @@ No23* removerChave(No23 *raiz, int chave) {
         return raiz;
     }
     
-    // CASO 1: Nó é folha
-    if (no->ehFolha) {
-        // Remover a chave
-        for (int i = posicao; i < no->numChaves - 1; i++) {
-            no->chaves[i] = no->chaves[i + 1];
+    *removida = true;
+    return removerDoNo(raiz, no, posicao);
+}
+#endif
+
+#ifndef SEM_MAIN
+
+// ===================== CARGA EM LOTE =====================
+
+// Divisão de um nível de n chaves em nós (ver montarNivel)
+typedef struct {
+    int quantidade;     // Nós do nível
+    int base;           // Chaves por nó (os resto primeiros têm uma a mais)
+    int resto;
+} DivisaoNivel;
+
+static DivisaoNivel dividirNivel(int n, int porNo) {
+    DivisaoNivel divisao;
+    
+    // Quantos nós: o necessário para porNo chaves cada, sem deixar nenhum
+    // com menos de MIN_CHAVES (cada nó usa suas chaves + 1 que sobe)
+    int quantidade = (n + porNo + 1) / (porNo + 1);
+    int maximo = (n + 1) / (MIN_CHAVES + 1);
+    if (quantidade > maximo) quantidade = maximo;
+    if (quantidade < 1) quantidade = 1;
+    
+    // Distribuir as chaves restantes o mais igualmente possível
+    divisao.quantidade = quantidade;
+    divisao.base = (n - (quantidade - 1)) / quantidade;
+    divisao.resto = (n - (quantidade - 1)) % quantidade;
+    return divisao;
+}
+
+// Montar os nós [primeiro, ultimo) de um nível. O nó j usa as chaves (e, nos
+// níveis internos, os nós de baixo em filhos) a partir da posição
+// j * (base + 1) + min(j, resto); ele vai para nos[j] e a chave seguinte, que
+// o separa do próximo, sobe para acima[j] (com o dado em dadosAcima[j]).
+// Sem o vetor dados, o dado de cada chave é ela mesma. As saídas podem ser os
+// próprios vetores de entrada: a escrita fica sempre atrás da leitura.
+static void montarNos(const int *chaves, const int *dados, No23 *const *filhos, DivisaoNivel divisao,
+                      int primeiro, int ultimo, int *acima, int *dadosAcima, No23 **nos, bool ehFolha) {
+    int leitura = primeiro * (divisao.base + 1) + (primeiro < divisao.resto ? primeiro : divisao.resto);
+    
+    for (int j = primeiro; j < ultimo; j++) {
+        int filho = leitura;     // Primeiro nó do nível de baixo
+        No23 *no = criarNo(ehFolha, NULL);
+        if (no == NULL) {
+            exit(1);
         }
-        no->numChaves--;
         
-        // Ajustar se necessário
-        if (no->numChaves < 1) {
-            ajustarAposRemocao(no);
-        }
-    } 
-    // CASO 2: Nó interno
-    else {
-        // Encontrar predecessor ou sucessor
-        int chaveSubstituta;
-        if (no->filhos[posicao]->numChaves >= 1) {
-            // Usar predecessor
-            chaveSubstituta = encontrarPredecessor(no->filhos[posicao]);
-        } else {
-            // Usar sucessor
-            chaveSubstituta = encontrarSucessor(no->filhos[posicao + 1]);
+        no->numChaves = divisao.base + (j < divisao.resto ? 1 : 0);
+        for (int i = 0; i < no->numChaves; i++) {
+            definirDado(no, i, dados != NULL ? dados[leitura] : chaves[leitura]);
+            no->chaves[i] = chaves[leitura++];
         }
         
-        // Substituir chave
-        no->chaves[posicao] = chaveSubstituta;
+        if (!ehFolha) {
+            for (int i = 0; i <= no->numChaves; i++) {
+                no->filhos[i] = filhos[filho++];
+                no->filhos[i]->pai = no;
+            }
+        }
+        atualizarAgregado(no);
+        nos[j] = no;
         
-        // Remover a chave substituta recursivamente
-        if (no->filhos[posicao]->numChaves >= 1) {
-            raiz = removerChave(raiz, chaveSubstituta);
-        } else {
-            raiz = removerChave(raiz, chaveSubstituta);
+        // A chave seguinte separa este nó do próximo e sobe
+        if (j < divisao.quantidade - 1) {
+            if (dados != NULL) dadosAcima[j] = dados[leitura];
+            acima[j] = chaves[leitura++];
         }
     }
-    
-    // Encontrar nova raiz se necessário
-    while (raiz->pai != NULL) {
-        raiz = raiz->pai;
-    }
-    
-    return raiz;
 }
 
-// ===================== FUNÇÕES DE EXIBIÇÃO =====================
+// Montar um nível da árvore a partir de n chaves ordenadas e, nos níveis
+// internos, dos n + 1 nós do nível de baixo (em nos). Cada nó recebe cerca de
+// porNo chaves e a chave entre dois nós vizinhos sobe para o nível de cima.
+// As chaves que sobem (com seus dados, se houver o vetor dados) e os nós
+// montados são escritos no começo dos próprios vetores, sempre atrás da
+// posição de leitura. Retorna o número de nós.
+static int montarNivel(int *chaves, int *dados, int n, No23 **nos, int porNo, bool ehFolha) {
+    DivisaoNivel divisao = dividirNivel(n, porNo);
+    montarNos(chaves, dados, ehFolha ? NULL : nos, divisao, 0, divisao.quantidade, chaves, dados, nos, ehFolha);
+    return divisao.quantidade;
+}
 
-// Percorrer em ordem (crescente)
-void emOrdem(No23 *no) {
-    if (no == NULL) return;
+// Chaves por nó numa carga com a taxa de preenchimento dada, limitadas entre
+// o mínimo e o máximo de um nó
+static int chavesPorNo(double preenchimento) {
+    int porNo = (int)(preenchimento * MAX_CHAVES + 0.5);
+    if (porNo < MIN_CHAVES) porNo = MIN_CHAVES;
+    if (porNo < 1) porNo = 1;
+    if (porNo > MAX_CHAVES) porNo = MAX_CHAVES;
+    return porNo;
+}
+
+// Construir uma árvore a partir de n valores em ordem crescente, de baixo para
+// cima, em O(n). A taxa de preenchimento (0 a 1) define quanto de cada nó é
+// ocupado; abaixo de 1 sobra espaço para inserções futuras sem divisões.
+// dadosValores traz o dado associado a cada valor (NULL: o próprio valor).
+static No23* carregarComDados(const int *valores, const int *dadosValores, int n, double preenchimento) {
+    if (n <= 0) return NULL;
     
-    if (no->ehFolha) {
-        if (no->numChaves == 1) {
-            printf("%d ", no->chaves[0]);
-        } else {
-            printf("%d %d ", no->chaves[0], no->chaves[1]);
-        }
-    } else {
-        if (no->numChaves == 1) {
-            emOrdem(no->filhos[0]);
-            printf("%d ", no->chaves[0]);
-            emOrdem(no->filhos[1]);
-        } else {
-            emOrdem(no->filhos[0]);
-            printf("%d ", no->chaves[0]);
-            emOrdem(no->filhos[1]);
-            printf("%d ", no->chaves[1]);
-            emOrdem(no->filhos[2]);
+    for (int i = 1; i < n; i++) {
+        if (valores[i] <= valores[i - 1]) {
+            printf("Erro: os valores devem estar em ordem crescente e sem repetição!\n");
+            return NULL;
         }
     }
+    
+    int porNo = chavesPorNo(preenchimento);
+    
+    // Sem agregados os dados não são guardados e não precisam ser copiados
+    bool comDados = AGREGADOS && dadosValores != NULL;
+    int *chaves = (int*)malloc(sizeof(int) * n);
+    int *dados = comDados ? (int*)malloc(sizeof(int) * n) : NULL;
+    No23 **nos = (No23**)malloc(sizeof(No23*) * ((n + 1) / 2 + 1));
+    if (chaves == NULL || nos == NULL || (comDados && dados == NULL)) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(chaves);
+        free(dados);
+        free(nos);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) {
+        chaves[i] = valores[i];
+        if (comDados) dados[i] = dadosValores[i];
+    }
+    
+    // Folhas primeiro; depois cada nível interno sobre o anterior, até a raiz
+    int numNos = montarNivel(chaves, dados, n, nos, porNo, true);
+    while (numNos > 1) {
+        numNos = montarNivel(chaves, dados, numNos - 1, nos, porNo, false);
+    }
+    
+    No23 *raiz = nos[0];
+    free(chaves);
+    free(dados);
+    free(nos);
+    return raiz;
 }
 
-// Encontrar altura da árvore
-int altura(No23 *no) {
-    if (no == NULL) return 0;
-    if (no->ehFolha) return 1;
-    return 1 + altura(no->filhos[0]);
+// Carga em lote em que o dado associado a cada chave é ela mesma
+static No23* carregarEmLote(const int *valores, int n, double preenchimento) {
+    return carregarComDados(valores, NULL, n, preenchimento);
 }
 
-// Imprimir por nível (BFS)
-void imprimirPorNivel(No23 *raiz) {
-    if (raiz == NULL) return;
-    
-    int h = altura(raiz);
+// Uma faixa de nós de um nível da carga paralela (executável em outra thread)
+typedef struct {
+    const int *chaves;
+    No23 *const *filhos;
+    DivisaoNivel divisao;
+    int primeiro;
+    int ultimo;
+    int *acima;
+    No23 **nos;
+    bool ehFolha;
+} TarefaNivel;
+
+// Ponto de entrada das threads criadas pela carga paralela
+static void* executarTarefaNivel(void *argumento) {
+    TarefaNivel *tarefa = (TarefaNivel*)argumento;
+    montarNos(tarefa->chaves, NULL, tarefa->filhos, tarefa->divisao, tarefa->primeiro, tarefa->ultimo,
+              tarefa->acima, NULL, tarefa->nos, tarefa->ehFolha);
+    return NULL;
+}
+
+// Montar um nível dividindo os nós em faixas contíguas, uma por thread (os
+// níveis pequenos, perto da raiz, ficam numa thread só)
+static void montarNivelParalelo(const int *chaves, No23 *const *filhos, DivisaoNivel divisao,
+                                int *acima, No23 **nos, bool ehFolha, int threads) {
+    int usar = divisao.quantidade / MINIMO_PARALELO + 1;
+    if (usar > threads) usar = threads;
+    if (usar > ORDENACAO_MAX_THREADS) usar = ORDENACAO_MAX_THREADS;
     
-    // Array para simular fila
-    No23 **fila = (No23**)malloc(sizeof(No23*) * 1000);
-    int frente = 0, tras = 0;
+    pthread_t ids[ORDENACAO_MAX_THREADS];
+    TarefaNivel tarefas[ORDENACAO_MAX_THREADS];
+    bool criada[ORDENACAO_MAX_THREADS];
+    for (int t = 0; t < usar; t++) {
+        TarefaNivel tarefa = { chaves, filhos, divisao,
+                               (int)((long long)divisao.quantidade * t / usar),
+                               (int)((long long)divisao.quantidade * (t + 1) / usar),
+                               acima, nos, ehFolha };
+        tarefas[t] = tarefa;
+        criada[t] = t < usar - 1 && pthread_create(&ids[t], NULL, executarTarefaNivel, &tarefas[t]) == 0;
+    }
+    // A última faixa (e as que não ganharam thread) é montada aqui
+    for (int t = 0; t < usar; t++) {
+        if (!criada[t]) executarTarefaNivel(&tarefas[t]);
+    }
+    for (int t = 0; t < usar - 1; t++) {
+        if (criada[t]) pthread_join(ids[t], NULL);
+    }
+}
+
+// Carga em lote de n chaves fora de ordem e com repetidos, com threads
+// threads: ordenação paralela (ordenacao.h) e depois cada nível, de baixo para
+// cima, com os nós divididos entre as threads. Cada faixa de folhas é uma
+// subárvore disjunta; os níveis de cima as juntam. O dado de cada chave é ela
+// mesma. O vetor fica ordenado e sem repetidos no começo e *distintos recebe
+// a quantidade de chaves. Retorna a raiz (NULL se vazia ou faltar memória).
+static No23* carregarEmParalelo(int *chaves, int n, double preenchimento, int threads, int *distintos) {
+    *distintos = ordenarSemRepetidos(chaves, n, threads);
+    if (*distintos <= 0) return NULL;
     
-    fila[tras++] = raiz;
+    // Dois vetores de chaves e dois de nós, alternados entre os níveis: o
+    // nível de baixo é lido de um e o de cima escrito no outro
+    int m = *distintos;
+    int porNo = chavesPorNo(preenchimento);
+    int *acima[2];
+    No23 **nos[2];
+    for (int i = 0; i < 2; i++) {
+        acima[i] = (int*)malloc(sizeof(int) * ((m + 1) / 2 + 1));
+        nos[i] = (No23**)malloc(sizeof(No23*) * ((m + 1) / 2 + 1));
+    }
+    if (acima[0] == NULL || acima[1] == NULL || nos[0] == NULL || nos[1] == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        for (int i = 0; i < 2; i++) {
+            free(acima[i]);
+            free(nos[i]);
+        }
+        return NULL;
+    }
     
-    while (frente < tras) {
-        int tamanhoNivel = tras - frente;
+    // Folhas primeiro; depois cada nível interno sobre o anterior, até a raiz
+    const int *entrada = chaves;
+    No23 **filhos = NULL;
+    int numChaves = m, saida = 0;
+    bool ehFolha = true;
+    while (true) {
+        DivisaoNivel divisao = dividirNivel(numChaves, porNo);
+        montarNivelParalelo(entrada, filhos, divisao, acima[saida], nos[saida], ehFolha, threads);
+        if (divisao.quantidade == 1) break;
         
-        for (int i = 0; i < tamanhoNivel; i++) {
-            No23 *atual = fila[frente++];
-            
-            // Imprimir nó
-            printf("[");
-            for (int j = 0; j < atual->numChaves; j++) {
-                printf("%d", atual->chaves[j]);
-                if (j < atual->numChaves - 1) printf(", ");
-            }
-            printf("] ");
-            
-            // Adicionar filhos à fila
-            if (!atual->ehFolha) {
-                for (int j = 0; j <= atual->numChaves; j++) {
-                    if (atual->filhos[j] != NULL) {
-                        fila[tras++] = atual->filhos[j];
-                    }
-                }
-            }
-        }
-        printf("\n");
+        entrada = acima[saida];
+        filhos = nos[saida];
+        numChaves = divisao.quantidade - 1;
+        ehFolha = false;
+        saida = 1 - saida;
     }
     
-    free(fila);
+    No23 *raiz = nos[saida][0];
+    for (int i = 0; i < 2; i++) {
+        free(acima[i]);
+        free(nos[i]);
+    }
+    return raiz;
 }
 
-// ===================== FUNÇÕES DE MENU E MAIN =====================
-
-// Liberar memória da árvore
-void liberarArvore(No23 *no) {
-    if (no == NULL) return;
+// Contar os nós da árvore
+static int contarNos(No23 *no) {
+    if (no == NULL) return 0;
     
+    int total = 1;
     if (!no->ehFolha) {
         for (int i = 0; i <= no->numChaves; i++) {
-            liberarArvore(no->filhos[i]);
+            total += contarNos(no->filhos[i]);
         }
     }
-    
-    free(no);
+    return total;
 }
 
-// Exibir menu principal
-void exibirMenuPrincipal() {
-    printf("\n=== ÁRVORE 2-3 ===\n");
-    printf("1 - Inserir valor\n");
-    printf("2 - Buscar valor\n");
-    printf("3 - Remover valor\n");
-    printf("4 - Percorrer árvore\n");
-    printf("0 - Sair\n");
-    printf("Escolha uma opção: ");
-}
+#endif
 
-// Exibir submenu de percursos
-void exibirSubmenuPercursos() {
-    printf("\n--- TIPOS DE PERCURSO ---\n");
-    printf("1 - Em ordem (crescente)\n");
-    printf("2 - Por nível (estrutura)\n");
+// ===================== FUNÇÕES DE EXIBIÇÃO =====================
+
+#ifndef SEM_MAIN
+// Percorrer em ordem (crescente)
+static void emOrdem(No23 *no) {
+    if (no == NULL) return;
+    
+    for (int i = 0; i < no->numChaves; i++) {
+        if (!no->ehFolha) emOrdem(no->filhos[i]);
+        if (!no->mortas[i]) printf("%d ", no->chaves[i]);
+    }
+    if (!no->ehFolha) emOrdem(no->filhos[no->numChaves]);
+}
+#endif
+
+// Encontrar altura da árvore
+static int altura(No23 *no) {
+    if (no == NULL) return 0;
+    if (no->ehFolha) return 1;
+    return 1 + altura(no->filhos[0]);
+}
+
+#ifndef SEM_MAIN
+// Saída com buffer próprio: o texto é montado em memória e gravado em blocos,
+// sem uma chamada a printf por chave
+#define TAMANHO_SAIDA 65536
+
+typedef struct {
+    FILE *arquivo;
+    char buffer[TAMANHO_SAIDA];
+    size_t usado;
+    bool erro;                  // Alguma gravação falhou
+} Saida;
+
+// Formatos de exportação por nível
+typedef enum { EXPORTAR_TEXTO, EXPORTAR_DOT, EXPORTAR_BINARIO } FormatoExportacao;
+
+#define MAGIA_EXPORTACAO 0x4E333241u  // "A23N"
+
+// Gravar o que está no buffer
+static void descarregarSaida(Saida *saida) {
+    if (saida->usado > 0 && fwrite(saida->buffer, 1, saida->usado, saida->arquivo) != saida->usado) {
+        saida->erro = true;
+    }
+    saida->usado = 0;
+}
+
+// Acrescentar n bytes à saída
+static void escreverBytes(Saida *saida, const void *dados, size_t n) {
+    if (saida->usado + n > TAMANHO_SAIDA) {
+        descarregarSaida(saida);
+    }
+    memcpy(saida->buffer + saida->usado, dados, n);
+    saida->usado += n;
+}
+
+// Acrescentar um texto à saída
+static void escreverTexto(Saida *saida, const char *texto) {
+    escreverBytes(saida, texto, strlen(texto));
+}
+
+// Acrescentar um inteiro em decimal à saída
+static void escreverInteiro(Saida *saida, long long valor) {
+    char digitos[24];
+    int n = sizeof(digitos);
+    unsigned long long resto = valor < 0 ? 0ULL - (unsigned long long)valor : (unsigned long long)valor;
+    do {
+        digitos[--n] = (char)('0' + resto % 10);
+        resto /= 10;
+    } while (resto > 0);
+    if (valor < 0) digitos[--n] = '-';
+    escreverBytes(saida, digitos + n, sizeof(digitos) - n);
+}
+
+// Acrescentar um inteiro de 32 bits em binário (little-endian) à saída
+static void escreverInteiroBinario(Saida *saida, uint32_t valor) {
+    unsigned char bytes[4] = { valor & 0xFF, (valor >> 8) & 0xFF, (valor >> 16) & 0xFF, valor >> 24 };
+    escreverBytes(saida, bytes, 4);
+}
+
+// Escrever um nó no formato escolhido. id é a posição do nó na ordem por
+// nível e primeiroFilho a do seu primeiro filho (os filhos são consecutivos).
+static void exportarNo(Saida *saida, No23 *no, long long id, long long primeiroFilho, FormatoExportacao formato) {
+    if (formato == EXPORTAR_TEXTO) {
+        // Chaves marcadas como removidas aparecem com ~
+        escreverTexto(saida, "[");
+        for (int j = 0; j < no->numChaves; j++) {
+            if (no->mortas[j]) escreverTexto(saida, "~");
+            escreverInteiro(saida, no->chaves[j]);
+            if (j < no->numChaves - 1) escreverTexto(saida, ", ");
+        }
+        escreverTexto(saida, "] ");
+    } else if (formato == EXPORTAR_DOT) {
+        escreverTexto(saida, "  n");
+        escreverInteiro(saida, id);
+        escreverTexto(saida, " [label=\"");
+        for (int j = 0; j < no->numChaves; j++) {
+            if (no->mortas[j]) escreverTexto(saida, "~");
+            escreverInteiro(saida, no->chaves[j]);
+            if (j < no->numChaves - 1) escreverTexto(saida, " | ");
+        }
+        escreverTexto(saida, "\"];\n");
+        if (!no->ehFolha) {
+            for (int j = 0; j <= no->numChaves; j++) {
+                escreverTexto(saida, "  n");
+                escreverInteiro(saida, id);
+                escreverTexto(saida, " -> n");
+                escreverInteiro(saida, primeiroFilho + j);
+                escreverTexto(saida, ";\n");
+            }
+        }
+    } else {
+        // 16 bits com numChaves e o bit 15 indicando folha, as chaves e um
+        // bit de marcação por chave (tudo little-endian); os filhos ficam
+        // implícitos na ordem por nível
+        unsigned int cabecalho = (unsigned int)no->numChaves | (no->ehFolha ? 0x8000u : 0);
+        unsigned char bytes[2] = { cabecalho & 0xFF, cabecalho >> 8 };
+        escreverBytes(saida, bytes, 2);
+        for (int j = 0; j < no->numChaves; j++) {
+            escreverInteiroBinario(saida, (uint32_t)no->chaves[j]);
+        }
+        unsigned char marcacoes[(ORDEM + 7) / 8] = { 0 };
+        for (int j = 0; j < no->numChaves; j++) {
+            if (no->mortas[j]) marcacoes[j / 8] |= (unsigned char)(1 << (j % 8));
+        }
+        escreverBytes(saida, marcacoes, (no->numChaves + 7) / 8);
+    }
+}
+
+// Preparar a saída para gravar no arquivo
+static void iniciarSaida(Saida *saida, FILE *arquivo) {
+    saida->arquivo = arquivo;
+    saida->usado = 0;
+    saida->erro = false;
+}
+
+// Exportar a árvore nível por nível para a saída (preparada com iniciarSaida;
+// o buffer é de quem chama, então exportações simultâneas não se misturam).
+// Cada nível fica num vetor do tamanho exato (a soma dos filhos do nível
+// anterior), então o tempo é linear no número de nós e não há limite de
+// tamanho. Retorna false se a memória ou a gravação falharem.
+static bool exportarPorNivel(No23 *raiz, Saida *saida, FormatoExportacao formato) {
+    if (formato == EXPORTAR_DOT) {
+        escreverTexto(saida, "digraph arvore {\n  node [shape=record];\n");
+    } else if (formato == EXPORTAR_BINARIO) {
+        escreverInteiroBinario(saida, MAGIA_EXPORTACAO);
+        escreverInteiroBinario(saida, ORDEM);
+        escreverInteiroBinario(saida, (uint32_t)contarNos(raiz));
+    }
+    
+    size_t tamanhoNivel = raiz != NULL ? 1 : 0;
+    No23 **nivel = (No23**)malloc(sizeof(No23*) * (tamanhoNivel > 0 ? tamanhoNivel : 1));
+    if (nivel == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return false;
+    }
+    nivel[0] = raiz;
+    long long id = 0;   // Posição do primeiro nó do nível na ordem por nível
+    
+    while (tamanhoNivel > 0) {
+        // Tamanho do próximo nível
+        size_t tamanhoProximo = 0;
+        if (!nivel[0]->ehFolha) {
+            for (size_t i = 0; i < tamanhoNivel; i++) {
+                tamanhoProximo += nivel[i]->numChaves + 1;
+            }
+        }
+        No23 **proximo = NULL;
+        if (tamanhoProximo > 0) {
+            proximo = (No23**)malloc(sizeof(No23*) * tamanhoProximo);
+            if (proximo == NULL) {
+                printf("Erro: Falha na alocação de memória!\n");
+                free(nivel);
+                return false;
+            }
+        }
+        
+        // Escrever o nível e juntar os filhos, na ordem
+        long long primeiroFilho = id + (long long)tamanhoNivel;
+        size_t filhos = 0;
+        for (size_t i = 0; i < tamanhoNivel; i++) {
+            No23 *atual = nivel[i];
+            exportarNo(saida, atual, id + (long long)i, primeiroFilho + (long long)filhos, formato);
+            if (!atual->ehFolha) {
+                for (int j = 0; j <= atual->numChaves; j++) {
+                    proximo[filhos++] = atual->filhos[j];
+                }
+            }
+        }
+        if (formato == EXPORTAR_TEXTO) {
+            escreverTexto(saida, "\n");
+        }
+        
+        free(nivel);
+        id += (long long)tamanhoNivel;
+        nivel = proximo;
+        tamanhoNivel = tamanhoProximo;
+    }
+    free(nivel);
+    
+    if (formato == EXPORTAR_DOT) {
+        escreverTexto(saida, "}\n");
+    }
+    descarregarSaida(saida);
+    return !saida->erro;
+}
+
+// Imprimir por nível (BFS)
+static void imprimirPorNivel(No23 *raiz) {
+    Saida saida;
+    iniciarSaida(&saida, stdout);
+    exportarPorNivel(raiz, &saida, EXPORTAR_TEXTO);
+}
+#endif
+
+// Liberar memória da árvore
+static void liberarArvore(No23 *no) {
+    if (no == NULL) return;
+    
+    if (!no->ehFolha) {
+        for (int i = 0; i <= no->numChaves; i++) {
+            liberarArvore(no->filhos[i]);
+        }
+    }
+    
+    free(no);
+    CONTAR(contadores, liberacoes);
+}
+
+#ifndef SEM_MAIN
+
+// ===================== LOG E RECUPERAÇÃO (log.h) =====================
+
+// Contar as chaves da árvore (sem as marcadas como removidas)
+static int contarChaves(No23 *no) {
+    if (no == NULL) return 0;
+    
+    int total = 0;
+    for (int i = 0; i < no->numChaves; i++) {
+        total += !no->mortas[i];
+    }
+    if (!no->ehFolha) {
+        for (int i = 0; i <= no->numChaves; i++) {
+            total += contarChaves(no->filhos[i]);
+        }
+    }
+    return total;
+}
+
+// Copiar as chaves em ordem para o vetor, a partir da posição *pos (sem as
+// marcadas como removidas); se dados não for NULL, copia também os dados
+static void copiarEmOrdem(No23 *no, int *chaves, int *dados, int *pos) {
+    if (no == NULL) return;
+    
+    for (int i = 0; i < no->numChaves; i++) {
+        if (!no->ehFolha) copiarEmOrdem(no->filhos[i], chaves, dados, pos);
+        if (!no->mortas[i]) {
+            if (dados != NULL) dados[*pos] = dadoDe(no, i);
+            chaves[(*pos)++] = no->chaves[i];
+        }
+    }
+    if (!no->ehFolha) copiarEmOrdem(no->filhos[no->numChaves], chaves, dados, pos);
+}
+
+// Trocar o dado associado a uma chave; retorna false se ela não está na árvore
+static bool alterarDado(No23 *raiz, int chave, int dado) {
+    int posicao;
+    No23 *no = buscar(raiz, chave, &posicao);
+    if (no == NULL) {
+        return false;
+    }
+    
+    definirDado(no, posicao, dado);
+    atualizarCaminho(no);
+    return true;
+}
+
+// Reaplicar uma operação do log (sem mensagens). A inserção deixa a chave
+// com o dado do registro, esteja ela na árvore ou não.
+static void aplicarOperacao(void *estrutura, char operacao, int chave, int dado) {
+    Arvore23 *arvore = (Arvore23*)estrutura;
+    if (operacao == LOG_INSERIR) {
+        bool jaExiste;
+        arvore->raiz = inserirComDado(arvore->raiz, chave, dado, &jaExiste);
+        if (jaExiste) {
+            alterarDado(arvore->raiz, chave, dado);
+        }
+    } else {
+        int posicao;
+        No23 *no = buscar(arvore->raiz, chave, &posicao);
+        if (no != NULL) {
+            arvore->raiz = removerDoNo(arvore->raiz, no, posicao);
+        }
+    }
+}
+
+// Substituir a árvore pelas chaves ordenadas do instantâneo e seus dados
+// (carga em lote, com folga nos nós para as operações que vêm depois)
+static void carregarInstantaneo(void *estrutura, const int *chaves, const int *dados, int n) {
+    Arvore23 *arvore = (Arvore23*)estrutura;
+    liberarArvore(arvore->raiz);
+    arvore->raiz = carregarComDados(chaves, dados, n, PREENCHIMENTO_RECONSTRUCAO);
+    arvore->marcacoes = 0;
+}
+
+// Gravar um instantâneo com as chaves da árvore e seus dados (esvazia o log).
+// Sem agregados o dado é a própria chave e não é gravado.
+static void gravarInstantaneo(LogOperacoes *log, Arvore23 *arvore) {
+    int n = contarChaves(arvore->raiz), pos = 0;
+    int *chaves = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int *dados = AGREGADOS ? (int*)malloc(sizeof(int) * (n > 0 ? n : 1)) : NULL;
+    if (chaves == NULL || (AGREGADOS && dados == NULL)) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(chaves);
+        free(dados);
+        return;
+    }
+    copiarEmOrdem(arvore->raiz, chaves, dados, &pos);
+    logGravarInstantaneo(log, chaves, dados, n);
+    free(chaves);
+    free(dados);
+}
+
+// Registrar uma operação já feita na árvore, com o dado que a chave ficou
+// (e o instantâneo, se for a hora)
+static void registrarOperacao(LogOperacoes *log, Arvore23 *arvore, char operacao, int chave, int dado) {
+    logRegistrarDado(log, operacao, chave, dado);
+    if (logPrecisaInstantaneo(log)) {
+        gravarInstantaneo(log, arvore);
+    }
+}
+
+// Abrir o log de base e recuperar a árvore a partir dele
+static bool abrirLog(LogOperacoes *log, Arvore23 *arvore, const char *base, int grupo, long long intervalo) {
+    if (!logAbrir(log, base, grupo, intervalo)) {
+        return false;
+    }
+    
+    int numChaves;
+    long long numRegistros;
+    liberarArvore(arvore->raiz);
+    arvore->raiz = NULL;
+    arvore->marcacoes = 0;
+    
+    clock_t inicio = clock();
+    if (!logRecuperar(log, arvore, carregarInstantaneo, aplicarOperacao, &numChaves, &numRegistros)) {
+        logFechar(log);
+        return false;
+    }
+    double tempo = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    printf("Recuperação: %d chaves do instantâneo e %lld operações do log em %.3f s.\n",
+           numChaves, numRegistros, tempo);
+    
+    gravarInstantaneo(log, arvore);
+    return true;
+}
+
+// ===================== REMOÇÃO PREGUIÇOSA =====================
+
+// Nesse modo a remoção só marca a chave (lápide) e a busca passa a ignorá-la:
+// custa o mesmo que uma busca, sem redistribuições nem fusões. As chaves
+// marcadas saem todas de uma vez na compactação, que remonta a árvore em lote
+// com as chaves restantes, quando elas passam de 1/FRACAO_MARCADAS do total.
+
+// Contar as chaves marcadas e as não marcadas da árvore
+static void contarMarcadas(No23 *no, int *vivas, int *marcadas) {
+    if (no == NULL) return;
+    
+    for (int i = 0; i < no->numChaves; i++) {
+        if (no->mortas[i]) (*marcadas)++;
+        else (*vivas)++;
+    }
+    if (!no->ehFolha) {
+        for (int i = 0; i <= no->numChaves; i++) {
+            contarMarcadas(no->filhos[i], vivas, marcadas);
+        }
+    }
+}
+
+// Remontar a árvore só com as chaves não marcadas (e seus dados), em uma passada
+static void compactar(Arvore23 *arvore) {
+    int n = contarChaves(arvore->raiz), pos = 0;
+    int *chaves = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int *dados = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (chaves == NULL || dados == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(chaves);
+        free(dados);
+        return;
+    }
+    copiarEmOrdem(arvore->raiz, chaves, dados, &pos);
+    liberarArvore(arvore->raiz);
+    arvore->raiz = carregarComDados(chaves, dados, n, PREENCHIMENTO_RECONSTRUCAO);
+    free(chaves);
+    free(dados);
+    
+    arvore->marcacoes = 0;
+    arvore->limiteMarcacoes = n / FRACAO_MARCADAS > MINIMO_MARCACOES ? n / FRACAO_MARCADAS : MINIMO_MARCACOES;
+    arvore->compactacoes++;
+}
+
+// Conferir quantas chaves estão marcadas (inserir uma chave marcada a
+// desmarca, então as marcações são só uma estimativa) e compactar se passarem
+// do limite; senão, adiar a próxima conferência
+static void conferirCompactacao(Arvore23 *arvore) {
+    int vivas = 0, marcadas = 0;
+    contarMarcadas(arvore->raiz, &vivas, &marcadas);
+    
+    int total = vivas + marcadas;
+    if (marcadas > 0 && marcadas >= total / FRACAO_MARCADAS) {
+        compactar(arvore);
+        return;
+    }
+    arvore->marcacoes = marcadas;
+    arvore->limiteMarcacoes = total / FRACAO_MARCADAS > MINIMO_MARCACOES ? total / FRACAO_MARCADAS : MINIMO_MARCACOES;
+}
+
+// Remover uma chave só marcando-a; retorna false se ela não estava na árvore
+static bool removerPorMarcacao(Arvore23 *arvore, int chave) {
+    int posicao;
+    No23 *no = buscar(arvore->raiz, chave, &posicao);
+    if (no == NULL) {
+        return false;
+    }
+    
+    no->mortas[posicao] = true;
+    retirarDoCaminho(no, dadoDe(no, posicao));
+    if (++arvore->marcacoes >= arvore->limiteMarcacoes) {
+        conferirCompactacao(arvore);
+    }
+    return true;
+}
+
+// ===================== AGREGADOS DE INTERVALO =====================
+
+// Cada nó guarda contagem, soma, mínimo e máximo dos dados da sua subárvore
+// (sem as chaves marcadas). Uma consulta de intervalo desce só pelos dois
+// caminhos das bordas e usa o agregado pronto dos filhos que ficam inteiros
+// dentro do intervalo: O(ORDEM * altura) em vez de visitar cada chave.
+
+// Juntar ao resultado os dados das chaves de inicio a fim na subárvore de no.
+// Todas as chaves da subárvore estão entre menor e maior (exclusive); se o
+// intervalo cobre esse trecho inteiro e usarAgregados, basta o agregado do nó.
+static void agregarSubarvore(No23 *no, int inicio, int fim, long long menor, long long maior,
+                      bool usarAgregados, Agregado *resultado) {
+#if AGREGADOS
+    if (usarAgregados && inicio <= menor + 1 && maior - 1 <= fim) {
+        juntarAgregados(resultado, &no->agregado);
+        return;
+    }
+#else
+    (void)usarAgregados;
+#endif
+    
+    for (int i = 0; i <= no->numChaves; i++) {
+        // O filho i tem as chaves entre as chaves i - 1 e i do nó
+        long long esquerda = i == 0 ? menor : no->chaves[i - 1];
+        long long direita = i == no->numChaves ? maior : no->chaves[i];
+        if (!no->ehFolha && inicio < direita && fim > esquerda) {
+            agregarSubarvore(no->filhos[i], inicio, fim, esquerda, direita, usarAgregados, resultado);
+        }
+        
+        if (i < no->numChaves && !no->mortas[i] && no->chaves[i] >= inicio && no->chaves[i] <= fim) {
+            somarDado(resultado, dadoDe(no, i));
+        }
+    }
+}
+
+// Agregados das chaves de inicio a fim (inclusive)
+static Agregado agregarIntervalo(No23 *raiz, int inicio, int fim) {
+    Agregado resultado = agregadoVazio();
+    if (raiz != NULL && inicio <= fim) {
+        agregarSubarvore(raiz, inicio, fim, (long long)INT_MIN - 1, (long long)INT_MAX + 1, true, &resultado);
+    }
+    return resultado;
+}
+
+// O mesmo resultado visitando cada chave do intervalo em ordem (sem os agregados)
+static Agregado agregarPercorrendo(No23 *raiz, int inicio, int fim) {
+    Agregado resultado = agregadoVazio();
+    if (raiz != NULL && inicio <= fim) {
+        agregarSubarvore(raiz, inicio, fim, (long long)INT_MIN - 1, (long long)INT_MAX + 1, false, &resultado);
+    }
+    return resultado;
+}
+
+// ===================== MEDIÇÃO DE DESEMPENHO =====================
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+static unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Segundos decorridos desde o instante inicio
+static double segundosDesde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Medir inserção, busca e remoção de n valores aleatórios
+// (mesmos valores e mesma ordem da medição de arvoreRN.c)
+static void medirDesempenho(int n) {
+    int *valores = (int*)malloc(sizeof(int) * n);
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        valores[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    No23 *raiz = NULL;
+    bool jaExiste;
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        raiz = inserirChave(raiz, valores[i], &jaExiste);
+    }
+    double tempoInsercao = segundosDesde(inicio);
+    int h = altura(raiz);
+    
+    int encontrados = 0, posicao;
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        encontrados += buscar(raiz, valores[i], &posicao) != NULL;
+    }
+    double tempoBusca = segundosDesde(inicio);
+    
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        No23 *no = buscar(raiz, valores[i], &posicao);
+        if (no != NULL) {
+            raiz = removerDoNo(raiz, no, posicao);
+        }
+    }
+    double tempoRemocao = segundosDesde(inicio);
+    
+    printf("Ordem %d (%d chaves por nó, nó de %zu bytes), altura %d\n",
+           ORDEM, MAX_CHAVES, sizeof(No23), h);
+    printf("Inserção: %.3f s (%.1f ns/op)\n", tempoInsercao, tempoInsercao * 1e9 / n);
+    printf("Busca:    %.3f s (%.1f ns/op, %d encontrados)\n", tempoBusca, tempoBusca * 1e9 / n, encontrados);
+    printf("Remoção:  %.3f s (%.1f ns/op)\n", tempoRemocao, tempoRemocao * 1e9 / n);
+    
+    free(valores);
+}
+
+// Medir a latência de cada operação com histogramas (histograma.h): n
+// inserções, n buscas, alguns percursos em ordem e n remoções de chaves
+// aleatórias. A média esconde a cauda: uma remoção que funde nós até a raiz
+// aparece no p99,9 e no máximo.
+static void medirLatencias(int n) {
+    int *valores = (int*)malloc(sizeof(int) * n);
+    int *copia = (int*)malloc(sizeof(int) * n);
+    if (valores == NULL || copia == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(valores);
+        free(copia);
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        valores[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    static Histograma insercao, busca, percurso, remocao;
+    histogramaZerar(&insercao);
+    histogramaZerar(&busca);
+    histogramaZerar(&percurso);
+    histogramaZerar(&remocao);
+    
+    No23 *raiz = NULL;
+    bool jaExiste;
+    for (int i = 0; i < n; i++) {
+        unsigned long long antes = histogramaAgora();
+        raiz = inserirChave(raiz, valores[i], &jaExiste);
+        histogramaRegistrar(&insercao, histogramaAgora() - antes);
+    }
+    
+    int encontrados = 0, posicao;
+    for (int i = 0; i < n; i++) {
+        unsigned long long antes = histogramaAgora();
+        encontrados += buscar(raiz, valores[i], &posicao) != NULL;
+        histogramaRegistrar(&busca, histogramaAgora() - antes);
+    }
+    
+    for (int p = 0; p < 10; p++) {
+        int pos = 0;
+        unsigned long long antes = histogramaAgora();
+        copiarEmOrdem(raiz, copia, NULL, &pos);
+        histogramaRegistrar(&percurso, histogramaAgora() - antes);
+    }
+    
+    for (int i = 0; i < n; i++) {
+        unsigned long long antes = histogramaAgora();
+        No23 *no = buscar(raiz, valores[i], &posicao);
+        if (no != NULL) {
+            raiz = removerDoNo(raiz, no, posicao);
+        }
+        histogramaRegistrar(&remocao, histogramaAgora() - antes);
+    }
+    
+    printf("Ordem %d, %d chaves (%d encontradas)\n", ORDEM, n, encontrados);
+    histogramaImprimir("Inserção", &insercao);
+    histogramaImprimir("Busca", &busca);
+    histogramaImprimir("Percurso", &percurso);
+    histogramaImprimir("Remoção", &remocao);
+    
+    free(valores);
+    free(copia);
+}
+
+// Comparar a construção por inserções sucessivas (valores ordenados) com a
+// carga em lote, e medir o efeito do preenchimento em m inserções aleatórias
+static void medirCargaEmLote(int n) {
+    int m = n / 10 > 0 ? n / 10 : 1;
+    int *valores = (int*)malloc(sizeof(int) * n);
+    int *novos = (int*)malloc(sizeof(int) * m);
+    if (valores == NULL || novos == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(valores);
+        free(novos);
+        return;
+    }
+    
+    // Valores pares na carga; as inserções seguintes usam ímpares aleatórios
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        valores[i] = 2 * i;
+    }
+    for (int i = 0; i < m; i++) {
+        novos[i] = 2 * (int)(proximoAleatorio(&estado) % n) + 1;
+    }
+    
+    const char *nomes[] = { "inserções", "lote 100%", "lote 85%", "lote 70%", "lote 50%" };
+    double preenchimentos[] = { 0, 1.0, 0.85, 0.7, 0.5 };
+    
+    printf("Ordem %d, %d valores ordenados, depois %d inserções aleatórias\n", ORDEM, n, m);
+    printf("%-10s %10s %6s %10s %12s %12s\n", "construção", "tempo (s)", "altura", "nós", "inserir (s)", "nós novos");
+    
+    for (int t = 0; t < 5; t++) {
+        No23 *raiz = NULL;
+        bool jaExiste;
+        
+        clock_t inicio = clock();
+        if (t == 0) {
+            for (int i = 0; i < n; i++) {
+                raiz = inserirChave(raiz, valores[i], &jaExiste);
+            }
+        } else {
+            raiz = carregarEmLote(valores, n, preenchimentos[t]);
+        }
+        double tempoConstrucao = segundosDesde(inicio);
+        int h = altura(raiz);
+        int nos = contarNos(raiz);
+        
+        inicio = clock();
+        for (int i = 0; i < m; i++) {
+            raiz = inserirChave(raiz, novos[i], &jaExiste);
+        }
+        double tempoInsercao = segundosDesde(inicio);
+        
+        printf("%-10s %10.4f %6d %10d %12.4f %12d\n", nomes[t], tempoConstrucao, h, nos,
+               tempoInsercao, contarNos(raiz) - nos);
+        liberarArvore(raiz);
+    }
+    
+    free(valores);
+    free(novos);
+}
+
+// Instante atual em segundos (relógio de parede: a espera do fsync não
+// aparece no tempo de CPU medido por clock)
+static double agora() {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return instante.tv_sec + instante.tv_nsec / 1e9;
+}
+
+// Medir o custo do log por operação e a recuperação: n operações aleatórias
+// (uma remoção a cada quatro) sem log e com log confirmado a cada grupo
+// operações, com instantâneos a cada n / 4. Depois, simulando uma queda,
+// recuperar do instantâneo e do log e comparar com refazer tudo pela inserção.
+static void medirLog(int n, int grupo) {
+    const char *base = "arvore23_medicao";
+    int *chaves = (int*)malloc(sizeof(int) * n);
+    if (chaves == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        chaves[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    // Sem log (o mesmo que refazer as operações pela inserção)
+    Arvore23 semLog;
+    inicializarArvore(&semLog);
+    double inicio = agora();
+    for (int i = 0; i < n; i++) {
+        int chave = i % 4 == 3 ? chaves[i - 2] : chaves[i];
+        aplicarOperacao(&semLog, i % 4 == 3 ? LOG_REMOVER : LOG_INSERIR, chave, chave);
+    }
+    double tempoSemLog = agora() - inicio;
+    
+    // Com log
+    static LogOperacoes logMedicao;
+    char nome[64];
+    snprintf(nome, sizeof(nome), "%s.log", base);
+    remove(nome);
+    snprintf(nome, sizeof(nome), "%s.inst", base);
+    remove(nome);
+    
+    Arvore23 comLog;
+    inicializarArvore(&comLog);
+    if (!logAbrir(&logMedicao, base, grupo, n / 4 + 1)) {
+        liberarArvore(semLog.raiz);
+        free(chaves);
+        return;
+    }
+    inicio = agora();
+    for (int i = 0; i < n; i++) {
+        char operacao = i % 4 == 3 ? LOG_REMOVER : LOG_INSERIR;
+        int chave = i % 4 == 3 ? chaves[i - 2] : chaves[i];
+        aplicarOperacao(&comLog, operacao, chave, chave);
+        registrarOperacao(&logMedicao, &comLog, operacao, chave, chave);
+    }
+    logFechar(&logMedicao);  // Queda: sem instantâneo final
+    double tempoComLog = agora() - inicio;
+    long long sincronizacoes = logMedicao.sincronizacoes;
+    
+    // Recuperação
+    Arvore23 recuperada;
+    inicializarArvore(&recuperada);
+    int numChaves = 0;
+    long long numRegistros = 0;
+    inicio = agora();
+    if (logAbrir(&logMedicao, base, grupo, 0)) {
+        logRecuperar(&logMedicao, &recuperada, carregarInstantaneo, aplicarOperacao, &numChaves, &numRegistros);
+        logFechar(&logMedicao);
+    }
+    double tempoRecuperacao = agora() - inicio;
+    
+    // Conferir a árvore recuperada
+    int total = contarChaves(comLog.raiz), pos1 = 0, pos2 = 0;
+    bool igual = total == contarChaves(recuperada.raiz);
+    if (igual && total > 0) {
+        int *esperado = (int*)malloc(sizeof(int) * total);
+        int *obtido = (int*)malloc(sizeof(int) * total);
+        copiarEmOrdem(comLog.raiz, esperado, NULL, &pos1);
+        copiarEmOrdem(recuperada.raiz, obtido, NULL, &pos2);
+        igual = memcmp(esperado, obtido, sizeof(int) * total) == 0;
+        free(esperado);
+        free(obtido);
+    }
+    
+    printf("Ordem %d\n", ORDEM);
+    printf("Sem log:     %.3f s (%.1f ns/op)\n", tempoSemLog, tempoSemLog * 1e9 / n);
+    printf("Com log:     %.3f s (%.1f ns/op, +%.1f ns/op, %lld sincronizações, grupo de %d)\n",
+           tempoComLog, tempoComLog * 1e9 / n, (tempoComLog - tempoSemLog) * 1e9 / n, sincronizacoes, logMedicao.tamanhoGrupo);
+    printf("Recuperação: %.3f s (%d chaves do instantâneo + %lld operações do log), árvore %s\n",
+           tempoRecuperacao, numChaves, numRegistros, igual ? "conferida" : "DIFERENTE");
+    printf("Refazer as %d operações pela inserção: %.3f s\n", n, tempoSemLog);
+    
+    snprintf(nome, sizeof(nome), "%s.log", base);
+    remove(nome);
+    snprintf(nome, sizeof(nome), "%s.inst", base);
+    remove(nome);
+    liberarArvore(semLog.raiz);
+    liberarArvore(comLog.raiz);
+    liberarArvore(recuperada.raiz);
+    free(chaves);
+}
+
+// Medir a carga em lote paralela de n chaves aleatórias (com repetidos) com
+// 1, 2, 4... até maxThreads threads, separando a ordenação da montagem, e
+// comparar com inserir uma a uma. Cada árvore montada é conferida com a
+// ordenação.
+static void medirConstrucaoParalela(int n, int maxThreads) {
+    int *chaves = (int*)malloc(sizeof(int) * n);
+    int *trabalho = (int*)malloc(sizeof(int) * n);
+    int *emOrdem = (int*)malloc(sizeof(int) * n);
+    if (chaves == NULL || trabalho == NULL || emOrdem == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(chaves);
+        free(trabalho);
+        free(emOrdem);
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        chaves[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    // Uma a uma, pela inserção
+    No23 *raiz = NULL;
+    bool jaExiste;
+    double inicio = agora();
+    for (int i = 0; i < n; i++) {
+        raiz = inserirChave(raiz, chaves[i], &jaExiste);
+    }
+    double tempoInsercao = agora() - inicio;
+    printf("Ordem %d. Inserção uma a uma: %.3f s (%d nós, altura %d)\n", ORDEM, tempoInsercao, contarNos(raiz), altura(raiz));
+    
+    double base = 0;
+    for (int threads = 1; ; threads = threads * 2 <= maxThreads ? threads * 2 : maxThreads) {
+        // A ordenação sozinha, e depois a carga inteira sobre outra cópia
+        for (int i = 0; i < n; i++) {
+            trabalho[i] = chaves[i];
+        }
+        inicio = agora();
+        ordenarSemRepetidos(trabalho, n, threads);
+        double tempoOrdenacao = agora() - inicio;
+        
+        for (int i = 0; i < n; i++) {
+            trabalho[i] = chaves[i];
+        }
+        liberarArvore(raiz);  // Fora do tempo medido
+        int distintos;
+        inicio = agora();
+        raiz = carregarEmParalelo(trabalho, n, PREENCHIMENTO_RECONSTRUCAO, threads, &distintos);
+        double total = agora() - inicio;
+        if (raiz == NULL) break;
+        double tempoMontagem = total > tempoOrdenacao ? total - tempoOrdenacao : 0;
+        if (threads == 1) base = total;
+        
+        int pos = 0;
+        copiarEmOrdem(raiz, emOrdem, NULL, &pos);
+        bool confere = pos == distintos;
+        for (int i = 0; confere && i < distintos; i++) {
+            confere = emOrdem[i] == trabalho[i];
+        }
+        
+        printf("%3d threads: ordenação %.3f s + montagem %.3f s = %.3f s (%.2fx sobre 1 thread, %.1fx sobre a inserção), "
+               "%d chaves, altura %d, %d nós, %s\n", threads, tempoOrdenacao, tempoMontagem, total, base / total,
+               tempoInsercao / total, distintos, altura(raiz), contarNos(raiz), confere ? "conferida" : "DIFERENTE");
+        if (threads == maxThreads) break;
+    }
+    
+    liberarArvore(raiz);
+    free(chaves);
+    free(trabalho);
+    free(emOrdem);
+}
+
+// Comparar a remoção normal com a remoção por marcação: n valores aleatórios,
+// remoção da metade deles em sequência (rajada) e buscas antes e depois. A
+// compactação automática fica desligada durante a rajada e é medida à parte.
+static void medirRemocaoPreguicosa(int n) {
+    int *valores = (int*)malloc(sizeof(int) * n);
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        valores[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    Arvore23 normal, preguicosa;
+    inicializarArvore(&normal);
+    inicializarArvore(&preguicosa);
+    bool jaExiste;
+    for (int i = 0; i < n; i++) {
+        normal.raiz = inserirChave(normal.raiz, valores[i], &jaExiste);
+        preguicosa.raiz = inserirChave(preguicosa.raiz, valores[i], &jaExiste);
+    }
+    
+    int encontrados = 0, posicao;
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        encontrados += buscar(normal.raiz, valores[i], &posicao) != NULL;
+    }
+    double tempoBusca = segundosDesde(inicio);
+    
+    // Remover os valores de índice par
+    inicio = clock();
+    for (int i = 0; i < n; i += 2) {
+        No23 *no = buscar(normal.raiz, valores[i], &posicao);
+        if (no != NULL) {
+            normal.raiz = removerDoNo(normal.raiz, no, posicao);
+        }
+    }
+    double tempoNormal = segundosDesde(inicio);
+    
+    preguicosa.limiteMarcacoes = n;
+    inicio = clock();
+    for (int i = 0; i < n; i += 2) {
+        removerPorMarcacao(&preguicosa, valores[i]);
+    }
+    double tempoMarcacao = segundosDesde(inicio);
+    
+    // Buscas com metade das chaves marcadas
+    int restantesMarcadas = 0;
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        restantesMarcadas += buscar(preguicosa.raiz, valores[i], &posicao) != NULL;
+    }
+    double tempoBuscaMarcadas = segundosDesde(inicio);
+    
+    inicio = clock();
+    compactar(&preguicosa);
+    double tempoCompactacao = segundosDesde(inicio);
+    
+    // Buscar todos de novo: metade não deve ser encontrada
+    int restantesNormal = 0, restantesMarcacao = 0;
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        restantesNormal += buscar(normal.raiz, valores[i], &posicao) != NULL;
+    }
+    double tempoBuscaNormal = segundosDesde(inicio);
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        restantesMarcacao += buscar(preguicosa.raiz, valores[i], &posicao) != NULL;
+    }
+    double tempoBuscaMarcacao = segundosDesde(inicio);
+    
+    int removidos = (n + 1) / 2;
+    printf("Ordem %d, %d valores, %d removidos em rajada\n", ORDEM, n, removidos);
+    printf("Busca:                 %.1f ns/op (%d encontrados)\n", tempoBusca * 1e9 / n, encontrados);
+    printf("Remoção normal:        %.1f ns/op\n", tempoNormal * 1e9 / removidos);
+    printf("Remoção por marcação:  %.1f ns/op\n", tempoMarcacao * 1e9 / removidos);
+    printf("Compactação:           %.3f s (%.1f ns por chave removida)\n",
+           tempoCompactacao, tempoCompactacao * 1e9 / removidos);
+    printf("Busca depois: normal %.1f ns/op (%d), marcadas %.1f ns/op (%d), compactada %.1f ns/op (%d)\n",
+           tempoBuscaNormal * 1e9 / n, restantesNormal, tempoBuscaMarcadas * 1e9 / n, restantesMarcadas,
+           tempoBuscaMarcacao * 1e9 / n, restantesMarcacao);
+    
+    liberarArvore(normal.raiz);
+    liberarArvore(preguicosa.raiz);
+    free(valores);
+}
+
+// Medir consultas de intervalo com e sem os agregados: n chaves aleatórias com
+// dados de 0 a 999, depois consultas de intervalos aleatórios que cobrem em
+// média 5% das chaves. Também mede a inserção, para comparar com -DAGREGADOS=0.
+static void medirAgregados(int n, int consultas) {
+    int *valores = (int*)malloc(sizeof(int) * n);
+    int *inicios = (int*)malloc(sizeof(int) * consultas);
+    int *fins = (int*)malloc(sizeof(int) * consultas);
+    if (valores == NULL || inicios == NULL || fins == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(valores);
+        free(inicios);
+        free(fins);
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        valores[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    // Largura de 0 a 10% do espaço das chaves
+    for (int i = 0; i < consultas; i++) {
+        unsigned int largura = proximoAleatorio(&estado) % (INT_MAX / 10u);
+        inicios[i] = (int)(proximoAleatorio(&estado) % (INT_MAX - largura));
+        fins[i] = inicios[i] + (int)largura;
+    }
+    
+    No23 *raiz = NULL;
+    bool jaExiste;
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        raiz = inserirComDado(raiz, valores[i], (int)(proximoAleatorio(&estado) % 1000), &jaExiste);
+    }
+    double tempoInsercao = segundosDesde(inicio);
+    
+    // Somas de conferência: os dois métodos devem dar o mesmo resultado
+    long long contagemAgregada = 0, somaAgregada = 0, extremosAgregada = 0;
+    inicio = clock();
+    for (int i = 0; i < consultas; i++) {
+        Agregado agregado = agregarIntervalo(raiz, inicios[i], fins[i]);
+        contagemAgregada += agregado.contagem;
+        somaAgregada += agregado.soma;
+        if (agregado.contagem > 0) extremosAgregada += agregado.minimo + agregado.maximo;
+    }
+    double tempoAgregados = segundosDesde(inicio);
+    
+    long long contagemPercurso = 0, somaPercurso = 0, extremosPercurso = 0;
+    inicio = clock();
+    for (int i = 0; i < consultas; i++) {
+        Agregado agregado = agregarPercorrendo(raiz, inicios[i], fins[i]);
+        contagemPercurso += agregado.contagem;
+        somaPercurso += agregado.soma;
+        if (agregado.contagem > 0) extremosPercurso += agregado.minimo + agregado.maximo;
+    }
+    double tempoPercurso = segundosDesde(inicio);
+    
+    printf("Ordem %d, agregados %s, %d valores, %d consultas (%.0f chaves por consulta em média)\n",
+           ORDEM, AGREGADOS ? "ligados" : "desligados", n, consultas, (double)contagemPercurso / consultas);
+    printf("Inserção:               %.1f ns/op\n", tempoInsercao * 1e9 / n);
+    printf("Intervalo (agregados):  %.1f ns/consulta\n", tempoAgregados * 1e9 / consultas);
+    printf("Intervalo (percurso):   %.1f ns/consulta\n", tempoPercurso * 1e9 / consultas);
+    printf("Resultados %s\n", contagemAgregada == contagemPercurso && somaAgregada == somaPercurso &&
+           extremosAgregada == extremosPercurso ? "iguais" : "DIFERENTES");
+    
+    liberarArvore(raiz);
+    free(valores);
+    free(inicios);
+    free(fins);
+}
+
+// Medir a exportação por nível nos três formatos de uma árvore com n valores
+// (carga em lote com nós pela metade, para ter mais nós)
+static void medirExportacao(int n) {
+    int *valores = (int*)malloc(sizeof(int) * n);
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        valores[i] = i;
+    }
+    No23 *raiz = carregarEmLote(valores, n, 0.5);
+    free(valores);
+    int nos = contarNos(raiz);
+    
+    const char *nomes[] = { "texto", "DOT", "binário" };
+    FormatoExportacao formatos[] = { EXPORTAR_TEXTO, EXPORTAR_DOT, EXPORTAR_BINARIO };
+    Saida saida;
+    
+    printf("Ordem %d, %d valores, %d nós, altura %d\n", ORDEM, n, nos, altura(raiz));
+    printf("%-8s %10s %10s %12s\n", "formato", "tempo (s)", "ns/nó", "bytes");
+    for (int f = 0; f < 3; f++) {
+        FILE *arquivo = fopen("exportacao.tmp", "wb");
+        if (arquivo == NULL) {
+            printf("Erro: Não foi possível criar exportacao.tmp!\n");
+            break;
+        }
+        iniciarSaida(&saida, arquivo);
+        clock_t inicio = clock();
+        bool ok = exportarPorNivel(raiz, &saida, formatos[f]);
+        double tempo = segundosDesde(inicio);
+        long bytes = ftell(arquivo);
+        fclose(arquivo);
+        printf("%-8s %10.3f %10.1f %12ld%s\n", nomes[f], tempo, tempo * 1e9 / nos, bytes, ok ? "" : " (falhou)");
+    }
+    remove("exportacao.tmp");
+    liberarArvore(raiz);
+}
+
+#endif
+
+// ===================== INTERFACE DE CONJUNTO (conjunto.h) =====================
+
+// Estado do conjunto: a árvore e a quantidade de chaves
+typedef struct {
+    Arvore23 arvore;
+    long long tamanho;
+} Conjunto23;
+
+static void* criarConjunto23(void) {
+    Conjunto23 *conjunto = (Conjunto23*)malloc(sizeof(Conjunto23));
+    if (conjunto == NULL) return NULL;
+    inicializarArvore(&conjunto->arvore);
+    conjunto->tamanho = 0;
+    return conjunto;
+}
+
+static bool inserirConjunto23(void *estado, int chave) {
+    Conjunto23 *conjunto = (Conjunto23*)estado;
+    bool jaExiste;
+    conjunto->arvore.raiz = inserirChave(conjunto->arvore.raiz, chave, &jaExiste);
+    if (jaExiste) return false;
+    conjunto->tamanho++;
+    return true;
+}
+
+static bool contemConjunto23(void *estado, int chave) {
+    int posicao;
+    return buscar(((Conjunto23*)estado)->arvore.raiz, chave, &posicao) != NULL;
+}
+
+static bool removerConjunto23(void *estado, int chave) {
+    Conjunto23 *conjunto = (Conjunto23*)estado;
+    int posicao;
+    No23 *no = buscar(conjunto->arvore.raiz, chave, &posicao);
+    if (no == NULL) return false;
+    conjunto->arvore.raiz = removerDoNo(conjunto->arvore.raiz, no, posicao);
+    conjunto->tamanho--;
+    return true;
+}
+
+// Em ordem, chamando visitar para cada chave não marcada
+static void percorrerEmOrdem(No23 *no, ConjuntoVisitar visitar, void *contexto) {
+    if (no == NULL) return;
+    
+    for (int i = 0; i < no->numChaves; i++) {
+        if (!no->ehFolha) percorrerEmOrdem(no->filhos[i], visitar, contexto);
+        if (!no->mortas[i]) visitar(no->chaves[i], contexto);
+    }
+    if (!no->ehFolha) percorrerEmOrdem(no->filhos[no->numChaves], visitar, contexto);
+}
+
+static void percorrerConjunto23(void *estado, ConjuntoVisitar visitar, void *contexto) {
+    percorrerEmOrdem(((Conjunto23*)estado)->arvore.raiz, visitar, contexto);
+}
+
+// Em ordem, descendo só nos filhos que podem ter chaves de [inicio, fim]
+static void percorrerIntervaloEmOrdem(No23 *no, int inicio, int fim, ConjuntoVisitar visitar, void *contexto) {
+    if (no == NULL) return;
+    
+    for (int i = 0; i <= no->numChaves; i++) {
+        // O filho i tem as chaves entre as chaves i - 1 e i do nó
+        if (!no->ehFolha && (i == 0 || no->chaves[i - 1] < fim) && (i == no->numChaves || no->chaves[i] > inicio)) {
+            percorrerIntervaloEmOrdem(no->filhos[i], inicio, fim, visitar, contexto);
+        }
+        if (i < no->numChaves) {
+            if (no->chaves[i] > fim) return;
+            if (!no->mortas[i] && no->chaves[i] >= inicio) visitar(no->chaves[i], contexto);
+        }
+    }
+}
+
+static void percorrerIntervalo23(void *estado, int inicio, int fim, ConjuntoVisitar visitar, void *contexto) {
+    percorrerIntervaloEmOrdem(((Conjunto23*)estado)->arvore.raiz, inicio, fim, visitar, contexto);
+}
+
+static long long tamanhoConjunto23(void *estado) {
+    return ((Conjunto23*)estado)->tamanho;
+}
+
+static int alturaConjunto23(void *estado) {
+    return altura(((Conjunto23*)estado)->arvore.raiz);
+}
+
+static Contadores* contadores23(void) {
+    return &contadores;
+}
+
+static void destruirConjunto23(void *estado) {
+    liberarArvore(((Conjunto23*)estado)->arvore.raiz);
+    free(estado);
+}
+
+const OperacoesConjunto conjuntoArvore23 = {
+    ORDEM == 3 ? "Árvore 2-3" : "Árvore B", criarConjunto23, inserirConjunto23, contemConjunto23,
+    removerConjunto23, percorrerConjunto23, percorrerIntervalo23, tamanhoConjunto23, alturaConjunto23,
+    destruirConjunto23, contadores23
+};
+
+#ifndef SEM_MAIN
+
+// ===================== FUNÇÕES DE MENU E MAIN =====================
+
+// Exibir menu principal
+static void exibirMenuPrincipal() {
+    if (ORDEM == 3) {
+        printf("\n=== ÁRVORE 2-3 ===\n");
+    } else {
+        printf("\n=== ÁRVORE B (ORDEM %d) ===\n", ORDEM);
+    }
+    printf("1 - Inserir valor\n");
+    printf("2 - Buscar valor\n");
+    printf("3 - Remover valor\n");
+    printf("4 - Percorrer árvore\n");
+    printf("5 - Medir desempenho\n");
+    printf("6 - Carregar valores ordenados em lote\n");
+    printf("7 - Medir carga em lote\n");
+    printf("8 - Abrir log e recuperar\n");
+    printf("9 - Medir log e recuperação\n");
+    printf("10 - Remover valor por marcação\n");
+    printf("11 - Compactar chaves marcadas\n");
+    printf("12 - Medir remoção por marcação\n");
+    printf("13 - Inserir valor com dado associado\n");
+    printf("14 - Agregados de um intervalo\n");
+    printf("15 - Medir agregados de intervalo\n");
+    printf("16 - Exportar por nível (texto, DOT ou binário)\n");
+    printf("17 - Medir exportação por nível\n");
+    printf("18 - Contadores de instrumentação\n");
+    printf("19 - Medir latências (percentis)\n");
+    printf("20 - Medir carga em lote paralela\n");
+    printf("21 - Latências das operações do menu\n");
+    printf("0 - Sair\n");
+    printf("Escolha uma opção: ");
+}
+
+// Exibir submenu de percursos
+static void exibirSubmenuPercursos() {
+    printf("\n--- TIPOS DE PERCURSO ---\n");
+    printf("1 - Em ordem (crescente)\n");
+    printf("2 - Por nível (estrutura)\n");
     printf("Escolha o tipo de percurso: ");
 }
 
-// Função principal
-int main() {
+// Função principal. Com um nome de arquivo na linha de comando, as operações
+// de inserção, busca e remoção do menu são gravadas nele (rastro.h, replay.c).
+// Com -s e o caminho de um socket, a árvore atende pedidos pelo socket em vez
+// de abrir o menu (servidor.h, carga.c).
+int main(int argc, char **argv) {
+    // Modo servidor: arvore23 -s caminho.sock
+    if (argc > 2 && strcmp(argv[1], "-s") == 0) {
+        return servirConjunto(&conjuntoArvore23, argv[2]);
+    }
+    
     Arvore23 arvore;
     inicializarArvore(&arvore);
     
     int opcao, subOpcao, valor;
+    unsigned long long antes;
+    bool mudou;     // Se a inserção ou remoção do menu mudou a árvore
+    
+    // Latências das operações do menu (opção 21, e o relatório ao sair)
+    static LatenciasMenu latencias;
+    
+    // Log das operações (opção 8); cada operação do menu é confirmada na hora
+    static LogOperacoes logOperacoes;
+    bool logAtivo = false;
+    char base[200];
+    
+    // Rastro das operações, se o nome do arquivo vier na linha de comando
+    static Rastro rastro;
+    bool rastroAtivo = argc > 1 && rastroAbrir(&rastro, argv[1]);
     
     do {
         exibirMenuPrincipal();
@@ -608,28 +2170,55 @@ int main() {
             case 1:
                 printf("Digite o valor a ser inserido: ");
                 scanf("%d", &valor);
-                arvore.raiz = inserir(arvore.raiz, valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_INSERIR, valor);
+                }
+                antes = histogramaAgora();
+                arvore.raiz = inserir(arvore.raiz, valor, &mudou);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                if (!mudou) break;
+                // Só o que mudou a árvore vai para o log (cada registro custa um fsync)
+                if (logAtivo) {
+                    registrarOperacao(&logOperacoes, &arvore, LOG_INSERIR, valor, valor);
+                    logConfirmar(&logOperacoes);
+                }
                 printf("Valor %d inserido.\n", valor);
                 break;
-                
+            
             case 2:
                 printf("Digite o valor a ser buscado: ");
                 scanf("%d", &valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_BUSCAR, valor);
+                }
                 int posicao;
-                if (buscar(arvore.raiz, valor, &posicao) != NULL) {
+                antes = histogramaAgora();
+                No23 *encontrado = buscar(arvore.raiz, valor, &posicao);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
+                if (encontrado != NULL) {
                     printf("Valor %d encontrado na árvore.\n", valor);
                 } else {
                     printf("Valor %d não encontrado na árvore.\n", valor);
                 }
                 break;
-                
+            
             case 3:
                 printf("Digite o valor a ser removido: ");
                 scanf("%d", &valor);
-                arvore.raiz = removerChave(arvore.raiz, valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_REMOVER, valor);
+                }
+                antes = histogramaAgora();
+                arvore.raiz = removerChave(arvore.raiz, valor, &mudou);
+                latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                if (!mudou) break;
+                if (logAtivo) {
+                    registrarOperacao(&logOperacoes, &arvore, LOG_REMOVER, valor, valor);
+                    logConfirmar(&logOperacoes);
+                }
                 printf("Valor %d removido.\n", valor);
                 break;
-                
+            
             case 4:
                 if (arvoreVazia(&arvore)) {
                     printf("Árvore vazia!\n");
@@ -637,6 +2226,7 @@ int main() {
                     exibirSubmenuPercursos();
                     scanf("%d", &subOpcao);
                     
+                    antes = histogramaAgora();
                     switch (subOpcao) {
                         case 1:
                             printf("Percorrendo em ordem: ");
@@ -650,22 +2240,273 @@ int main() {
                         default:
                             printf("Opção inválida!\n");
                     }
+                    if (subOpcao == 1 || subOpcao == 2) {
+                        latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    }
+                }
+                break;
+            
+            case 5:
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                if (valor > 0) {
+                    medirDesempenho(valor);
                 }
                 break;
+            
+            case 6: {
+                double preenchimento;
+                printf("Quantidade de valores (10, 20, 30, ...): ");
+                scanf("%d", &valor);
+                printf("Taxa de preenchimento dos nós (0 a 1): ");
+                scanf("%lf", &preenchimento);
+                if (valor <= 0) break;
+                
+                int *valores = (int*)malloc(sizeof(int) * valor);
+                if (valores == NULL) {
+                    printf("Erro: Falha na alocação de memória!\n");
+                    break;
+                }
+                for (int i = 0; i < valor; i++) {
+                    valores[i] = (i + 1) * 10;
+                }
                 
+                // A carga substitui a árvore atual
+                liberarArvore(arvore.raiz);
+                arvore.raiz = carregarEmLote(valores, valor, preenchimento);
+                arvore.marcacoes = 0;
+                printf("%d valores carregados (altura %d, %d nós).\n", valor, altura(arvore.raiz), contarNos(arvore.raiz));
+                free(valores);
+                
+                // A carga não passa pelo log: vira o novo instantâneo
+                if (logAtivo) {
+                    gravarInstantaneo(&logOperacoes, &arvore);
+                }
+                break;
+            }
+            
+            case 7:
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                if (valor > 0) {
+                    medirCargaEmLote(valor);
+                }
+                break;
+            
+            case 8:
+                printf("Nome base dos arquivos do log: ");
+                scanf("%199s", base);
+                if (logAtivo) {
+                    gravarInstantaneo(&logOperacoes, &arvore);
+                    logFechar(&logOperacoes);
+                }
+                // A árvore atual é substituída pela recuperada
+                logAtivo = abrirLog(&logOperacoes, &arvore, base, 1, INTERVALO_INSTANTANEO);
+                break;
+            
+            case 9: {
+                int grupo;
+                printf("Quantidade de operações: ");
+                scanf("%d", &valor);
+                printf("Operações por sincronização do log: ");
+                scanf("%d", &grupo);
+                if (valor > 0) {
+                    medirLog(valor, grupo);
+                }
+                break;
+            }
+            
+            case 10:
+                printf("Digite o valor a ser removido: ");
+                scanf("%d", &valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_REMOVER, valor);
+                }
+                antes = histogramaAgora();
+                bool marcado = removerPorMarcacao(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                if (marcado) {
+                    if (logAtivo) {
+                        registrarOperacao(&logOperacoes, &arvore, LOG_REMOVER, valor, valor);
+                        logConfirmar(&logOperacoes);
+                    }
+                    printf("Valor %d marcado como removido.\n", valor);
+                } else {
+                    printf("Chave %d não encontrada.\n", valor);
+                }
+                break;
+            
+            case 11:
+                compactar(&arvore);
+                printf("Árvore compactada (altura %d, %d nós).\n", altura(arvore.raiz), contarNos(arvore.raiz));
+                break;
+            
+            case 12:
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                if (valor > 0) {
+                    medirRemocaoPreguicosa(valor);
+                }
+                break;
+            
+            case 13: {
+                int dado;
+                bool jaExiste;
+                printf("Digite o valor a ser inserido: ");
+                scanf("%d", &valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_INSERIR, valor);
+                }
+                printf("Digite o dado associado: ");
+                scanf("%d", &dado);
+                if (!AGREGADOS) {
+                    printf("Agregados desligados: o dado associado é o próprio valor.\n");
+                }
+                antes = histogramaAgora();
+                arvore.raiz = inserirComDado(arvore.raiz, valor, dado, &jaExiste);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                if (jaExiste) {
+                    alterarDado(arvore.raiz, valor, dado);
+                }
+                if (logAtivo) {
+                    // O registro leva o dado: na recuperação ele insere ou altera
+                    registrarOperacao(&logOperacoes, &arvore, LOG_INSERIR, valor, dado);
+                    logConfirmar(&logOperacoes);
+                }
+                if (jaExiste) {
+                    printf("Dado do valor %d alterado para %d.\n", valor, dado);
+                } else {
+                    printf("Valor %d inserido com dado %d.\n", valor, dado);
+                }
+                break;
+            }
+            
+            case 14: {
+                int fim;
+                printf("Início do intervalo: ");
+                scanf("%d", &valor);
+                printf("Fim do intervalo: ");
+                scanf("%d", &fim);
+                Agregado agregado = agregarIntervalo(arvore.raiz, valor, fim);
+                if (agregado.contagem == 0) {
+                    printf("Nenhum valor entre %d e %d.\n", valor, fim);
+                } else {
+                    printf("Valores entre %d e %d: %d, soma dos dados %lld, mínimo %d, máximo %d\n",
+                           valor, fim, agregado.contagem, agregado.soma, agregado.minimo, agregado.maximo);
+                }
+                break;
+            }
+            
+            case 15: {
+                int consultas;
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                printf("Quantidade de consultas: ");
+                scanf("%d", &consultas);
+                if (valor > 0 && consultas > 0) {
+                    medirAgregados(valor, consultas);
+                }
+                break;
+            }
+            
+            case 16: {
+                char nomeArquivo[200];
+                printf("Formato (1 - texto, 2 - DOT, 3 - binário): ");
+                scanf("%d", &subOpcao);
+                if (subOpcao < 1 || subOpcao > 3) {
+                    printf("Opção inválida!\n");
+                    break;
+                }
+                printf("Nome do arquivo: ");
+                scanf("%199s", nomeArquivo);
+                FILE *arquivo = fopen(nomeArquivo, subOpcao == 3 ? "wb" : "w");
+                if (arquivo == NULL) {
+                    printf("Erro: Não foi possível criar %s!\n", nomeArquivo);
+                    break;
+                }
+                static Saida saida;
+                iniciarSaida(&saida, arquivo);
+                bool ok = exportarPorNivel(arvore.raiz, &saida, (FormatoExportacao)(subOpcao - 1));
+                if (fclose(arquivo) != 0) ok = false;
+                if (ok) {
+                    printf("Árvore exportada para %s (%d nós).\n", nomeArquivo, contarNos(arvore.raiz));
+                } else {
+                    printf("Erro: Falha ao gravar %s!\n", nomeArquivo);
+                }
+                break;
+            }
+            
+            case 17:
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                if (valor > 0) {
+                    medirExportacao(valor);
+                }
+                break;
+            
+            case 18:
+                // Contagem desde a última consulta (ou desde o início)
+                imprimirContadores(&contadores);
+                zerarContadores(&contadores);
+                break;
+            
+            case 19:
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                if (valor > 0) {
+                    medirLatencias(valor);
+                }
+                break;
+            
+            case 20: {
+                int maxThreads;
+                printf("Quantidade de chaves: ");
+                scanf("%d", &valor);
+                printf("Máximo de threads: ");
+                scanf("%d", &maxThreads);
+                if (valor > 0 && maxThreads > 0) {
+                    medirConstrucaoParalela(valor, maxThreads);
+                }
+                break;
+            }
+            
+            case 21:
+                latenciasImprimir(&latencias);
+                break;
+            
             case 0:
                 printf("Encerrando programa...\n");
                 break;
-                
+            
             default:
                 printf("Opção inválida! Tente novamente.\n");
         }
         
     } while (opcao != 0);
     
+    // Instantâneo final: o próximo início não precisa reaplicar o log
+    if (logAtivo) {
+        gravarInstantaneo(&logOperacoes, &arvore);
+        logFechar(&logOperacoes);
+    }
+    
+    if (rastroAtivo) {
+        if (rastroFechar(&rastro)) {
+            printf("Rastro com %lld operações gravado em %s.\n", rastro.operacoes, argv[1]);
+        } else {
+            printf("Erro: Falha ao gravar o rastro %s!\n", argv[1]);
+        }
+    }
+    
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+    
     // Liberar memória
     liberarArvore(arvore.raiz);
     printf("Memória liberada. Programa encerrado.\n");
     
     return 0;
-}
\ No newline at end of file
+}
+
+#endif
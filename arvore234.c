@@ -0,0 +1,667 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include "histograma.h"
+
+// Árvore B com inserção e remoção descendentes (top-down), em uma única
+// passagem da raiz até a folha. Na descida, todo filho cheio é dividido antes
+// de se entrar nele (inserção) e todo filho com o mínimo de chaves recebe uma
+// chave de um irmão ou é fundido com ele (remoção). Assim nenhuma mudança
+// precisa subir de volta e o nó não guarda ponteiro para o pai. Como cada nó
+// só é alterado enquanto a descida passa por ele, esta forma também é a base
+// para travar nós em sequência (lock coupling) numa versão concorrente.
+//
+// A divisão antecipada exige ORDEM par: um nó cheio (ORDEM - 1 chaves) se
+// divide em duas metades iguais mais a chave do meio. Com ORDEM 4 (padrão) ela
+// é a árvore 2-3-4; a árvore 2-3 (ORDEM 3) continua em arvore23.c.
+// Compilar com: gcc arvore234.c -o arvore234 -DORDEM=16
+#ifndef ORDEM
+#define ORDEM 4
+#endif
+
+#if ORDEM < 4 || ORDEM % 2 != 0
+#error "ORDEM deve ser par e pelo menos 4"
+#endif
+
+#define MAX_CHAVES (ORDEM - 1)      // Máximo de chaves por nó
+#define MIN_CHAVES (ORDEM / 2 - 1)  // Mínimo de chaves (exceto a raiz)
+
+// ===================== ESTRUTURAS DE DADOS =====================
+
+// Estrutura de um nó da Árvore 2-3-4 (sem ponteiro para o pai)
+typedef struct No234 {
+    int chaves[ORDEM];          // Até MAX_CHAVES chaves; a posição extra deixa o
+                                // laço de encontrarFilho com tamanho par (SIMD)
+    int numChaves;              // Quantidade atual de chaves
+    bool ehFolha;               // Indica se é folha
+    struct No234 *filhos[ORDEM]; // Até ORDEM filhos
+} No234;
+
+// Estrutura da Árvore 2-3-4
+typedef struct {
+    No234 *raiz;
+} Arvore234;
+
+// ===================== FUNÇÕES AUXILIARES =====================
+
+// Criar um novo nó vazio
+No234* criarNo(bool ehFolha) {
+    No234 *novoNo = (No234*)malloc(sizeof(No234));
+    if (novoNo == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        exit(1);
+    }
+
+    novoNo->numChaves = 0;
+    novoNo->ehFolha = ehFolha;
+
+    // Inicializar chaves e filhos (encontrarFilho lê todas as posições)
+    for (int i = 0; i < ORDEM; i++) {
+        novoNo->chaves[i] = 0;
+        novoNo->filhos[i] = NULL;
+    }
+
+    return novoNo;
+}
+
+// Inicializar árvore
+void inicializarArvore(Arvore234 *arvore) {
+    arvore->raiz = NULL;
+}
+
+// Verificar se árvore está vazia
+int arvoreVazia(Arvore234 *arvore) {
+    return arvore->raiz == NULL;
+}
+
+// Encontrar o filho apropriado para uma chave: quantas chaves do nó são
+// menores ou iguais a ela (laço sem desvios, como em arvore23.c)
+int encontrarFilho(No234 *no, int chave) {
+    int filho = 0;
+    for (int i = 0; i < ORDEM; i++) {
+        filho += (i < no->numChaves) & (no->chaves[i] <= chave);
+    }
+    return filho;
+}
+
+// ===================== FUNÇÃO DE BUSCA =====================
+
+// Buscar uma chave na árvore
+No234* buscar(No234 *raiz, int chave, int *posicao) {
+    while (raiz != NULL) {
+        int filho = encontrarFilho(raiz, chave);
+        if (filho > 0 && raiz->chaves[filho - 1] == chave) {
+            *posicao = filho - 1;
+            return raiz;
+        }
+
+        if (raiz->ehFolha) {
+            return NULL;
+        }
+
+        raiz = raiz->filhos[filho];
+    }
+    return NULL;
+}
+
+// ===================== FUNÇÕES DE INSERÇÃO =====================
+
+// Dividir o filho cheio de índice i: a chave do meio sobe para o pai (que
+// tem espaço, pois a descida nunca entra num nó cheio) e a metade direita
+// vai para um novo nó. Nenhum ponteiro para pai precisa ser atualizado.
+void dividirFilho(No234 *pai, int i) {
+    No234 *filho = pai->filhos[i];
+    No234 *novoNo = criarNo(filho->ehFolha);
+
+    // Metade direita para o novo nó
+    novoNo->numChaves = MIN_CHAVES;
+    for (int j = 0; j < MIN_CHAVES; j++) {
+        novoNo->chaves[j] = filho->chaves[j + MIN_CHAVES + 1];
+    }
+    if (!filho->ehFolha) {
+        for (int j = 0; j <= MIN_CHAVES; j++) {
+            novoNo->filhos[j] = filho->filhos[j + MIN_CHAVES + 1];
+            filho->filhos[j + MIN_CHAVES + 1] = NULL;
+        }
+    }
+    filho->numChaves = MIN_CHAVES;
+
+    // Abrir espaço no pai para a chave do meio e o novo filho
+    for (int j = pai->numChaves; j > i; j--) {
+        pai->chaves[j] = pai->chaves[j - 1];
+        pai->filhos[j + 1] = pai->filhos[j];
+    }
+    pai->chaves[i] = filho->chaves[MIN_CHAVES];
+    pai->filhos[i + 1] = novoNo;
+    pai->numChaves++;
+}
+
+// Inserir sem mensagens; *jaExiste indica se a chave já estava na árvore
+No234* inserirChave(No234 *raiz, int chave, bool *jaExiste) {
+    *jaExiste = false;
+
+    // Caso especial: árvore vazia
+    if (raiz == NULL) {
+        raiz = criarNo(true);
+        raiz->chaves[0] = chave;
+        raiz->numChaves = 1;
+        return raiz;
+    }
+
+    // Raiz cheia: dividi-la agora é o único jeito de a árvore crescer
+    if (raiz->numChaves == MAX_CHAVES) {
+        No234 *novaRaiz = criarNo(false);
+        novaRaiz->filhos[0] = raiz;
+        dividirFilho(novaRaiz, 0);
+        raiz = novaRaiz;
+    }
+
+    // Descer dividindo todo filho cheio antes de entrar nele
+    No234 *atual = raiz;
+    while (true) {
+        int filho = encontrarFilho(atual, chave);
+        if (filho > 0 && atual->chaves[filho - 1] == chave) {
+            *jaExiste = true;
+            return raiz;
+        }
+
+        if (atual->ehFolha) {
+            // A folha tem espaço: deslocar as chaves maiores e inserir
+            for (int j = atual->numChaves; j > filho; j--) {
+                atual->chaves[j] = atual->chaves[j - 1];
+            }
+            atual->chaves[filho] = chave;
+            atual->numChaves++;
+            return raiz;
+        }
+
+        if (atual->filhos[filho]->numChaves == MAX_CHAVES) {
+            dividirFilho(atual, filho);
+
+            // A chave que subiu pode ser a procurada ou mudar o lado
+            if (atual->chaves[filho] == chave) {
+                *jaExiste = true;
+                return raiz;
+            }
+            if (chave > atual->chaves[filho]) {
+                filho++;
+            }
+        }
+        atual = atual->filhos[filho];
+    }
+}
+
+// Função principal de inserção
+No234* inserir(No234 *raiz, int chave) {
+    bool jaExiste;
+    raiz = inserirChave(raiz, chave, &jaExiste);
+    if (jaExiste) {
+        printf("Chave %d já existe na árvore.\n", chave);
+    }
+    return raiz;
+}
+
+// ===================== FUNÇÕES DE REMOÇÃO =====================
+
+// Filho i recebe a maior chave do irmão à esquerda (rotação pelo pai)
+void redistribuirEsquerda(No234 *pai, int i) {
+    No234 *no = pai->filhos[i];
+    No234 *irmao = pai->filhos[i - 1];
+
+    // Abrir espaço no início do nó
+    for (int j = no->numChaves; j > 0; j--) {
+        no->chaves[j] = no->chaves[j - 1];
+    }
+    if (!no->ehFolha) {
+        for (int j = no->numChaves + 1; j > 0; j--) {
+            no->filhos[j] = no->filhos[j - 1];
+        }
+        no->filhos[0] = irmao->filhos[irmao->numChaves];
+        irmao->filhos[irmao->numChaves] = NULL;
+    }
+
+    // Chave do pai desce, maior chave do irmão sobe
+    no->chaves[0] = pai->chaves[i - 1];
+    no->numChaves++;
+    pai->chaves[i - 1] = irmao->chaves[irmao->numChaves - 1];
+    irmao->numChaves--;
+}
+
+// Filho i recebe a menor chave do irmão à direita (rotação pelo pai)
+void redistribuirDireita(No234 *pai, int i) {
+    No234 *no = pai->filhos[i];
+    No234 *irmao = pai->filhos[i + 1];
+
+    // Chave do pai desce, menor chave do irmão sobe
+    no->chaves[no->numChaves] = pai->chaves[i];
+    if (!no->ehFolha) {
+        no->filhos[no->numChaves + 1] = irmao->filhos[0];
+    }
+    no->numChaves++;
+    pai->chaves[i] = irmao->chaves[0];
+
+    // Deslocar chaves e filhos do irmão
+    for (int j = 0; j < irmao->numChaves - 1; j++) {
+        irmao->chaves[j] = irmao->chaves[j + 1];
+    }
+    if (!irmao->ehFolha) {
+        for (int j = 0; j < irmao->numChaves; j++) {
+            irmao->filhos[j] = irmao->filhos[j + 1];
+        }
+        irmao->filhos[irmao->numChaves] = NULL;
+    }
+    irmao->numChaves--;
+}
+
+// Fundir os filhos i e i + 1 com a chave i do pai entre eles (o da direita é liberado)
+void fundirFilhos(No234 *pai, int i) {
+    No234 *esquerdo = pai->filhos[i];
+    No234 *direito = pai->filhos[i + 1];
+
+    // Chave do pai desce para o meio
+    esquerdo->chaves[esquerdo->numChaves] = pai->chaves[i];
+    for (int j = 0; j < direito->numChaves; j++) {
+        esquerdo->chaves[esquerdo->numChaves + 1 + j] = direito->chaves[j];
+    }
+    if (!esquerdo->ehFolha) {
+        for (int j = 0; j <= direito->numChaves; j++) {
+            esquerdo->filhos[esquerdo->numChaves + 1 + j] = direito->filhos[j];
+        }
+    }
+    esquerdo->numChaves += direito->numChaves + 1;
+
+    // Remover a chave e o ponteiro do direito do pai
+    for (int j = i; j < pai->numChaves - 1; j++) {
+        pai->chaves[j] = pai->chaves[j + 1];
+        pai->filhos[j + 1] = pai->filhos[j + 2];
+    }
+    pai->filhos[pai->numChaves] = NULL;
+    pai->numChaves--;
+
+    free(direito);
+}
+
+// Garantir que o filho i tenha mais que o mínimo antes de descer nele;
+// retorna o índice do filho por onde continuar (muda se fundir à esquerda)
+int garantirFilho(No234 *pai, int i) {
+    if (pai->filhos[i]->numChaves > MIN_CHAVES) {
+        return i;
+    }
+
+    if (i > 0 && pai->filhos[i - 1]->numChaves > MIN_CHAVES) {
+        redistribuirEsquerda(pai, i);
+    } else if (i < pai->numChaves && pai->filhos[i + 1]->numChaves > MIN_CHAVES) {
+        redistribuirDireita(pai, i);
+    } else if (i < pai->numChaves) {
+        fundirFilhos(pai, i);
+    } else {
+        fundirFilhos(pai, i - 1);
+        i--;
+    }
+    return i;
+}
+
+// Remover sem mensagens; *encontrada indica se a chave estava na árvore.
+// A descida deixa cada nó visitado com chaves de sobra, então a remoção na
+// folha nunca precisa voltar para corrigir os ancestrais.
+No234* removerDaArvore(No234 *raiz, int chave, bool *encontrada) {
+    *encontrada = false;
+    if (raiz == NULL) return NULL;
+
+    No234 *atual = raiz;
+    while (true) {
+        int filho = encontrarFilho(atual, chave);
+        bool nesteNo = filho > 0 && atual->chaves[filho - 1] == chave;
+
+        if (atual->ehFolha) {
+            if (nesteNo) {
+                for (int j = filho - 1; j < atual->numChaves - 1; j++) {
+                    atual->chaves[j] = atual->chaves[j + 1];
+                }
+                atual->numChaves--;
+                *encontrada = true;
+            }
+            break;
+        }
+
+        if (nesteNo) {
+            int posicao = filho - 1;
+            No234 *esquerdo = atual->filhos[posicao];
+            No234 *direito = atual->filhos[posicao + 1];
+
+            if (esquerdo->numChaves > MIN_CHAVES) {
+                // Trocar pela predecessora e continuar removendo-a à esquerda
+                No234 *no = esquerdo;
+                while (!no->ehFolha) no = no->filhos[no->numChaves];
+                chave = no->chaves[no->numChaves - 1];
+                atual->chaves[posicao] = chave;
+                atual = esquerdo;
+            } else if (direito->numChaves > MIN_CHAVES) {
+                // Trocar pela sucessora e continuar removendo-a à direita
+                No234 *no = direito;
+                while (!no->ehFolha) no = no->filhos[0];
+                chave = no->chaves[0];
+                atual->chaves[posicao] = chave;
+                atual = direito;
+            } else {
+                // Os dois lados no mínimo: fundir e continuar no nó fundido
+                fundirFilhos(atual, posicao);
+                atual = esquerdo;
+            }
+        } else {
+            atual = atual->filhos[garantirFilho(atual, filho)];
+        }
+    }
+
+    // Raiz sem chaves: a árvore diminui um nível (ou fica vazia)
+    if (raiz->numChaves == 0) {
+        No234 *antiga = raiz;
+        raiz = raiz->ehFolha ? NULL : raiz->filhos[0];
+        free(antiga);
+    }
+    return raiz;
+}
+
+// Função principal de remoção
+No234* removerChave(No234 *raiz, int chave) {
+    if (raiz == NULL) {
+        printf("Árvore vazia!\n");
+        return NULL;
+    }
+
+    bool encontrada;
+    raiz = removerDaArvore(raiz, chave, &encontrada);
+    if (!encontrada) {
+        printf("Chave %d não encontrada.\n", chave);
+    }
+    return raiz;
+}
+
+// ===================== FUNÇÕES DE EXIBIÇÃO =====================
+
+// Percorrer em ordem (crescente)
+void emOrdem(No234 *no) {
+    if (no == NULL) return;
+
+    for (int i = 0; i < no->numChaves; i++) {
+        if (!no->ehFolha) emOrdem(no->filhos[i]);
+        printf("%d ", no->chaves[i]);
+    }
+    if (!no->ehFolha) emOrdem(no->filhos[no->numChaves]);
+}
+
+// Encontrar altura da árvore
+int altura(No234 *no) {
+    if (no == NULL) return 0;
+    if (no->ehFolha) return 1;
+    return 1 + altura(no->filhos[0]);
+}
+
+// Imprimir por nível (BFS), um nível de cada vez: o vetor do próximo nível é
+// alocado com o tamanho exato, contado a partir do nível atual
+void imprimirPorNivel(No234 *raiz) {
+    if (raiz == NULL) return;
+
+    int tamanhoNivel = 1;
+    No234 **nivel = (No234**)malloc(sizeof(No234*));
+    if (nivel == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    nivel[0] = raiz;
+
+    while (tamanhoNivel > 0) {
+        // Tamanho do próximo nível (todas as folhas estão no mesmo nível)
+        int tamanhoProximo = 0;
+        if (!nivel[0]->ehFolha) {
+            for (int i = 0; i < tamanhoNivel; i++) {
+                tamanhoProximo += nivel[i]->numChaves + 1;
+            }
+        }
+        No234 **proximo = NULL;
+        if (tamanhoProximo > 0) {
+            proximo = (No234**)malloc(sizeof(No234*) * tamanhoProximo);
+            if (proximo == NULL) {
+                printf("Erro: Falha na alocação de memória!\n");
+                free(nivel);
+                return;
+            }
+        }
+
+        int filhos = 0;
+        for (int i = 0; i < tamanhoNivel; i++) {
+            No234 *atual = nivel[i];
+
+            // Imprimir nó
+            printf("[");
+            for (int j = 0; j < atual->numChaves; j++) {
+                printf("%d", atual->chaves[j]);
+                if (j < atual->numChaves - 1) printf(", ");
+            }
+            printf("] ");
+
+            // Juntar os filhos no próximo nível
+            if (!atual->ehFolha) {
+                for (int j = 0; j <= atual->numChaves; j++) {
+                    proximo[filhos++] = atual->filhos[j];
+                }
+            }
+        }
+        printf("\n");
+
+        free(nivel);
+        nivel = proximo;
+        tamanhoNivel = tamanhoProximo;
+    }
+}
+
+// ===================== MEDIÇÃO DE DESEMPENHO =====================
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Segundos decorridos desde o instante inicio
+double segundosDesde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Medir inserção, busca e remoção de n valores aleatórios
+// (mesmos valores e mesma ordem da medição de arvore23.c e arvoreRN.c)
+void medirDesempenho(int n) {
+    int *valores = (int*)malloc(sizeof(int) * n);
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        valores[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+
+    No234 *raiz = NULL;
+    bool ok;
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        raiz = inserirChave(raiz, valores[i], &ok);
+    }
+    double tempoInsercao = segundosDesde(inicio);
+    int h = altura(raiz);
+
+    int encontrados = 0, posicao;
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        encontrados += buscar(raiz, valores[i], &posicao) != NULL;
+    }
+    double tempoBusca = segundosDesde(inicio);
+
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        raiz = removerDaArvore(raiz, valores[i], &ok);
+    }
+    double tempoRemocao = segundosDesde(inicio);
+
+    printf("Ordem %d (%d chaves por nó, nó de %zu bytes), altura %d\n",
+           ORDEM, MAX_CHAVES, sizeof(No234), h);
+    printf("Inserção: %.3f s (%.1f ns/op)\n", tempoInsercao, tempoInsercao * 1e9 / n);
+    printf("Busca:    %.3f s (%.1f ns/op, %d encontrados)\n", tempoBusca, tempoBusca * 1e9 / n, encontrados);
+    printf("Remoção:  %.3f s (%.1f ns/op)\n", tempoRemocao, tempoRemocao * 1e9 / n);
+
+    free(valores);
+}
+
+// ===================== FUNÇÕES DE MENU E MAIN =====================
+
+// Liberar memória da árvore
+void liberarArvore(No234 *no) {
+    if (no == NULL) return;
+
+    if (!no->ehFolha) {
+        for (int i = 0; i <= no->numChaves; i++) {
+            liberarArvore(no->filhos[i]);
+        }
+    }
+
+    free(no);
+}
+
+// Exibir menu principal
+void exibirMenuPrincipal() {
+    if (ORDEM == 4) {
+        printf("\n=== ÁRVORE 2-3-4 ===\n");
+    } else {
+        printf("\n=== ÁRVORE B DESCENDENTE (ORDEM %d) ===\n", ORDEM);
+    }
+    printf("1 - Inserir valor\n");
+    printf("2 - Buscar valor\n");
+    printf("3 - Remover valor\n");
+    printf("4 - Percorrer árvore\n");
+    printf("5 - Medir desempenho\n");
+    printf("6 - Latências das operações do menu\n");
+    printf("0 - Sair\n");
+    printf("Escolha uma opção: ");
+}
+
+// Exibir submenu de percursos
+void exibirSubmenuPercursos() {
+    printf("\n--- TIPOS DE PERCURSO ---\n");
+    printf("1 - Em ordem (crescente)\n");
+    printf("2 - Por nível (estrutura)\n");
+    printf("Escolha o tipo de percurso: ");
+}
+
+// Função principal
+int main() {
+    Arvore234 arvore;
+    inicializarArvore(&arvore);
+
+    int opcao, subOpcao, valor;
+    unsigned long long antes;
+
+    // Latências das operações do menu (opção 6, e o relatório ao sair)
+    static LatenciasMenu latencias;
+
+    do {
+        exibirMenuPrincipal();
+        scanf("%d", &opcao);
+
+        switch (opcao) {
+            case 1:
+                printf("Digite o valor a ser inserido: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                arvore.raiz = inserir(arvore.raiz, valor);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                printf("Valor %d inserido.\n", valor);
+                break;
+
+            case 2:
+                printf("Digite o valor a ser buscado: ");
+                scanf("%d", &valor);
+                int posicao;
+                antes = histogramaAgora();
+                No234 *encontrado = buscar(arvore.raiz, valor, &posicao);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
+                if (encontrado != NULL) {
+                    printf("Valor %d encontrado na árvore.\n", valor);
+                } else {
+                    printf("Valor %d não encontrado na árvore.\n", valor);
+                }
+                break;
+
+            case 3:
+                printf("Digite o valor a ser removido: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                arvore.raiz = removerChave(arvore.raiz, valor);
+                latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                printf("Valor %d removido.\n", valor);
+                break;
+
+            case 4:
+                if (arvoreVazia(&arvore)) {
+                    printf("Árvore vazia!\n");
+                } else {
+                    exibirSubmenuPercursos();
+                    scanf("%d", &subOpcao);
+
+                    antes = histogramaAgora();
+                    switch (subOpcao) {
+                        case 1:
+                            printf("Percorrendo em ordem: ");
+                            emOrdem(arvore.raiz);
+                            printf("\n");
+                            break;
+                        case 2:
+                            printf("Percorrendo por nível:\n");
+                            imprimirPorNivel(arvore.raiz);
+                            break;
+                        default:
+                            printf("Opção inválida!\n");
+                    }
+                    if (subOpcao == 1 || subOpcao == 2) {
+                        latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    }
+                }
+                break;
+
+            case 5:
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                if (valor > 0) {
+                    medirDesempenho(valor);
+                }
+                break;
+
+            case 6:
+                latenciasImprimir(&latencias);
+                break;
+
+            case 0:
+                printf("Encerrando programa...\n");
+                break;
+
+            default:
+                printf("Opção inválida! Tente novamente.\n");
+        }
+
+    } while (opcao != 0);
+
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+
+    // Liberar memória
+    liberarArvore(arvore.raiz);
+    printf("Memória liberada. Programa encerrado.\n");
+
+    return 0;
+}
@@ -0,0 +1,1002 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "histograma.h"
+
+// Árvore B guardada em disco. Cada nó ocupa uma página de tamanho fixo de um
+// único arquivo e os filhos são referenciados pelo número da página. Um pool
+// de buffers limitado mantém as páginas mais usadas na memória, com descarte
+// LRU, e grava as páginas sujas em lotes ordenados pelo número da página.
+//
+// Inserção e remoção são descendentes, como em arvore234.c: não há ponteiro
+// para o pai, então cada página só precisa estar fixada na memória enquanto a
+// descida passa por ela (no máximo quatro ao mesmo tempo).
+//
+// A página 0 é o cabeçalho do arquivo; por isso o número 0 também serve como
+// "nenhuma página". Os deslocamentos usam long: no Windows o arquivo fica
+// limitado a 2 GB (524288 páginas).
+//
+// Compilar com: gcc arvoreBDisco.c -o arvoreBDisco
+
+#define TAMANHO_PAGINA 4096
+
+// Maior ordem par cujo nó cabe numa página (510 para páginas de 4 KB)
+#ifndef ORDEM
+#define ORDEM 510
+#endif
+
+#if ORDEM < 4 || ORDEM % 2 != 0
+#error "ORDEM deve ser par e pelo menos 4"
+#endif
+
+#define MAX_CHAVES (ORDEM - 1)      // Máximo de chaves por nó
+#define MIN_CHAVES (ORDEM / 2 - 1)  // Mínimo de chaves (exceto a raiz)
+#define MIN_QUADROS 8               // Páginas fixadas ao mesmo tempo + folga
+#define LOTE_ESCRITA 32             // Máximo de páginas sujas gravadas por lote
+#define MAGIA 0x42444953u           // Identifica o arquivo ("BDIS")
+
+// ===================== ESTRUTURAS DE DADOS =====================
+
+// Nó da árvore, exatamente como fica gravado na página
+typedef struct {
+    int numChaves;              // Quantidade de chaves (-1 numa página livre)
+    int ehFolha;                // Indica se é folha
+    int chaves[MAX_CHAVES];     // Chaves em ordem crescente
+    uint32_t filhos[ORDEM];     // Páginas dos filhos (numa página livre,
+                                // filhos[0] é a próxima página livre)
+} NoPagina;
+
+_Static_assert(sizeof(NoPagina) <= TAMANHO_PAGINA, "O nó não cabe numa página");
+
+// Cabeçalho do arquivo (página 0)
+typedef struct {
+    uint32_t magia;
+    uint32_t ordem;             // ORDEM com que o arquivo foi criado
+    uint32_t raiz;              // Página da raiz (0 = árvore vazia)
+    uint32_t numPaginas;        // Páginas no arquivo, incluindo o cabeçalho
+    uint32_t livre;             // Primeira página da lista de livres (0 = nenhuma)
+} Cabecalho;
+
+// Quadro do pool: uma página carregada na memória
+typedef struct {
+    uint32_t idPagina;          // Página carregada (0 = quadro vazio)
+    int fixacoes;               // Quantos usos em andamento (não pode sair)
+    bool sujo;                  // Alterado desde a última gravação
+    int anterior, proximo;      // Lista LRU (mais recente no início)
+    int proximoNoBalde;         // Encadeamento da tabela de dispersão
+} Quadro;
+
+// Pool de buffers com descarte LRU
+typedef struct {
+    Quadro *quadros;
+    unsigned char *dados;       // numQuadros páginas contíguas
+    int numQuadros;
+    int quadrosUsados;          // Quadros já ocupados alguma vez
+    int *baldes;                // Tabela de dispersão: página -> quadro
+    int numBaldes;              // Potência de 2
+    int maisRecente, menosRecente;
+
+    // Estatísticas
+    long long acertos;          // Página já estava no pool
+    long long faltas;           // Página precisou ser lida (ou criada)
+    long long leituras;         // Páginas lidas do arquivo
+    long long escritas;         // Páginas gravadas no arquivo
+    long long lotes;            // Lotes de gravação
+} PoolBuffer;
+
+// Árvore B em disco
+typedef struct {
+    FILE *arquivo;
+    Cabecalho cab;
+    PoolBuffer pool;
+} ArvoreDisco;
+
+// ===================== ARQUIVO =====================
+
+// Ler uma página do arquivo
+void lerPagina(ArvoreDisco *arvore, uint32_t id, void *destino) {
+    fseek(arvore->arquivo, (long)id * TAMANHO_PAGINA, SEEK_SET);
+    if (fread(destino, TAMANHO_PAGINA, 1, arvore->arquivo) != 1) {
+        printf("Erro: Falha ao ler a página %u!\n", id);
+        exit(1);
+    }
+    arvore->pool.leituras++;
+}
+
+// Gravar uma página no arquivo
+void escreverPagina(ArvoreDisco *arvore, uint32_t id, const void *origem) {
+    fseek(arvore->arquivo, (long)id * TAMANHO_PAGINA, SEEK_SET);
+    if (fwrite(origem, TAMANHO_PAGINA, 1, arvore->arquivo) != 1) {
+        printf("Erro: Falha ao gravar a página %u!\n", id);
+        exit(1);
+    }
+    arvore->pool.escritas++;
+}
+
+// Gravar o cabeçalho na página 0
+void escreverCabecalho(ArvoreDisco *arvore) {
+    unsigned char pagina[TAMANHO_PAGINA];
+    memset(pagina, 0, sizeof(pagina));
+    memcpy(pagina, &arvore->cab, sizeof(Cabecalho));
+    escreverPagina(arvore, 0, pagina);
+}
+
+// ===================== POOL DE BUFFERS =====================
+
+// Dados da página carregada num quadro
+NoPagina* paginaDoQuadro(PoolBuffer *pool, int q) {
+    return (NoPagina*)(pool->dados + (size_t)q * TAMANHO_PAGINA);
+}
+
+// Quadro de uma página já devolvida por fixarPagina
+int quadroDaPagina(PoolBuffer *pool, NoPagina *no) {
+    return (int)(((unsigned char*)no - pool->dados) / TAMANHO_PAGINA);
+}
+
+// Balde da tabela de dispersão para uma página
+int baldeDe(PoolBuffer *pool, uint32_t id) {
+    return (int)((id * 2654435761u) & (uint32_t)(pool->numBaldes - 1));
+}
+
+// Procurar o quadro de uma página (-1 se não estiver no pool)
+int procurarQuadro(PoolBuffer *pool, uint32_t id) {
+    int q = pool->baldes[baldeDe(pool, id)];
+    while (q != -1 && pool->quadros[q].idPagina != id) {
+        q = pool->quadros[q].proximoNoBalde;
+    }
+    return q;
+}
+
+// Retirar um quadro da tabela de dispersão
+void retirarDaTabela(PoolBuffer *pool, int q) {
+    int *ligacao = &pool->baldes[baldeDe(pool, pool->quadros[q].idPagina)];
+    while (*ligacao != q) {
+        ligacao = &pool->quadros[*ligacao].proximoNoBalde;
+    }
+    *ligacao = pool->quadros[q].proximoNoBalde;
+}
+
+// Retirar um quadro da lista LRU
+void retirarDaLista(PoolBuffer *pool, int q) {
+    Quadro *quadro = &pool->quadros[q];
+    if (quadro->anterior != -1) pool->quadros[quadro->anterior].proximo = quadro->proximo;
+    else pool->maisRecente = quadro->proximo;
+    if (quadro->proximo != -1) pool->quadros[quadro->proximo].anterior = quadro->anterior;
+    else pool->menosRecente = quadro->anterior;
+}
+
+// Colocar um quadro no início da lista LRU (usado agora)
+void colocarNoInicio(PoolBuffer *pool, int q) {
+    pool->quadros[q].anterior = -1;
+    pool->quadros[q].proximo = pool->maisRecente;
+    if (pool->maisRecente != -1) pool->quadros[pool->maisRecente].anterior = q;
+    pool->maisRecente = q;
+    if (pool->menosRecente == -1) pool->menosRecente = q;
+}
+
+// Comparar quadros pelo número da página (para gravar em ordem no arquivo)
+int compararPaginas(const void *a, const void *b) {
+    uint32_t x = ((const uint32_t*)a)[0], y = ((const uint32_t*)b)[0];
+    return (x > y) - (x < y);
+}
+
+// Gravar, ordenados pelo número da página, os quadros sujos indicados
+void gravarQuadros(ArvoreDisco *arvore, uint32_t (*lote)[2], int tamanho) {
+    PoolBuffer *pool = &arvore->pool;
+
+    qsort(lote, tamanho, sizeof(lote[0]), compararPaginas);
+    for (int i = 0; i < tamanho; i++) {
+        escreverPagina(arvore, lote[i][0], paginaDoQuadro(pool, (int)lote[i][1]));
+        pool->quadros[lote[i][1]].sujo = false;
+    }
+    pool->lotes++;
+}
+
+// Antes de descartar uma página suja, gravar junto as outras páginas sujas e
+// livres perto do fim da lista LRU (as próximas a serem descartadas)
+void gravarLote(ArvoreDisco *arvore, int vitima) {
+    PoolBuffer *pool = &arvore->pool;
+    uint32_t lote[LOTE_ESCRITA][2];
+    int tamanho = 0;
+
+    lote[tamanho][0] = pool->quadros[vitima].idPagina;
+    lote[tamanho][1] = (uint32_t)vitima;
+    tamanho++;
+
+    int q = pool->menosRecente;
+    for (int vistos = 0; q != -1 && tamanho < LOTE_ESCRITA && vistos < 4 * LOTE_ESCRITA; vistos++) {
+        Quadro *quadro = &pool->quadros[q];
+        if (q != vitima && quadro->sujo && quadro->fixacoes == 0) {
+            lote[tamanho][0] = quadro->idPagina;
+            lote[tamanho][1] = (uint32_t)q;
+            tamanho++;
+        }
+        q = quadro->anterior;
+    }
+
+    gravarQuadros(arvore, lote, tamanho);
+}
+
+// Obter um quadro para uma nova página: um ainda não usado ou o menos
+// recentemente usado entre os que não estão fixados
+int obterQuadro(ArvoreDisco *arvore) {
+    PoolBuffer *pool = &arvore->pool;
+
+    if (pool->quadrosUsados < pool->numQuadros) {
+        return pool->quadrosUsados++;
+    }
+
+    int q = pool->menosRecente;
+    while (q != -1 && pool->quadros[q].fixacoes > 0) {
+        q = pool->quadros[q].anterior;
+    }
+    if (q == -1) {
+        printf("Erro: Todas as páginas do pool estão fixadas!\n");
+        exit(1);
+    }
+
+    if (pool->quadros[q].sujo) {
+        gravarLote(arvore, q);
+    }
+    retirarDaTabela(pool, q);
+    retirarDaLista(pool, q);
+    return q;
+}
+
+// Associar um quadro a uma página, fixado e no início da lista LRU
+void ocuparQuadro(PoolBuffer *pool, int q, uint32_t id) {
+    Quadro *quadro = &pool->quadros[q];
+    quadro->idPagina = id;
+    quadro->fixacoes = 1;
+    quadro->sujo = false;
+
+    int balde = baldeDe(pool, id);
+    quadro->proximoNoBalde = pool->baldes[balde];
+    pool->baldes[balde] = q;
+    colocarNoInicio(pool, q);
+}
+
+// Fixar uma página na memória (lendo do arquivo se preciso) e devolver o nó.
+// Toda fixação deve ser desfeita com soltarPagina.
+NoPagina* fixarPagina(ArvoreDisco *arvore, uint32_t id) {
+    PoolBuffer *pool = &arvore->pool;
+    int q = procurarQuadro(pool, id);
+
+    if (q != -1) {
+        pool->acertos++;
+        pool->quadros[q].fixacoes++;
+        if (pool->maisRecente != q) {
+            retirarDaLista(pool, q);
+            colocarNoInicio(pool, q);
+        }
+        return paginaDoQuadro(pool, q);
+    }
+
+    pool->faltas++;
+    q = obterQuadro(arvore);
+    lerPagina(arvore, id, paginaDoQuadro(pool, q));
+    ocuparQuadro(pool, q, id);
+    return paginaDoQuadro(pool, q);
+}
+
+// Marcar a página como alterada (será gravada antes de sair do pool)
+void marcarSuja(ArvoreDisco *arvore, NoPagina *no) {
+    arvore->pool.quadros[quadroDaPagina(&arvore->pool, no)].sujo = true;
+}
+
+// Desfazer uma fixação; sujo indica se a página foi alterada
+void soltarPagina(ArvoreDisco *arvore, NoPagina *no, bool sujo) {
+    Quadro *quadro = &arvore->pool.quadros[quadroDaPagina(&arvore->pool, no)];
+    quadro->fixacoes--;
+    if (sujo) quadro->sujo = true;
+}
+
+// Alocar uma página para um novo nó (da lista de livres ou no fim do
+// arquivo); devolve o nó vazio, fixado, e o número da página em *id
+NoPagina* alocarPagina(ArvoreDisco *arvore, bool ehFolha, uint32_t *id) {
+    NoPagina *no;
+
+    if (arvore->cab.livre != 0) {
+        *id = arvore->cab.livre;
+        no = fixarPagina(arvore, *id);
+        arvore->cab.livre = no->filhos[0];
+    } else {
+        // Página nova: não há nada para ler
+        *id = arvore->cab.numPaginas++;
+        int q = obterQuadro(arvore);
+        ocuparQuadro(&arvore->pool, q, *id);
+        arvore->pool.faltas++;
+        no = paginaDoQuadro(&arvore->pool, q);
+    }
+
+    memset(no, 0, TAMANHO_PAGINA);
+    no->ehFolha = ehFolha;
+    marcarSuja(arvore, no);
+    return no;
+}
+
+// Devolver à lista de livres uma página que não está fixada
+void liberarPagina(ArvoreDisco *arvore, uint32_t id) {
+    NoPagina *no = fixarPagina(arvore, id);
+    no->numChaves = -1;
+    no->filhos[0] = arvore->cab.livre;
+    arvore->cab.livre = id;
+    soltarPagina(arvore, no, true);
+}
+
+// Gravar todas as páginas sujas e o cabeçalho
+void descarregarTudo(ArvoreDisco *arvore) {
+    PoolBuffer *pool = &arvore->pool;
+    uint32_t lote[LOTE_ESCRITA][2];
+    int tamanho = 0;
+
+    for (int q = 0; q < pool->quadrosUsados; q++) {
+        if (pool->quadros[q].sujo) {
+            lote[tamanho][0] = pool->quadros[q].idPagina;
+            lote[tamanho][1] = (uint32_t)q;
+            if (++tamanho == LOTE_ESCRITA) {
+                gravarQuadros(arvore, lote, tamanho);
+                tamanho = 0;
+            }
+        }
+    }
+    if (tamanho > 0) {
+        gravarQuadros(arvore, lote, tamanho);
+    }
+
+    escreverCabecalho(arvore);
+    fflush(arvore->arquivo);
+}
+
+// Zerar as estatísticas do pool
+void zerarEstatisticas(ArvoreDisco *arvore) {
+    PoolBuffer *pool = &arvore->pool;
+    pool->acertos = pool->faltas = pool->leituras = pool->escritas = pool->lotes = 0;
+}
+
+// Mostrar as estatísticas do pool
+void exibirEstatisticas(ArvoreDisco *arvore) {
+    PoolBuffer *pool = &arvore->pool;
+    long long acessos = pool->acertos + pool->faltas;
+
+    printf("Pool: %d quadros (%d em uso), arquivo com %u páginas\n",
+           pool->numQuadros, pool->quadrosUsados, arvore->cab.numPaginas);
+    printf("Acessos: %lld, acertos: %lld (%.2f%%), faltas: %lld\n", acessos, pool->acertos,
+           acessos > 0 ? 100.0 * pool->acertos / acessos : 0.0, pool->faltas);
+    printf("Páginas lidas: %lld, gravadas: %lld em %lld lotes\n",
+           pool->leituras, pool->escritas, pool->lotes);
+}
+
+// ===================== ABRIR E FECHAR =====================
+
+// Abrir (ou criar) o arquivo da árvore com um pool de numQuadros páginas
+bool abrirArvore(ArvoreDisco *arvore, const char *nome, int numQuadros) {
+    if (numQuadros < MIN_QUADROS) numQuadros = MIN_QUADROS;
+
+    arvore->arquivo = fopen(nome, "r+b");
+    bool novo = arvore->arquivo == NULL;
+    if (novo) {
+        arvore->arquivo = fopen(nome, "w+b");
+        if (arvore->arquivo == NULL) {
+            printf("Erro: Não foi possível abrir %s!\n", nome);
+            return false;
+        }
+    }
+
+    // Pool vazio
+    PoolBuffer *pool = &arvore->pool;
+    memset(pool, 0, sizeof(PoolBuffer));
+    pool->numQuadros = numQuadros;
+    pool->numBaldes = 1;
+    while (pool->numBaldes < 2 * numQuadros) pool->numBaldes <<= 1;
+    pool->quadros = (Quadro*)calloc(numQuadros, sizeof(Quadro));
+    pool->dados = (unsigned char*)malloc((size_t)numQuadros * TAMANHO_PAGINA);
+    pool->baldes = (int*)malloc(sizeof(int) * pool->numBaldes);
+    if (pool->quadros == NULL || pool->dados == NULL || pool->baldes == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        exit(1);
+    }
+    for (int i = 0; i < pool->numBaldes; i++) pool->baldes[i] = -1;
+    pool->maisRecente = pool->menosRecente = -1;
+
+    if (novo) {
+        arvore->cab.magia = MAGIA;
+        arvore->cab.ordem = ORDEM;
+        arvore->cab.raiz = 0;
+        arvore->cab.numPaginas = 1;
+        arvore->cab.livre = 0;
+        escreverCabecalho(arvore);
+    } else {
+        unsigned char pagina[TAMANHO_PAGINA];
+        lerPagina(arvore, 0, pagina);
+        memcpy(&arvore->cab, pagina, sizeof(Cabecalho));
+        if (arvore->cab.magia != MAGIA || arvore->cab.ordem != ORDEM) {
+            printf("Erro: %s não é uma árvore de ordem %d!\n", nome, ORDEM);
+            fclose(arvore->arquivo);
+            free(pool->quadros);
+            free(pool->dados);
+            free(pool->baldes);
+            return false;
+        }
+    }
+
+    zerarEstatisticas(arvore);
+    return true;
+}
+
+// Gravar tudo e fechar o arquivo
+void fecharArvore(ArvoreDisco *arvore) {
+    descarregarTudo(arvore);
+    fclose(arvore->arquivo);
+    free(arvore->pool.quadros);
+    free(arvore->pool.dados);
+    free(arvore->pool.baldes);
+}
+
+// ===================== FUNÇÕES AUXILIARES =====================
+
+// Encontrar o filho apropriado para uma chave: quantas chaves do nó são
+// menores ou iguais a ela. Com centenas de chaves por página, busca binária.
+int encontrarFilho(NoPagina *no, int chave) {
+    int base = 0, n = no->numChaves;
+    while (n > 0) {
+        int metade = n / 2;
+        if (no->chaves[base + metade] <= chave) {
+            base += metade + 1;
+            n -= metade + 1;
+        } else {
+            n = metade;
+        }
+    }
+    return base;
+}
+
+// ===================== FUNÇÃO DE BUSCA =====================
+
+// Buscar uma chave na árvore
+bool buscar(ArvoreDisco *arvore, int chave) {
+    uint32_t id = arvore->cab.raiz;
+
+    while (id != 0) {
+        NoPagina *no = fixarPagina(arvore, id);
+        int filho = encontrarFilho(no, chave);
+        bool achou = filho > 0 && no->chaves[filho - 1] == chave;
+
+        id = (achou || no->ehFolha) ? 0 : no->filhos[filho];
+        soltarPagina(arvore, no, false);
+        if (achou) return true;
+    }
+    return false;
+}
+
+// ===================== FUNÇÕES DE INSERÇÃO =====================
+
+// Dividir o filho cheio de índice i (pai e filho fixados pelo chamador)
+void dividirFilho(ArvoreDisco *arvore, NoPagina *pai, int i, NoPagina *filho) {
+    uint32_t idNovo;
+    NoPagina *novoNo = alocarPagina(arvore, filho->ehFolha, &idNovo);
+
+    // Metade direita para o novo nó
+    novoNo->numChaves = MIN_CHAVES;
+    memcpy(novoNo->chaves, &filho->chaves[MIN_CHAVES + 1], sizeof(int) * MIN_CHAVES);
+    if (!filho->ehFolha) {
+        memcpy(novoNo->filhos, &filho->filhos[MIN_CHAVES + 1], sizeof(uint32_t) * (MIN_CHAVES + 1));
+    }
+    filho->numChaves = MIN_CHAVES;
+
+    // Abrir espaço no pai para a chave do meio e o novo filho
+    for (int j = pai->numChaves; j > i; j--) {
+        pai->chaves[j] = pai->chaves[j - 1];
+        pai->filhos[j + 1] = pai->filhos[j];
+    }
+    pai->chaves[i] = filho->chaves[MIN_CHAVES];
+    pai->filhos[i + 1] = idNovo;
+    pai->numChaves++;
+
+    marcarSuja(arvore, pai);
+    marcarSuja(arvore, filho);
+    soltarPagina(arvore, novoNo, true);
+}
+
+// Inserir uma chave; retorna false se ela já existia
+bool inserirChave(ArvoreDisco *arvore, int chave) {
+    // Caso especial: árvore vazia
+    if (arvore->cab.raiz == 0) {
+        NoPagina *raiz = alocarPagina(arvore, true, &arvore->cab.raiz);
+        raiz->chaves[0] = chave;
+        raiz->numChaves = 1;
+        soltarPagina(arvore, raiz, true);
+        return true;
+    }
+
+    // Raiz cheia: dividi-la agora é o único jeito de a árvore crescer
+    NoPagina *atual = fixarPagina(arvore, arvore->cab.raiz);
+    if (atual->numChaves == MAX_CHAVES) {
+        uint32_t idRaiz;
+        NoPagina *novaRaiz = alocarPagina(arvore, false, &idRaiz);
+        novaRaiz->filhos[0] = arvore->cab.raiz;
+        dividirFilho(arvore, novaRaiz, 0, atual);
+        soltarPagina(arvore, atual, true);
+        arvore->cab.raiz = idRaiz;
+        atual = novaRaiz;
+    }
+
+    // Descer dividindo todo filho cheio antes de entrar nele
+    while (true) {
+        int filho = encontrarFilho(atual, chave);
+        if (filho > 0 && atual->chaves[filho - 1] == chave) {
+            soltarPagina(arvore, atual, false);
+            return false;
+        }
+
+        if (atual->ehFolha) {
+            for (int j = atual->numChaves; j > filho; j--) {
+                atual->chaves[j] = atual->chaves[j - 1];
+            }
+            atual->chaves[filho] = chave;
+            atual->numChaves++;
+            soltarPagina(arvore, atual, true);
+            return true;
+        }
+
+        NoPagina *proximo = fixarPagina(arvore, atual->filhos[filho]);
+        if (proximo->numChaves == MAX_CHAVES) {
+            dividirFilho(arvore, atual, filho, proximo);
+
+            // A chave que subiu pode ser a procurada ou mudar o lado
+            if (atual->chaves[filho] == chave) {
+                soltarPagina(arvore, proximo, false);
+                soltarPagina(arvore, atual, false);
+                return false;
+            }
+            if (chave > atual->chaves[filho]) {
+                soltarPagina(arvore, proximo, false);
+                proximo = fixarPagina(arvore, atual->filhos[filho + 1]);
+            }
+        }
+        soltarPagina(arvore, atual, false);
+        atual = proximo;
+    }
+}
+
+// ===================== FUNÇÕES DE REMOÇÃO =====================
+
+// O nó recebe a maior chave do irmão à esquerda (rotação pelo pai, chave i - 1)
+void redistribuirEsquerda(ArvoreDisco *arvore, NoPagina *pai, int i, NoPagina *no, NoPagina *irmao) {
+    memmove(&no->chaves[1], &no->chaves[0], sizeof(int) * no->numChaves);
+    if (!no->ehFolha) {
+        memmove(&no->filhos[1], &no->filhos[0], sizeof(uint32_t) * (no->numChaves + 1));
+        no->filhos[0] = irmao->filhos[irmao->numChaves];
+    }
+    no->chaves[0] = pai->chaves[i - 1];
+    no->numChaves++;
+    pai->chaves[i - 1] = irmao->chaves[irmao->numChaves - 1];
+    irmao->numChaves--;
+
+    marcarSuja(arvore, pai);
+    marcarSuja(arvore, no);
+    marcarSuja(arvore, irmao);
+}
+
+// O nó recebe a menor chave do irmão à direita (rotação pelo pai, chave i)
+void redistribuirDireita(ArvoreDisco *arvore, NoPagina *pai, int i, NoPagina *no, NoPagina *irmao) {
+    no->chaves[no->numChaves] = pai->chaves[i];
+    if (!no->ehFolha) {
+        no->filhos[no->numChaves + 1] = irmao->filhos[0];
+        memmove(&irmao->filhos[0], &irmao->filhos[1], sizeof(uint32_t) * irmao->numChaves);
+    }
+    no->numChaves++;
+    pai->chaves[i] = irmao->chaves[0];
+    memmove(&irmao->chaves[0], &irmao->chaves[1], sizeof(int) * (irmao->numChaves - 1));
+    irmao->numChaves--;
+
+    marcarSuja(arvore, pai);
+    marcarSuja(arvore, no);
+    marcarSuja(arvore, irmao);
+}
+
+// Fundir o filho i + 1 (direito) no filho i (esquerdo), com a chave i do pai
+// entre eles; a página do direito é solta e devolvida à lista de livres
+void fundirFilhos(ArvoreDisco *arvore, NoPagina *pai, int i, NoPagina *esquerdo, NoPagina *direito) {
+    uint32_t idDireito = pai->filhos[i + 1];
+
+    esquerdo->chaves[esquerdo->numChaves] = pai->chaves[i];
+    memcpy(&esquerdo->chaves[esquerdo->numChaves + 1], direito->chaves, sizeof(int) * direito->numChaves);
+    if (!esquerdo->ehFolha) {
+        memcpy(&esquerdo->filhos[esquerdo->numChaves + 1], direito->filhos,
+               sizeof(uint32_t) * (direito->numChaves + 1));
+    }
+    esquerdo->numChaves += direito->numChaves + 1;
+
+    memmove(&pai->chaves[i], &pai->chaves[i + 1], sizeof(int) * (pai->numChaves - i - 1));
+    memmove(&pai->filhos[i + 1], &pai->filhos[i + 2], sizeof(uint32_t) * (pai->numChaves - i - 1));
+    pai->numChaves--;
+
+    marcarSuja(arvore, pai);
+    marcarSuja(arvore, esquerdo);
+    soltarPagina(arvore, direito, false);
+    liberarPagina(arvore, idDireito);
+}
+
+// Garantir que o filho i tenha mais que o mínimo antes de descer nele; retorna
+// o índice do filho por onde continuar (muda se fundir com o irmão esquerdo)
+int garantirFilho(ArvoreDisco *arvore, NoPagina *pai, int i) {
+    NoPagina *no = fixarPagina(arvore, pai->filhos[i]);
+    if (no->numChaves > MIN_CHAVES) {
+        soltarPagina(arvore, no, false);
+        return i;
+    }
+
+    if (i > 0) {
+        NoPagina *esquerdo = fixarPagina(arvore, pai->filhos[i - 1]);
+        if (esquerdo->numChaves > MIN_CHAVES) {
+            redistribuirEsquerda(arvore, pai, i, no, esquerdo);
+            soltarPagina(arvore, esquerdo, false);
+            soltarPagina(arvore, no, false);
+            return i;
+        }
+        if (i == pai->numChaves) {
+            // Último filho: fundir com o irmão esquerdo
+            fundirFilhos(arvore, pai, i - 1, esquerdo, no);
+            soltarPagina(arvore, esquerdo, false);
+            return i - 1;
+        }
+        soltarPagina(arvore, esquerdo, false);
+    }
+
+    NoPagina *direito = fixarPagina(arvore, pai->filhos[i + 1]);
+    if (direito->numChaves > MIN_CHAVES) {
+        redistribuirDireita(arvore, pai, i, no, direito);
+        soltarPagina(arvore, direito, false);
+    } else {
+        fundirFilhos(arvore, pai, i, no, direito);
+    }
+    soltarPagina(arvore, no, false);
+    return i;
+}
+
+// Maior chave da subárvore (desce pelo último filho)
+int maiorChave(ArvoreDisco *arvore, uint32_t id) {
+    while (true) {
+        NoPagina *no = fixarPagina(arvore, id);
+        bool folha = no->ehFolha;
+        int chave = no->chaves[no->numChaves - 1];
+        id = no->filhos[no->numChaves];
+        soltarPagina(arvore, no, false);
+        if (folha) return chave;
+    }
+}
+
+// Menor chave da subárvore (desce pelo primeiro filho)
+int menorChave(ArvoreDisco *arvore, uint32_t id) {
+    while (true) {
+        NoPagina *no = fixarPagina(arvore, id);
+        bool folha = no->ehFolha;
+        int chave = no->chaves[0];
+        id = no->filhos[0];
+        soltarPagina(arvore, no, false);
+        if (folha) return chave;
+    }
+}
+
+// Remover uma chave em uma única descida; retorna false se ela não existia
+bool removerChave(ArvoreDisco *arvore, int chave) {
+    if (arvore->cab.raiz == 0) return false;
+
+    bool encontrada = false;
+    NoPagina *atual = fixarPagina(arvore, arvore->cab.raiz);
+
+    while (true) {
+        int filho = encontrarFilho(atual, chave);
+        bool nesteNo = filho > 0 && atual->chaves[filho - 1] == chave;
+
+        if (atual->ehFolha) {
+            if (nesteNo) {
+                memmove(&atual->chaves[filho - 1], &atual->chaves[filho],
+                        sizeof(int) * (atual->numChaves - filho));
+                atual->numChaves--;
+                encontrada = true;
+            }
+            soltarPagina(arvore, atual, nesteNo);
+            break;
+        }
+
+        int proximoFilho;
+        if (nesteNo) {
+            int posicao = filho - 1;
+            NoPagina *esquerdo = fixarPagina(arvore, atual->filhos[posicao]);
+            NoPagina *direito = fixarPagina(arvore, atual->filhos[posicao + 1]);
+
+            if (esquerdo->numChaves > MIN_CHAVES) {
+                // Trocar pela predecessora e continuar removendo-a à esquerda
+                chave = maiorChave(arvore, atual->filhos[posicao]);
+                atual->chaves[posicao] = chave;
+                proximoFilho = posicao;
+            } else if (direito->numChaves > MIN_CHAVES) {
+                // Trocar pela sucessora e continuar removendo-a à direita
+                chave = menorChave(arvore, atual->filhos[posicao + 1]);
+                atual->chaves[posicao] = chave;
+                proximoFilho = posicao + 1;
+            } else {
+                // Os dois lados no mínimo: fundir e continuar no nó fundido
+                fundirFilhos(arvore, atual, posicao, esquerdo, direito);
+                direito = NULL;
+                proximoFilho = posicao;
+            }
+            marcarSuja(arvore, atual);
+            soltarPagina(arvore, esquerdo, false);
+            if (direito != NULL) soltarPagina(arvore, direito, false);
+        } else {
+            proximoFilho = garantirFilho(arvore, atual, filho);
+        }
+
+        NoPagina *proximo = fixarPagina(arvore, atual->filhos[proximoFilho]);
+        soltarPagina(arvore, atual, false);
+        atual = proximo;
+    }
+
+    // Raiz sem chaves: a árvore diminui um nível (ou fica vazia)
+    NoPagina *raiz = fixarPagina(arvore, arvore->cab.raiz);
+    if (raiz->numChaves == 0) {
+        uint32_t antiga = arvore->cab.raiz;
+        arvore->cab.raiz = raiz->ehFolha ? 0 : raiz->filhos[0];
+        soltarPagina(arvore, raiz, false);
+        liberarPagina(arvore, antiga);
+    } else {
+        soltarPagina(arvore, raiz, false);
+    }
+    return encontrada;
+}
+
+// ===================== FUNÇÕES DE EXIBIÇÃO =====================
+
+// Percorrer em ordem (crescente)
+void emOrdem(ArvoreDisco *arvore, uint32_t id) {
+    if (id == 0) return;
+
+    // Copiar o nó: a recursão pode descartar a página do pool
+    NoPagina *no = fixarPagina(arvore, id);
+    NoPagina copia = *no;
+    soltarPagina(arvore, no, false);
+
+    for (int i = 0; i < copia.numChaves; i++) {
+        if (!copia.ehFolha) emOrdem(arvore, copia.filhos[i]);
+        printf("%d ", copia.chaves[i]);
+    }
+    if (!copia.ehFolha) emOrdem(arvore, copia.filhos[copia.numChaves]);
+}
+
+// Encontrar altura da árvore
+int altura(ArvoreDisco *arvore) {
+    int h = 0;
+    uint32_t id = arvore->cab.raiz;
+
+    while (id != 0) {
+        NoPagina *no = fixarPagina(arvore, id);
+        id = no->ehFolha ? 0 : no->filhos[0];
+        soltarPagina(arvore, no, false);
+        h++;
+    }
+    return h;
+}
+
+// ===================== MEDIÇÃO DE DESEMPENHO =====================
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Segundos decorridos desde o instante inicio
+double segundosDesde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Montar um arquivo com n chaves aleatórias e medir q buscas com um pool de
+// 1/razao do tamanho do arquivo (dados "razao vezes maiores que a memória")
+void medirPool(int n, int q, int razao) {
+    const char *nome = "arvoreBDisco_medicao.dat";
+    ArvoreDisco arvore;
+    remove(nome);
+
+    int *valores = (int*)malloc(sizeof(int) * n);
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        valores[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+
+    // Construção com um pool generoso
+    if (!abrirArvore(&arvore, nome, 4096)) {
+        free(valores);
+        return;
+    }
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        inserirChave(&arvore, valores[i]);
+    }
+    fecharArvore(&arvore);
+    printf("Construção: %d chaves em %.3f s\n", n, segundosDesde(inicio));
+    exibirEstatisticas(&arvore);
+
+    // Reabrir com o pool limitado
+    int quadros = (int)(arvore.cab.numPaginas / razao);
+    if (!abrirArvore(&arvore, nome, quadros)) {
+        free(valores);
+        return;
+    }
+    printf("\nBuscas com pool de %d quadros (arquivo %d vezes maior), altura %d\n",
+           arvore.pool.numQuadros, razao, altura(&arvore));
+
+    // Aquecer o pool com um terço das buscas, depois medir
+    for (int fase = 0; fase < 2; fase++) {
+        int consultas = fase == 0 ? q / 3 : q;
+        int encontrados = 0;
+
+        zerarEstatisticas(&arvore);
+        inicio = clock();
+        for (int i = 0; i < consultas; i++) {
+            encontrados += buscar(&arvore, valores[proximoAleatorio(&estado) % (unsigned int)n]);
+        }
+        if (fase == 0) continue;
+
+        double tempo = segundosDesde(inicio);
+        exibirEstatisticas(&arvore);
+        printf("%d buscas (%d encontradas) em %.3f s: %.3f páginas lidas por busca, %.3f por falta\n",
+               consultas, encontrados, tempo, (double)arvore.pool.leituras / consultas,
+               arvore.pool.faltas > 0 ? (double)arvore.pool.leituras / arvore.pool.faltas : 0.0);
+    }
+
+    fecharArvore(&arvore);
+    remove(nome);
+    free(valores);
+}
+
+// ===================== FUNÇÕES DE MENU E MAIN =====================
+
+// Exibir menu principal
+void exibirMenuPrincipal() {
+    printf("\n=== ÁRVORE B EM DISCO (ORDEM %d) ===\n", ORDEM);
+    printf("1 - Inserir valor\n");
+    printf("2 - Buscar valor\n");
+    printf("3 - Remover valor\n");
+    printf("4 - Percorrer em ordem\n");
+    printf("5 - Estatísticas do pool\n");
+    printf("6 - Gravar páginas sujas\n");
+    printf("7 - Medir pool com dados maiores que a memória\n");
+    printf("8 - Latências das operações do menu\n");
+    printf("0 - Sair\n");
+    printf("Escolha uma opção: ");
+}
+
+// Função principal
+int main() {
+    ArvoreDisco arvore;
+    char nome[256];
+    int quadros, opcao, valor, consultas, razao;
+    unsigned long long antes;
+    bool ok;
+
+    // Latências das operações do menu (opção 8, e o relatório ao sair); as
+    // leituras e gravações de páginas que a operação causar entram no tempo
+    static LatenciasMenu latencias;
+
+    printf("Arquivo da árvore: ");
+    scanf("%255s", nome);
+    printf("Páginas no pool (mínimo %d): ", MIN_QUADROS);
+    scanf("%d", &quadros);
+    if (!abrirArvore(&arvore, nome, quadros)) {
+        return 1;
+    }
+
+    do {
+        exibirMenuPrincipal();
+        scanf("%d", &opcao);
+
+        switch (opcao) {
+            case 1:
+                printf("Digite o valor a ser inserido: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                ok = inserirChave(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                if (ok) {
+                    printf("Valor %d inserido.\n", valor);
+                } else {
+                    printf("Chave %d já existe na árvore.\n", valor);
+                }
+                break;
+
+            case 2:
+                printf("Digite o valor a ser buscado: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                ok = buscar(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
+                if (ok) {
+                    printf("Valor %d encontrado na árvore.\n", valor);
+                } else {
+                    printf("Valor %d não encontrado na árvore.\n", valor);
+                }
+                break;
+
+            case 3:
+                printf("Digite o valor a ser removido: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                ok = removerChave(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                if (ok) {
+                    printf("Valor %d removido.\n", valor);
+                } else {
+                    printf("Chave %d não encontrada.\n", valor);
+                }
+                break;
+
+            case 4:
+                if (arvore.cab.raiz == 0) {
+                    printf("Árvore vazia!\n");
+                } else {
+                    printf("Percorrendo em ordem: ");
+                    antes = histogramaAgora();
+                    emOrdem(&arvore, arvore.cab.raiz);
+                    latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    printf("\n");
+                }
+                break;
+
+            case 5:
+                exibirEstatisticas(&arvore);
+                break;
+
+            case 6:
+                descarregarTudo(&arvore);
+                printf("Páginas gravadas.\n");
+                break;
+
+            case 7:
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                printf("Quantidade de buscas: ");
+                scanf("%d", &consultas);
+                printf("Arquivo quantas vezes maior que o pool: ");
+                scanf("%d", &razao);
+                if (valor > 0 && consultas > 0 && razao > 0) {
+                    medirPool(valor, consultas, razao);
+                }
+                break;
+
+            case 8:
+                latenciasImprimir(&latencias);
+                break;
+
+            case 0:
+                printf("Encerrando programa...\n");
+                break;
+
+            default:
+                printf("Opção inválida! Tente novamente.\n");
+        }
+
+    } while (opcao != 0);
+
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+
+    fecharArvore(&arvore);
+    printf("Páginas gravadas. Programa encerrado.\n");
+
+    return 0;
+}
@@ -0,0 +1,926 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include "histograma.h"
+
+// Árvore B+: todas as chaves ficam nas folhas, os nós internos guardam só
+// separadores e as folhas formam uma lista duplamente encadeada. Depois de uma
+// descida O(log n), uma varredura de intervalo é só um passeio pelas folhas.
+// A ordem segue a convenção de arvore23.c (número máximo de filhos).
+// Compilar com: gcc arvoreBMais.c -o arvoreBMais -DORDEM=16
+#ifndef ORDEM
+#define ORDEM 16
+#endif
+
+#if ORDEM < 3
+#error "ORDEM deve ser pelo menos 3"
+#endif
+
+#define MAX_CHAVES (ORDEM - 1)              // Máximo de chaves por nó
+#define MIN_CHAVES ((ORDEM + 1) / 2 - 1)    // Mínimo de chaves (exceto a raiz)
+
+// ===================== ESTRUTURAS DE DADOS =====================
+
+// Estrutura de um nó da Árvore B+
+typedef struct NoBMais {
+    int chaves[ORDEM];              // Chaves (folha) ou separadores (interno), +1 posição temporária
+    int numChaves;                  // Quantidade atual de chaves
+    bool ehFolha;                   // Indica se é folha
+    struct NoBMais *filhos[ORDEM + 1]; // Filhos (só nós internos), +1 posição temporária
+    struct NoBMais *pai;            // Ponteiro para o pai
+    struct NoBMais *proxima;        // Próxima folha (só folhas)
+    struct NoBMais *anterior;       // Folha anterior (só folhas)
+} NoBMais;
+
+// Estrutura da Árvore B+
+typedef struct {
+    NoBMais *raiz;
+} ArvoreBMais;
+
+// ===================== FUNÇÕES AUXILIARES =====================
+
+// Criar um novo nó vazio
+NoBMais* criarNo(bool ehFolha, NoBMais *pai) {
+    NoBMais *novoNo = (NoBMais*)malloc(sizeof(NoBMais));
+    if (novoNo == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        exit(1);
+    }
+
+    novoNo->numChaves = 0;
+    novoNo->ehFolha = ehFolha;
+    novoNo->pai = pai;
+    novoNo->proxima = NULL;
+    novoNo->anterior = NULL;
+
+    // Inicializar chaves e filhos (encontrarFilho lê todas as posições)
+    for (int i = 0; i < ORDEM; i++) {
+        novoNo->chaves[i] = 0;
+    }
+    for (int i = 0; i <= ORDEM; i++) {
+        novoNo->filhos[i] = NULL;
+    }
+
+    return novoNo;
+}
+
+// Inicializar árvore
+void inicializarArvore(ArvoreBMais *arvore) {
+    arvore->raiz = NULL;
+}
+
+// Verificar se árvore está vazia
+int arvoreVazia(ArvoreBMais *arvore) {
+    return arvore->raiz == NULL;
+}
+
+// Quantas chaves do nó são menores ou iguais à chave (laço sem desvios, como
+// em arvore23.c). Num nó interno é o índice do filho a seguir.
+int encontrarFilho(NoBMais *no, int chave) {
+    int filho = 0;
+    for (int i = 0; i < ORDEM; i++) {
+        filho += (i < no->numChaves) & (no->chaves[i] <= chave);
+    }
+    return filho;
+}
+
+// Quantas chaves do nó são menores que a chave (primeira posição >= chave)
+int contarMenores(NoBMais *no, int chave) {
+    int posicao = 0;
+    for (int i = 0; i < ORDEM; i++) {
+        posicao += (i < no->numChaves) & (no->chaves[i] < chave);
+    }
+    return posicao;
+}
+
+// Índice de um filho dentro do pai
+int indiceNoPai(NoBMais *no) {
+    NoBMais *pai = no->pai;
+    int indice = 0;
+    while (pai->filhos[indice] != no) indice++;
+    return indice;
+}
+
+// Inserir chave (e o filho à sua direita) na posição indicada, deslocando o resto
+void inserirNaPosicao(NoBMais *no, int posicao, int chave, NoBMais *filhoDireito) {
+    for (int i = no->numChaves; i > posicao; i--) {
+        no->chaves[i] = no->chaves[i - 1];
+        no->filhos[i + 1] = no->filhos[i];
+    }
+    no->chaves[posicao] = chave;
+    no->filhos[posicao + 1] = filhoDireito;
+    no->numChaves++;
+}
+
+// Remover a chave da posição indicada e o filho à sua direita
+void removerDaPosicao(NoBMais *no, int posicao) {
+    for (int i = posicao; i < no->numChaves - 1; i++) {
+        no->chaves[i] = no->chaves[i + 1];
+        no->filhos[i + 1] = no->filhos[i + 2];
+    }
+    no->filhos[no->numChaves] = NULL;
+    no->numChaves--;
+}
+
+// ===================== FUNÇÕES DE BUSCA =====================
+
+// Descer até a folha que deveria conter a chave
+NoBMais* encontrarFolha(NoBMais *raiz, int chave) {
+    if (raiz == NULL) return NULL;
+
+    while (!raiz->ehFolha) {
+        raiz = raiz->filhos[encontrarFilho(raiz, chave)];
+    }
+    return raiz;
+}
+
+// Buscar uma chave na árvore (sempre termina numa folha)
+NoBMais* buscar(NoBMais *raiz, int chave, int *posicao) {
+    NoBMais *folha = encontrarFolha(raiz, chave);
+    if (folha == NULL) return NULL;
+
+    int filho = encontrarFilho(folha, chave);
+    if (filho > 0 && folha->chaves[filho - 1] == chave) {
+        *posicao = filho - 1;
+        return folha;
+    }
+    return NULL;
+}
+
+// Primeira posição com chave >= inicio; retorna a folha (NULL se não houver)
+NoBMais* limiteInferior(NoBMais *raiz, int inicio, int *posicao) {
+    NoBMais *folha = encontrarFolha(raiz, inicio);
+    if (folha == NULL) return NULL;
+
+    *posicao = contarMenores(folha, inicio);
+
+    // Todas as chaves da folha são menores: a resposta está na próxima
+    if (*posicao == folha->numChaves) {
+        folha = folha->proxima;
+        *posicao = 0;
+    }
+    return folha;
+}
+
+// Última posição com chave <= fim; retorna a folha (NULL se não houver)
+NoBMais* limiteSuperior(NoBMais *raiz, int fim, int *posicao) {
+    NoBMais *folha = encontrarFolha(raiz, fim);
+    if (folha == NULL) return NULL;
+
+    *posicao = encontrarFilho(folha, fim) - 1;
+
+    // Todas as chaves da folha são maiores: a resposta está na anterior
+    if (*posicao < 0) {
+        folha = folha->anterior;
+        if (folha != NULL) *posicao = folha->numChaves - 1;
+    }
+    return folha;
+}
+
+// ===================== FUNÇÕES DE INSERÇÃO =====================
+
+// Dividir um nó com MAX_CHAVES + 1 chaves (split)
+NoBMais* dividirNo(NoBMais *no, int *chavePromovida) {
+    int meio = no->numChaves / 2;
+    NoBMais *novoNo = criarNo(no->ehFolha, no->pai);
+
+    if (no->ehFolha) {
+        // Folha: a metade direita inteira vai para a nova folha e a primeira
+        // chave dela é copiada para o pai como separador
+        for (int i = meio; i < no->numChaves; i++) {
+            novoNo->chaves[novoNo->numChaves++] = no->chaves[i];
+        }
+        *chavePromovida = novoNo->chaves[0];
+        no->numChaves = meio;
+
+        // Encadear a nova folha logo depois da original
+        novoNo->proxima = no->proxima;
+        novoNo->anterior = no;
+        if (no->proxima != NULL) no->proxima->anterior = novoNo;
+        no->proxima = novoNo;
+    } else {
+        // Nó interno: a chave do meio sobe e não fica em nenhum dos lados
+        *chavePromovida = no->chaves[meio];
+        for (int i = meio + 1; i < no->numChaves; i++) {
+            novoNo->chaves[novoNo->numChaves++] = no->chaves[i];
+        }
+        for (int i = meio + 1; i <= no->numChaves; i++) {
+            novoNo->filhos[i - meio - 1] = no->filhos[i];
+            no->filhos[i] = NULL;
+
+            // Atualizar pais dos filhos movidos
+            novoNo->filhos[i - meio - 1]->pai = novoNo;
+        }
+        no->numChaves = meio;
+    }
+
+    return novoNo;
+}
+
+// Inserir chave promovida no pai do nó dividido
+void inserirEmPai(NoBMais *no, int chavePromovida, NoBMais *novoNo) {
+    NoBMais *pai = no->pai;
+
+    if (pai == NULL) {
+        // Criar nova raiz
+        NoBMais *novaRaiz = criarNo(false, NULL);
+        novaRaiz->chaves[0] = chavePromovida;
+        novaRaiz->numChaves = 1;
+        novaRaiz->filhos[0] = no;
+        novaRaiz->filhos[1] = novoNo;
+
+        // Atualizar pais
+        no->pai = novaRaiz;
+        novoNo->pai = novaRaiz;
+        return;
+    }
+
+    // Inserir separador e novo filho logo à direita do nó original
+    inserirNaPosicao(pai, indiceNoPai(no), chavePromovida, novoNo);
+
+    // Pai também está cheio, precisa dividir
+    if (pai->numChaves > MAX_CHAVES) {
+        int novaChavePromovida;
+        NoBMais *novoPai = dividirNo(pai, &novaChavePromovida);
+        inserirEmPai(pai, novaChavePromovida, novoPai);
+    }
+}
+
+// Inserir sem mensagens; *jaExiste indica se a chave já estava na árvore
+NoBMais* inserirChave(NoBMais *raiz, int chave, bool *jaExiste) {
+    *jaExiste = false;
+
+    // Caso especial: árvore vazia
+    if (raiz == NULL) {
+        NoBMais *novaRaiz = criarNo(true, NULL);
+        novaRaiz->chaves[0] = chave;
+        novaRaiz->numChaves = 1;
+        return novaRaiz;
+    }
+
+    // Encontrar a folha correta para inserção
+    NoBMais *folha = encontrarFolha(raiz, chave);
+    int posicao = encontrarFilho(folha, chave);
+
+    // Verificar se a chave já existe
+    if (posicao > 0 && folha->chaves[posicao - 1] == chave) {
+        *jaExiste = true;
+        return raiz;
+    }
+
+    // Inserir na folha
+    inserirNaPosicao(folha, posicao, chave, NULL);
+
+    // Folha estourou: dividir e copiar o separador para o pai
+    if (folha->numChaves > MAX_CHAVES) {
+        int chavePromovida;
+        NoBMais *novaFolha = dividirNo(folha, &chavePromovida);
+        inserirEmPai(folha, chavePromovida, novaFolha);
+
+        // Retornar a raiz (pode ter mudado)
+        while (raiz->pai != NULL) {
+            raiz = raiz->pai;
+        }
+    }
+    return raiz;
+}
+
+// Função principal de inserção
+NoBMais* inserir(NoBMais *raiz, int chave) {
+    bool jaExiste;
+    raiz = inserirChave(raiz, chave, &jaExiste);
+    if (jaExiste) {
+        printf("Chave %d já existe na árvore.\n", chave);
+    }
+    return raiz;
+}
+
+// ===================== FUNÇÕES DE REMOÇÃO =====================
+
+// Redistribuir chaves com irmão à esquerda (o irmão cede sua maior chave)
+void redistribuirEsquerda(NoBMais *no, NoBMais *irmao, NoBMais *pai, int indiceNo) {
+    // Abrir espaço no início do nó
+    for (int i = no->numChaves; i > 0; i--) {
+        no->chaves[i] = no->chaves[i - 1];
+    }
+
+    if (no->ehFolha) {
+        // Folha: a chave passa direto e o separador vira a nova primeira chave
+        no->chaves[0] = irmao->chaves[irmao->numChaves - 1];
+        pai->chaves[indiceNo - 1] = no->chaves[0];
+    } else {
+        // Interno: o separador desce e a maior chave do irmão sobe
+        for (int i = no->numChaves + 1; i > 0; i--) {
+            no->filhos[i] = no->filhos[i - 1];
+        }
+        no->chaves[0] = pai->chaves[indiceNo - 1];
+        pai->chaves[indiceNo - 1] = irmao->chaves[irmao->numChaves - 1];
+        no->filhos[0] = irmao->filhos[irmao->numChaves];
+        irmao->filhos[irmao->numChaves] = NULL;
+        no->filhos[0]->pai = no;
+    }
+    no->numChaves++;
+    irmao->numChaves--;
+}
+
+// Redistribuir chaves com irmão à direita (o irmão cede sua menor chave)
+void redistribuirDireita(NoBMais *no, NoBMais *irmao, NoBMais *pai, int indiceNo) {
+    if (no->ehFolha) {
+        // Folha: a chave passa direto e o separador vira a nova menor do irmão
+        no->chaves[no->numChaves] = irmao->chaves[0];
+        pai->chaves[indiceNo] = irmao->chaves[1];
+    } else {
+        // Interno: o separador desce e a menor chave do irmão sobe
+        no->chaves[no->numChaves] = pai->chaves[indiceNo];
+        pai->chaves[indiceNo] = irmao->chaves[0];
+        no->filhos[no->numChaves + 1] = irmao->filhos[0];
+        no->filhos[no->numChaves + 1]->pai = no;
+
+        // Deslocar filhos do irmão
+        for (int i = 0; i < irmao->numChaves; i++) {
+            irmao->filhos[i] = irmao->filhos[i + 1];
+        }
+        irmao->filhos[irmao->numChaves] = NULL;
+    }
+    no->numChaves++;
+
+    // Rearranjar chaves do irmão
+    for (int i = 0; i < irmao->numChaves - 1; i++) {
+        irmao->chaves[i] = irmao->chaves[i + 1];
+    }
+    irmao->numChaves--;
+}
+
+// Fundir nó com irmão à esquerda (o nó é liberado)
+void fundirEsquerda(NoBMais *no, NoBMais *irmao, NoBMais *pai, int indiceNo) {
+    if (no->ehFolha) {
+        // Folha: o separador só some; retirar o nó da lista de folhas
+        irmao->proxima = no->proxima;
+        if (no->proxima != NULL) no->proxima->anterior = irmao;
+    } else {
+        // Interno: o separador desce entre as chaves dos dois nós
+        irmao->chaves[irmao->numChaves] = pai->chaves[indiceNo - 1];
+        irmao->numChaves++;
+        for (int i = 0; i <= no->numChaves; i++) {
+            irmao->filhos[irmao->numChaves + i] = no->filhos[i];
+            irmao->filhos[irmao->numChaves + i]->pai = irmao;
+        }
+    }
+
+    // Mover chaves do nó para o irmão
+    for (int i = 0; i < no->numChaves; i++) {
+        irmao->chaves[irmao->numChaves++] = no->chaves[i];
+    }
+
+    // Remover separador do pai
+    removerDaPosicao(pai, indiceNo - 1);
+
+    free(no);
+}
+
+// Ajustar árvore após remoção; retorna a raiz (pode ter mudado)
+NoBMais* ajustarAposRemocao(NoBMais *raiz, NoBMais *no) {
+    while (no->numChaves < MIN_CHAVES || no->numChaves == 0) {
+        // Se é a raiz e está vazia
+        if (no->pai == NULL) {
+            if (no->numChaves > 0) break;
+
+            // A raiz atual vira o filho (ou a árvore fica vazia)
+            raiz = no->ehFolha ? NULL : no->filhos[0];
+            if (raiz != NULL) raiz->pai = NULL;
+            free(no);
+            break;
+        }
+
+        NoBMais *pai = no->pai;
+        int indiceNo = indiceNoPai(no);
+
+        // Tentar redistribuição com irmão esquerdo
+        if (indiceNo > 0 && pai->filhos[indiceNo - 1]->numChaves > MIN_CHAVES) {
+            redistribuirEsquerda(no, pai->filhos[indiceNo - 1], pai, indiceNo);
+            break;
+        }
+
+        // Tentar redistribuição com irmão direito
+        if (indiceNo < pai->numChaves && pai->filhos[indiceNo + 1]->numChaves > MIN_CHAVES) {
+            redistribuirDireita(no, pai->filhos[indiceNo + 1], pai, indiceNo);
+            break;
+        }
+
+        // Se não pode redistribuir, fundir
+        if (indiceNo > 0) {
+            fundirEsquerda(no, pai->filhos[indiceNo - 1], pai, indiceNo);
+        } else {
+            fundirEsquerda(pai->filhos[1], no, pai, 1);
+        }
+
+        // Ajustar o pai
+        no = pai;
+    }
+    return raiz;
+}
+
+// Remover a chave da posição indicada de uma folha (já encontrada pela busca).
+// Os separadores dos nós internos não precisam mudar: continuam dividindo as
+// chaves corretamente mesmo que a chave igual a eles tenha saído.
+NoBMais* removerDaFolha(NoBMais *raiz, NoBMais *folha, int posicao) {
+    removerDaPosicao(folha, posicao);
+    return ajustarAposRemocao(raiz, folha);
+}
+
+// Função principal de remoção
+NoBMais* removerChave(NoBMais *raiz, int chave) {
+    if (raiz == NULL) {
+        printf("Árvore vazia!\n");
+        return NULL;
+    }
+
+    int posicao;
+    NoBMais *folha = buscar(raiz, chave, &posicao);
+
+    if (folha == NULL) {
+        printf("Chave %d não encontrada.\n", chave);
+        return raiz;
+    }
+
+    return removerDaFolha(raiz, folha, posicao);
+}
+
+// ===================== VARREDURA DE INTERVALOS =====================
+
+// Percorrer [inicio, fim] em ordem crescente pelas folhas; retorna quantas
+// chaves havia. Se imprimir for falso, apenas acumula a soma em *soma.
+int percorrerIntervalo(NoBMais *raiz, int inicio, int fim, bool imprimir, long long *soma) {
+    int posicao, quantidade = 0;
+    NoBMais *folha = limiteInferior(raiz, inicio, &posicao);
+
+    while (folha != NULL) {
+        for (; posicao < folha->numChaves; posicao++) {
+            int chave = folha->chaves[posicao];
+            if (chave > fim) return quantidade;
+            if (imprimir) printf("%d ", chave);
+            *soma += chave;
+            quantidade++;
+        }
+        folha = folha->proxima;
+        posicao = 0;
+    }
+    return quantidade;
+}
+
+// Somar as chaves de [inicio, fim] (versão rápida de percorrerIntervalo).
+// Seguir só o ponteiro proxima encadeia as leituras: o endereço da próxima
+// folha só é conhecido quando a atual chega da memória. Aqui as folhas irmãs
+// são lidas pelo vetor de filhos do pai, cujos endereços já estão todos
+// disponíveis e podem ser pedidos juntos (prefetch); a lista encadeada só é
+// usada para passar ao primeiro filho do próximo pai.
+int somarIntervalo(NoBMais *raiz, int inicio, int fim, long long *soma) {
+    int posicao, quantidade = 0;
+    long long total = 0;
+    NoBMais *folha = limiteInferior(raiz, inicio, &posicao);
+
+    while (folha != NULL) {
+        NoBMais **irmas = &folha;
+        int numIrmas = 1;
+        if (folha->pai != NULL) {
+            int indice = indiceNoPai(folha);
+            irmas = &folha->pai->filhos[indice];
+            numIrmas = folha->pai->numChaves + 1 - indice;
+        }
+        for (int i = 1; i < numIrmas; i++) {
+            __builtin_prefetch(irmas[i]);
+        }
+
+        for (int i = 0; i < numIrmas; i++) {
+            folha = irmas[i];
+            int n = folha->numChaves;
+
+            // Folha que passa do fim: somar até ele e parar
+            if (folha->chaves[n - 1] > fim) {
+                for (; posicao < n && folha->chaves[posicao] <= fim; posicao++) {
+                    total += folha->chaves[posicao];
+                    quantidade++;
+                }
+                *soma += total;
+                return quantidade;
+            }
+
+            // Folha inteira dentro do intervalo: laço sem testes por chave
+            quantidade += n - posicao;
+            for (; posicao < n; posicao++) {
+                total += folha->chaves[posicao];
+            }
+            posicao = 0;
+        }
+        folha = folha->proxima;
+    }
+    *soma += total;
+    return quantidade;
+}
+
+// Percorrer [inicio, fim] em ordem decrescente, voltando pelas folhas
+int percorrerIntervaloDecrescente(NoBMais *raiz, int inicio, int fim, bool imprimir, long long *soma) {
+    int posicao, quantidade = 0;
+    NoBMais *folha = limiteSuperior(raiz, fim, &posicao);
+
+    while (folha != NULL) {
+        for (; posicao >= 0; posicao--) {
+            int chave = folha->chaves[posicao];
+            if (chave < inicio) return quantidade;
+            if (imprimir) printf("%d ", chave);
+            *soma += chave;
+            quantidade++;
+        }
+        folha = folha->anterior;
+        if (folha != NULL) posicao = folha->numChaves - 1;
+    }
+    return quantidade;
+}
+
+// Percorrer [inicio, fim] recursivamente, descendo apenas nas subárvores que
+// podem conter chaves do intervalo (para comparação com as folhas encadeadas)
+int percorrerIntervaloRecursivo(NoBMais *no, int inicio, int fim, long long *soma) {
+    if (no == NULL) return 0;
+
+    int quantidade = 0;
+    if (no->ehFolha) {
+        for (int i = 0; i < no->numChaves; i++) {
+            if (no->chaves[i] >= inicio && no->chaves[i] <= fim) {
+                *soma += no->chaves[i];
+                quantidade++;
+            }
+        }
+        return quantidade;
+    }
+
+    // Filho i tem chaves em [chaves[i-1], chaves[i])
+    int primeiro = encontrarFilho(no, inicio);
+    int ultimo = encontrarFilho(no, fim);
+    for (int i = primeiro; i <= ultimo; i++) {
+        quantidade += percorrerIntervaloRecursivo(no->filhos[i], inicio, fim, soma);
+    }
+    return quantidade;
+}
+
+// ===================== FUNÇÕES DE EXIBIÇÃO =====================
+
+// Percorrer em ordem (crescente), recursivamente
+void emOrdem(NoBMais *no) {
+    if (no == NULL) return;
+
+    if (no->ehFolha) {
+        for (int i = 0; i < no->numChaves; i++) {
+            printf("%d ", no->chaves[i]);
+        }
+    } else {
+        for (int i = 0; i <= no->numChaves; i++) {
+            emOrdem(no->filhos[i]);
+        }
+    }
+}
+
+// Percorrer em ordem (crescente) pela lista de folhas
+void emOrdemPelasFolhas(NoBMais *raiz) {
+    if (raiz == NULL) return;
+
+    // A primeira folha é a mais à esquerda
+    NoBMais *folha = raiz;
+    while (!folha->ehFolha) {
+        folha = folha->filhos[0];
+    }
+
+    for (; folha != NULL; folha = folha->proxima) {
+        for (int i = 0; i < folha->numChaves; i++) {
+            printf("%d ", folha->chaves[i]);
+        }
+    }
+}
+
+// Encontrar altura da árvore
+int altura(NoBMais *no) {
+    if (no == NULL) return 0;
+    if (no->ehFolha) return 1;
+    return 1 + altura(no->filhos[0]);
+}
+
+// Imprimir por nível (BFS); folhas aparecem com | entre as chaves. Vai um
+// nível de cada vez: o vetor do próximo nível é alocado com o tamanho exato,
+// contado a partir do nível atual
+void imprimirPorNivel(NoBMais *raiz) {
+    if (raiz == NULL) return;
+
+    int tamanhoNivel = 1;
+    NoBMais **nivel = (NoBMais**)malloc(sizeof(NoBMais*));
+    if (nivel == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    nivel[0] = raiz;
+
+    while (tamanhoNivel > 0) {
+        // Tamanho do próximo nível (todas as folhas estão no mesmo nível)
+        int tamanhoProximo = 0;
+        if (!nivel[0]->ehFolha) {
+            for (int i = 0; i < tamanhoNivel; i++) {
+                tamanhoProximo += nivel[i]->numChaves + 1;
+            }
+        }
+        NoBMais **proximo = NULL;
+        if (tamanhoProximo > 0) {
+            proximo = (NoBMais**)malloc(sizeof(NoBMais*) * tamanhoProximo);
+            if (proximo == NULL) {
+                printf("Erro: Falha na alocação de memória!\n");
+                free(nivel);
+                return;
+            }
+        }
+
+        int filhos = 0;
+        for (int i = 0; i < tamanhoNivel; i++) {
+            NoBMais *atual = nivel[i];
+
+            // Imprimir nó
+            printf(atual->ehFolha ? "|" : "[");
+            for (int j = 0; j < atual->numChaves; j++) {
+                printf("%d", atual->chaves[j]);
+                if (j < atual->numChaves - 1) printf(", ");
+            }
+            printf(atual->ehFolha ? "| " : "] ");
+
+            // Juntar os filhos no próximo nível
+            if (!atual->ehFolha) {
+                for (int j = 0; j <= atual->numChaves; j++) {
+                    proximo[filhos++] = atual->filhos[j];
+                }
+            }
+        }
+        printf("\n");
+
+        free(nivel);
+        nivel = proximo;
+        tamanhoNivel = tamanhoProximo;
+    }
+}
+
+// Liberar memória da árvore
+void liberarArvore(NoBMais *no) {
+    if (no == NULL) return;
+
+    if (!no->ehFolha) {
+        for (int i = 0; i <= no->numChaves; i++) {
+            liberarArvore(no->filhos[i]);
+        }
+    }
+
+    free(no);
+}
+
+// ===================== MEDIÇÃO DE DESEMPENHO =====================
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Segundos decorridos desde o instante inicio
+double segundosDesde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Métodos de varredura comparados
+typedef enum { LISTA, FOLHAS_POR_PAI, RECURSAO } MetodoVarredura;
+
+// Executar as consultas de uma largura com um método; retorna o tempo gasto
+double medirConsultas(NoBMais *raiz, MetodoVarredura metodo, long long largura, int consultas,
+                      long long *total, long long *soma) {
+    unsigned int estado = 12345u;
+    clock_t inicio = clock();
+    for (int i = 0; i < consultas; i++) {
+        int a = (int)(proximoAleatorio(&estado) >> 1);
+        int b = (int)(a + largura - 1 > 0x7fffffff ? 0x7fffffff : a + largura - 1);
+
+        if (metodo == LISTA) {
+            *total += percorrerIntervalo(raiz, a, b, false, soma);
+        } else if (metodo == FOLHAS_POR_PAI) {
+            *total += somarIntervalo(raiz, a, b, soma);
+        } else {
+            *total += percorrerIntervaloRecursivo(raiz, a, b, soma);
+        }
+    }
+    double tempo = segundosDesde(inicio);
+
+    // Evitar divisão por zero abaixo da resolução do relógio
+    return tempo > 0 ? tempo : 1e-6;
+}
+
+// Comparar varreduras de intervalo pelas folhas encadeadas com a recursão em
+// ordem, em milhões de chaves por segundo, para q intervalos de cada largura
+void medirVarreduraArvore(NoBMais *raiz, int q) {
+    const char *nomes[] = { "lista", "folhas_por_pai", "recursao" };
+
+    printf("largura;chaves_por_consulta;%s_MChaves_s;%s_MChaves_s;%s_MChaves_s\n",
+           nomes[LISTA], nomes[FOLHAS_POR_PAI], nomes[RECURSAO]);
+
+    // Larguras: de ~1 chave por intervalo até a árvore inteira
+    for (long long largura = 1 << 11; largura <= (1LL << 31); largura <<= 4) {
+        int consultas = largura >= (1LL << 27) ? (q + 99) / 100 : q;
+        long long total[3] = { 0, 0, 0 }, soma[3] = { 0, 0, 0 };
+        double tempo[3];
+
+        for (int m = LISTA; m <= RECURSAO; m++) {
+            tempo[m] = medirConsultas(raiz, (MetodoVarredura)m, largura, consultas, &total[m], &soma[m]);
+        }
+
+        if (total[0] != total[1] || total[0] != total[2] || soma[0] != soma[1] || soma[0] != soma[2]) {
+            printf("Erro: resultados diferentes!\n");
+        }
+        printf("%lld;%.1f;%.1f;%.1f;%.1f\n", largura, (double)total[0] / consultas,
+               total[0] / tempo[0] / 1e6, total[1] / tempo[1] / 1e6, total[2] / tempo[2] / 1e6);
+    }
+}
+
+// Medir as varreduras numa árvore de n chaves inseridas em ordem aleatória
+// (folhas espalhadas pela memória) e em ordem crescente (folhas alocadas em
+// sequência, como depois de uma carga em lote)
+void medirVarredura(int n, int q) {
+    bool jaExiste;
+
+    for (int tipo = 0; tipo < 2; tipo++) {
+        NoBMais *raiz = NULL;
+        unsigned int estado = 2463534242u;
+
+        for (int i = 0; i < n; i++) {
+            int chave = tipo == 0 ? (int)(proximoAleatorio(&estado) >> 1)
+                                  : (int)((long long)i * 0x7fffffff / n);
+            raiz = inserirChave(raiz, chave, &jaExiste);
+        }
+
+        printf("\nInserção %s: ordem %d, altura %d, %d consultas por largura\n",
+               tipo == 0 ? "aleatória" : "crescente", ORDEM, altura(raiz), q);
+        medirVarreduraArvore(raiz, q);
+        liberarArvore(raiz);
+    }
+}
+
+// ===================== FUNÇÕES DE MENU E MAIN =====================
+
+// Exibir menu principal
+void exibirMenuPrincipal() {
+    printf("\n=== ÁRVORE B+ (ORDEM %d) ===\n", ORDEM);
+    printf("1 - Inserir valor\n");
+    printf("2 - Buscar valor\n");
+    printf("3 - Remover valor\n");
+    printf("4 - Percorrer árvore\n");
+    printf("5 - Listar intervalo (crescente)\n");
+    printf("6 - Listar intervalo (decrescente)\n");
+    printf("7 - Medir varredura de intervalos\n");
+    printf("8 - Latências das operações do menu\n");
+    printf("0 - Sair\n");
+    printf("Escolha uma opção: ");
+}
+
+// Exibir submenu de percursos
+void exibirSubmenuPercursos() {
+    printf("\n--- TIPOS DE PERCURSO ---\n");
+    printf("1 - Em ordem (recursivo)\n");
+    printf("2 - Em ordem (pelas folhas)\n");
+    printf("3 - Por nível (estrutura)\n");
+    printf("Escolha o tipo de percurso: ");
+}
+
+// Função principal
+int main() {
+    ArvoreBMais arvore;
+    inicializarArvore(&arvore);
+
+    int opcao, subOpcao, valor, fim;
+    long long soma;
+    unsigned long long antes;
+
+    // Latências das operações do menu (opção 8, e o relatório ao sair);
+    // a listagem de um intervalo conta como percurso
+    static LatenciasMenu latencias;
+
+    do {
+        exibirMenuPrincipal();
+        scanf("%d", &opcao);
+
+        switch (opcao) {
+            case 1:
+                printf("Digite o valor a ser inserido: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                arvore.raiz = inserir(arvore.raiz, valor);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                printf("Valor %d inserido.\n", valor);
+                break;
+
+            case 2:
+                printf("Digite o valor a ser buscado: ");
+                scanf("%d", &valor);
+                int posicao;
+                antes = histogramaAgora();
+                NoBMais *encontrado = buscar(arvore.raiz, valor, &posicao);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
+                if (encontrado != NULL) {
+                    printf("Valor %d encontrado na árvore.\n", valor);
+                } else {
+                    printf("Valor %d não encontrado na árvore.\n", valor);
+                }
+                break;
+
+            case 3:
+                printf("Digite o valor a ser removido: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                arvore.raiz = removerChave(arvore.raiz, valor);
+                latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                printf("Valor %d removido.\n", valor);
+                break;
+
+            case 4:
+                if (arvoreVazia(&arvore)) {
+                    printf("Árvore vazia!\n");
+                } else {
+                    exibirSubmenuPercursos();
+                    scanf("%d", &subOpcao);
+
+                    antes = histogramaAgora();
+                    switch (subOpcao) {
+                        case 1:
+                            printf("Percorrendo em ordem: ");
+                            emOrdem(arvore.raiz);
+                            printf("\n");
+                            break;
+                        case 2:
+                            printf("Percorrendo pelas folhas: ");
+                            emOrdemPelasFolhas(arvore.raiz);
+                            printf("\n");
+                            break;
+                        case 3:
+                            printf("Percorrendo por nível:\n");
+                            imprimirPorNivel(arvore.raiz);
+                            break;
+                        default:
+                            printf("Opção inválida!\n");
+                    }
+                    if (subOpcao >= 1 && subOpcao <= 3) {
+                        latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    }
+                }
+                break;
+
+            case 5:
+            case 6:
+                printf("Digite o início e o fim do intervalo: ");
+                scanf("%d %d", &valor, &fim);
+                soma = 0;
+                printf("Valores em [%d, %d]: ", valor, fim);
+                antes = histogramaAgora();
+                int quantidade = opcao == 5
+                    ? percorrerIntervalo(arvore.raiz, valor, fim, true, &soma)
+                    : percorrerIntervaloDecrescente(arvore.raiz, valor, fim, true, &soma);
+                latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                printf("\n%d valor(es).\n", quantidade);
+                break;
+
+            case 7:
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                printf("Consultas por largura: ");
+                scanf("%d", &fim);
+                if (valor > 0 && fim > 0) {
+                    medirVarredura(valor, fim);
+                }
+                break;
+
+            case 8:
+                latenciasImprimir(&latencias);
+                break;
+
+            case 0:
+                printf("Encerrando programa...\n");
+                break;
+
+            default:
+                printf("Opção inválida! Tente novamente.\n");
+        }
+
+    } while (opcao != 0);
+
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+
+    // Liberar memória
+    liberarArvore(arvore.raiz);
+    printf("Memória liberada. Programa encerrado.\n");
+
+    return 0;
+}
@@ -0,0 +1,686 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "histograma.h"
+
+// Cores para os nós da árvore
+typedef enum { VERMELHO, NEGRO } Cor;
+
+// Estrutura do nó da Árvore de Intervalos (Rubro-Negra ordenada pelo início)
+typedef struct No {
+    int inicio;      // Chave de ordenação
+    int fim;
+    int maxFim;      // Maior fim entre todos os intervalos da subárvore
+    Cor cor;
+    struct No *esquerda;
+    struct No *direita;
+    struct No *pai;
+} No;
+
+// Estrutura da Árvore de Intervalos
+typedef struct {
+    No *raiz;
+    No *nulo;  // Nó nulo (folhas)
+} ArvoreIntervalos;
+
+// Função para criar um nó nulo (todas as folhas são nulos)
+No* criarNoNulo(No *pai) {
+    No *no = (No*)malloc(sizeof(No));
+    no->inicio = 0;
+    no->fim = 0;
+    no->maxFim = 0;
+    no->cor = NEGRO;
+    no->esquerda = NULL;
+    no->direita = NULL;
+    no->pai = pai;
+    return no;
+}
+
+// Função para inicializar a árvore
+void inicializarArvore(ArvoreIntervalos *arvore) {
+    arvore->nulo = criarNoNulo(NULL);
+    arvore->raiz = arvore->nulo;
+}
+
+// Função para criar um novo nó
+No* criarNo(int inicio, int fim) {
+    No *novoNo = (No*)malloc(sizeof(No));
+    if (novoNo == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return NULL;
+    }
+    novoNo->inicio = inicio;
+    novoNo->fim = fim;
+    novoNo->maxFim = fim;
+    novoNo->cor = VERMELHO;  // Novo nó é sempre vermelho
+    novoNo->esquerda = NULL;
+    novoNo->direita = NULL;
+    novoNo->pai = NULL;
+    return novoNo;
+}
+
+// Função para verificar se a árvore está vazia
+int arvoreVazia(ArvoreIntervalos *arvore) {
+    return arvore->raiz == arvore->nulo;
+}
+
+// Comparar intervalos: pelo início e, em caso de empate, pelo fim
+int compararIntervalos(int inicioA, int fimA, int inicioB, int fimB) {
+    if (inicioA != inicioB) return inicioA < inicioB ? -1 : 1;
+    if (fimA != fimB) return fimA < fimB ? -1 : 1;
+    return 0;
+}
+
+// Recalcular o maior fim da subárvore de um nó a partir dos filhos
+void atualizarMaxFim(ArvoreIntervalos *arvore, No *no) {
+    if (no == arvore->nulo) return;
+
+    int maximo = no->fim;
+    if (no->esquerda != arvore->nulo && no->esquerda->maxFim > maximo) {
+        maximo = no->esquerda->maxFim;
+    }
+    if (no->direita != arvore->nulo && no->direita->maxFim > maximo) {
+        maximo = no->direita->maxFim;
+    }
+    no->maxFim = maximo;
+}
+
+// Recalcular o maior fim de um nó até a raiz
+void atualizarCaminho(ArvoreIntervalos *arvore, No *no) {
+    while (no != arvore->nulo) {
+        atualizarMaxFim(arvore, no);
+        no = no->pai;
+    }
+}
+
+// ROTAÇÕES
+
+// Rotação à esquerda
+void rotacaoEsquerda(ArvoreIntervalos *arvore, No *x) {
+    No *y = x->direita;
+    x->direita = y->esquerda;
+
+    if (y->esquerda != arvore->nulo) {
+        y->esquerda->pai = x;
+    }
+
+    y->pai = x->pai;
+
+    if (x->pai == arvore->nulo) {
+        arvore->raiz = y;
+    } else if (x == x->pai->esquerda) {
+        x->pai->esquerda = y;
+    } else {
+        x->pai->direita = y;
+    }
+
+    y->esquerda = x;
+    x->pai = y;
+
+    // x agora é filho de y: atualizar de baixo para cima
+    atualizarMaxFim(arvore, x);
+    atualizarMaxFim(arvore, y);
+}
+
+// Rotação à direita
+void rotacaoDireita(ArvoreIntervalos *arvore, No *y) {
+    No *x = y->esquerda;
+    y->esquerda = x->direita;
+
+    if (x->direita != arvore->nulo) {
+        x->direita->pai = y;
+    }
+
+    x->pai = y->pai;
+
+    if (y->pai == arvore->nulo) {
+        arvore->raiz = x;
+    } else if (y == y->pai->esquerda) {
+        y->pai->esquerda = x;
+    } else {
+        y->pai->direita = x;
+    }
+
+    x->direita = y;
+    y->pai = x;
+
+    // y agora é filho de x: atualizar de baixo para cima
+    atualizarMaxFim(arvore, y);
+    atualizarMaxFim(arvore, x);
+}
+
+// FUNÇÕES AUXILIARES
+
+// Encontrar o nó com menor início
+No* encontrarMinimo(ArvoreIntervalos *arvore, No *no) {
+    while (no->esquerda != arvore->nulo) {
+        no = no->esquerda;
+    }
+    return no;
+}
+
+// Buscar o nó com exatamente o intervalo [inicio, fim]
+No* buscarNo(ArvoreIntervalos *arvore, int inicio, int fim) {
+    No *no = arvore->raiz;
+
+    while (no != arvore->nulo) {
+        int comparacao = compararIntervalos(inicio, fim, no->inicio, no->fim);
+        if (comparacao == 0) return no;
+        no = comparacao < 0 ? no->esquerda : no->direita;
+    }
+    return no;
+}
+
+// CORREÇÃO DE INSERÇÃO
+
+// Corrigir violações após inserção (não altera maxFim além das rotações)
+void corrigirInsercao(ArvoreIntervalos *arvore, No *k) {
+    No *tio;
+
+    while (k->pai->cor == VERMELHO) {
+        // Caso: Pai é filho esquerdo do avô
+        if (k->pai == k->pai->pai->esquerda) {
+            tio = k->pai->pai->direita;
+
+            // CASO 1: Tio é vermelho
+            if (tio->cor == VERMELHO) {
+                k->pai->cor = NEGRO;
+                tio->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                k = k->pai->pai;
+            } else {
+                // CASO 2: k é filho direito
+                if (k == k->pai->direita) {
+                    k = k->pai;
+                    rotacaoEsquerda(arvore, k);
+                }
+
+                // CASO 3: k é filho esquerdo
+                k->pai->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                rotacaoDireita(arvore, k->pai->pai);
+            }
+        }
+        // Caso: Pai é filho direito do avô (simétrico)
+        else {
+            tio = k->pai->pai->esquerda;
+
+            // CASO 1: Tio é vermelho
+            if (tio->cor == VERMELHO) {
+                k->pai->cor = NEGRO;
+                tio->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                k = k->pai->pai;
+            } else {
+                // CASO 2: k é filho esquerdo
+                if (k == k->pai->esquerda) {
+                    k = k->pai;
+                    rotacaoDireita(arvore, k);
+                }
+
+                // CASO 3: k é filho direito
+                k->pai->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                rotacaoEsquerda(arvore, k->pai->pai);
+            }
+        }
+
+        if (k == arvore->raiz) {
+            break;
+        }
+    }
+
+    arvore->raiz->cor = NEGRO;  // Regra 2: raiz sempre negra
+}
+
+// INSERÇÃO
+
+// Inserir o intervalo [inicio, fim] sem exibir mensagens (retorna o novo nó)
+No* inserirNo(ArvoreIntervalos *arvore, int inicio, int fim) {
+    No *novoNo = criarNo(inicio, fim);
+    if (novoNo == NULL) return NULL;
+
+    novoNo->esquerda = arvore->nulo;
+    novoNo->direita = arvore->nulo;
+    novoNo->pai = arvore->nulo;
+
+    // Inserção como em BST normal, atualizando maxFim na descida
+    No *y = arvore->nulo;
+    No *x = arvore->raiz;
+
+    while (x != arvore->nulo) {
+        y = x;
+        if (fim > x->maxFim) {
+            x->maxFim = fim;  // O novo intervalo ficará nesta subárvore
+        }
+        if (compararIntervalos(inicio, fim, x->inicio, x->fim) < 0) {
+            x = x->esquerda;
+        } else {
+            x = x->direita;
+        }
+    }
+
+    novoNo->pai = y;
+
+    if (y == arvore->nulo) {
+        arvore->raiz = novoNo;
+    } else if (compararIntervalos(inicio, fim, y->inicio, y->fim) < 0) {
+        y->esquerda = novoNo;
+    } else {
+        y->direita = novoNo;
+    }
+
+    if (novoNo->pai == arvore->nulo) {
+        novoNo->cor = NEGRO;
+        return novoNo;
+    }
+
+    if (novoNo->pai->pai == arvore->nulo) {
+        return novoNo;
+    }
+
+    corrigirInsercao(arvore, novoNo);
+    return novoNo;
+}
+
+// CORREÇÃO DE REMOÇÃO
+
+// Corrigir violações após remoção
+void corrigirRemocao(ArvoreIntervalos *arvore, No *x) {
+    No *irmao;
+
+    while (x != arvore->raiz && x->cor == NEGRO) {
+        if (x == x->pai->esquerda) {
+            irmao = x->pai->direita;
+
+            // CASO 1: Irmão é vermelho
+            if (irmao->cor == VERMELHO) {
+                irmao->cor = NEGRO;
+                x->pai->cor = VERMELHO;
+                rotacaoEsquerda(arvore, x->pai);
+                irmao = x->pai->direita;
+            }
+
+            // CASO 2: Ambos os filhos do irmão são negros
+            if (irmao->esquerda->cor == NEGRO && irmao->direita->cor == NEGRO) {
+                irmao->cor = VERMELHO;
+                x = x->pai;
+            } else {
+                // CASO 3: Filho esquerdo do irmão é vermelho, direito é negro
+                if (irmao->direita->cor == NEGRO) {
+                    irmao->esquerda->cor = NEGRO;
+                    irmao->cor = VERMELHO;
+                    rotacaoDireita(arvore, irmao);
+                    irmao = x->pai->direita;
+                }
+
+                // CASO 4: Filho direito do irmão é vermelho
+                irmao->cor = x->pai->cor;
+                x->pai->cor = NEGRO;
+                irmao->direita->cor = NEGRO;
+                rotacaoEsquerda(arvore, x->pai);
+                x = arvore->raiz;
+            }
+        } else {
+            // Caso simétrico
+            irmao = x->pai->esquerda;
+
+            // CASO 1: Irmão é vermelho
+            if (irmao->cor == VERMELHO) {
+                irmao->cor = NEGRO;
+                x->pai->cor = VERMELHO;
+                rotacaoDireita(arvore, x->pai);
+                irmao = x->pai->esquerda;
+            }
+
+            // CASO 2: Ambos os filhos do irmão são negros
+            if (irmao->direita->cor == NEGRO && irmao->esquerda->cor == NEGRO) {
+                irmao->cor = VERMELHO;
+                x = x->pai;
+            } else {
+                // CASO 3: Filho direito do irmão é vermelho, esquerdo é negro
+                if (irmao->esquerda->cor == NEGRO) {
+                    irmao->direita->cor = NEGRO;
+                    irmao->cor = VERMELHO;
+                    rotacaoEsquerda(arvore, irmao);
+                    irmao = x->pai->esquerda;
+                }
+
+                // CASO 4: Filho esquerdo do irmão é vermelho
+                irmao->cor = x->pai->cor;
+                x->pai->cor = NEGRO;
+                irmao->esquerda->cor = NEGRO;
+                rotacaoDireita(arvore, x->pai);
+                x = arvore->raiz;
+            }
+        }
+    }
+
+    x->cor = NEGRO;
+}
+
+// Substituir um nó por outro na árvore
+void transplantar(ArvoreIntervalos *arvore, No *u, No *v) {
+    if (u->pai == arvore->nulo) {
+        arvore->raiz = v;
+    } else if (u == u->pai->esquerda) {
+        u->pai->esquerda = v;
+    } else {
+        u->pai->direita = v;
+    }
+    v->pai = u->pai;
+}
+
+// REMOÇÃO
+
+// Remover o intervalo [inicio, fim] da árvore
+int remover(ArvoreIntervalos *arvore, int inicio, int fim) {
+    No *z = buscarNo(arvore, inicio, fim);
+    if (z == arvore->nulo) {
+        return 0;  // Intervalo não encontrado
+    }
+
+    No *y = z;
+    No *x;
+    Cor corOriginalY = y->cor;
+
+    if (z->esquerda == arvore->nulo) {
+        x = z->direita;
+        transplantar(arvore, z, z->direita);
+    } else if (z->direita == arvore->nulo) {
+        x = z->esquerda;
+        transplantar(arvore, z, z->esquerda);
+    } else {
+        y = encontrarMinimo(arvore, z->direita);
+        corOriginalY = y->cor;
+        x = y->direita;
+
+        if (y->pai == z) {
+            x->pai = y;
+        } else {
+            transplantar(arvore, y, y->direita);
+            y->direita = z->direita;
+            y->direita->pai = y;
+        }
+
+        transplantar(arvore, z, y);
+        y->esquerda = z->esquerda;
+        y->esquerda->pai = y;
+        y->cor = z->cor;
+    }
+
+    // maxFim mudou apenas no caminho de x até a raiz
+    atualizarCaminho(arvore, x->pai);
+
+    free(z);
+
+    if (corOriginalY == NEGRO) {
+        corrigirRemocao(arvore, x);
+    }
+
+    return 1;  // Remoção bem-sucedida
+}
+
+// CONSULTAS DE SOBREPOSIÇÃO
+
+// Percorrer apenas as subárvores que podem conter intervalos que sobrepõem
+// [inicio, fim]; custo O(log n + k) para k intervalos encontrados
+int buscarSobreposicoes(ArvoreIntervalos *arvore, No *no, int inicio, int fim, int imprimir) {
+    if (no == arvore->nulo || no->maxFim < inicio) {
+        return 0;  // Nenhum intervalo desta subárvore termina depois de inicio
+    }
+
+    int encontrados = buscarSobreposicoes(arvore, no->esquerda, inicio, fim, imprimir);
+
+    // Intervalos à direita começam depois deste: se este já começa após fim, parar
+    if (no->inicio > fim) {
+        return encontrados;
+    }
+
+    if (no->fim >= inicio) {
+        if (imprimir) {
+            printf("[%d, %d] ", no->inicio, no->fim);
+        }
+        encontrados++;
+    }
+
+    return encontrados + buscarSobreposicoes(arvore, no->direita, inicio, fim, imprimir);
+}
+
+// Intervalos que contêm o ponto
+int buscarPonto(ArvoreIntervalos *arvore, int ponto, int imprimir) {
+    return buscarSobreposicoes(arvore, arvore->raiz, ponto, ponto, imprimir);
+}
+
+// PERCURSOS
+
+// Em ordem: Esquerda → Raiz → Direita
+void emOrdem(ArvoreIntervalos *arvore, No *no) {
+    if (no != arvore->nulo) {
+        emOrdem(arvore, no->esquerda);
+        printf("[%d, %d](%s, max %d) ", no->inicio, no->fim,
+               no->cor == VERMELHO ? "V" : "N", no->maxFim);
+        emOrdem(arvore, no->direita);
+    }
+}
+
+// MEDIÇÃO DE DESEMPENHO
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Segundos decorridos desde o instante inicio
+double segundosDesde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void liberarArvore(ArvoreIntervalos *arvore, No *no);
+
+// Comparar a árvore com a varredura linear de um vetor, para n intervalos
+// curtos e q consultas de sobreposição
+void medirDesempenho(int n, int q) {
+    ArvoreIntervalos teste;
+    inicializarArvore(&teste);
+
+    int *inicios = (int*)malloc(sizeof(int) * n);
+    int *fins = (int*)malloc(sizeof(int) * n);
+    if (inicios == NULL || fins == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(inicios);
+        free(fins);
+        return;
+    }
+
+    unsigned int estado = 2463534242u;
+    int limite = 100000000;
+    for (int i = 0; i < n; i++) {
+        inicios[i] = (int)(proximoAleatorio(&estado) % limite);
+        fins[i] = inicios[i] + (int)(proximoAleatorio(&estado) % 1000);
+    }
+
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        inserirNo(&teste, inicios[i], fins[i]);
+    }
+    double tempoInsercao = segundosDesde(inicio);
+
+    long totalArvore = 0;
+    inicio = clock();
+    for (int i = 0; i < q; i++) {
+        int a = (int)(proximoAleatorio(&estado) % limite);
+        totalArvore += buscarSobreposicoes(&teste, teste.raiz, a, a + 5000, 0);
+    }
+    double tempoArvore = segundosDesde(inicio);
+
+    long totalLinear = 0;
+    estado = 2463534242u;
+    for (int i = 0; i < 2 * n; i++) {
+        proximoAleatorio(&estado);  // Repetir as mesmas consultas
+    }
+    inicio = clock();
+    for (int i = 0; i < q; i++) {
+        int a = (int)(proximoAleatorio(&estado) % limite);
+        for (int j = 0; j < n; j++) {
+            if (inicios[j] <= a + 5000 && fins[j] >= a) totalLinear++;
+        }
+    }
+    double tempoLinear = segundosDesde(inicio);
+
+    printf("Inserção de %d intervalos: %.3f s (%.1f ns/op)\n", n, tempoInsercao, tempoInsercao * 1e9 / n);
+    printf("Árvore:    %d consultas em %.3f s (%.1f us/consulta, %ld resultados)\n",
+           q, tempoArvore, tempoArvore * 1e6 / q, totalArvore);
+    printf("Varredura: %d consultas em %.3f s (%.1f us/consulta, %ld resultados)\n",
+           q, tempoLinear, tempoLinear * 1e6 / q, totalLinear);
+
+    liberarArvore(&teste, teste.raiz);
+    free(teste.nulo);
+    free(inicios);
+    free(fins);
+}
+
+// FUNÇÕES AUXILIARES E MENU
+
+// Função para liberar toda a memória da árvore
+void liberarArvore(ArvoreIntervalos *arvore, No *no) {
+    if (no != arvore->nulo) {
+        liberarArvore(arvore, no->esquerda);
+        liberarArvore(arvore, no->direita);
+        free(no);
+    }
+}
+
+// Função para exibir o menu principal
+void exibirMenuPrincipal() {
+    printf("\n=== ÁRVORE DE INTERVALOS ===\n");
+    printf("1 - Inserir intervalo\n");
+    printf("2 - Intervalos que contêm um ponto\n");
+    printf("3 - Intervalos que sobrepõem um intervalo\n");
+    printf("4 - Remover intervalo\n");
+    printf("5 - Percorrer árvore\n");
+    printf("6 - Medir desempenho\n");
+    printf("7 - Latências das operações do menu\n");
+    printf("0 - Sair\n");
+    printf("Escolha uma opção: ");
+}
+
+// Ler um intervalo do teclado, garantindo inicio <= fim
+void lerIntervalo(int *inicio, int *fim) {
+    printf("Digite o início e o fim do intervalo: ");
+    scanf("%d %d", inicio, fim);
+    if (*inicio > *fim) {
+        int temp = *inicio;
+        *inicio = *fim;
+        *fim = temp;
+    }
+}
+
+// Função principal
+int main() {
+    ArvoreIntervalos arvore;
+    inicializarArvore(&arvore);
+
+    int opcao, inicio, fim, encontrados;
+    unsigned long long antes;
+
+    // Latências das operações do menu (opção 7, e o relatório ao sair); as
+    // consultas por ponto e por sobreposição contam como busca
+    static LatenciasMenu latencias;
+
+    do {
+        exibirMenuPrincipal();
+        scanf("%d", &opcao);
+
+        switch (opcao) {
+            case 1:
+                lerIntervalo(&inicio, &fim);
+                antes = histogramaAgora();
+                No *inserido = inserirNo(&arvore, inicio, fim);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                if (inserido != NULL) {
+                    printf("Intervalo [%d, %d] inserido.\n", inicio, fim);
+                }
+                break;
+
+            case 2:
+                printf("Digite o ponto: ");
+                scanf("%d", &inicio);
+                printf("Intervalos que contêm %d: ", inicio);
+                antes = histogramaAgora();
+                encontrados = buscarPonto(&arvore, inicio, 1);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
+                printf("\n%d intervalo(s) encontrado(s).\n", encontrados);
+                break;
+
+            case 3:
+                lerIntervalo(&inicio, &fim);
+                printf("Intervalos que sobrepõem [%d, %d]: ", inicio, fim);
+                antes = histogramaAgora();
+                encontrados = buscarSobreposicoes(&arvore, arvore.raiz, inicio, fim, 1);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
+                printf("\n%d intervalo(s) encontrado(s).\n", encontrados);
+                break;
+
+            case 4:
+                lerIntervalo(&inicio, &fim);
+                antes = histogramaAgora();
+                int removido = remover(&arvore, inicio, fim);
+                latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                if (removido) {
+                    printf("Intervalo [%d, %d] removido da árvore.\n", inicio, fim);
+                } else {
+                    printf("Intervalo [%d, %d] não encontrado na árvore.\n", inicio, fim);
+                }
+                break;
+
+            case 5:
+                if (arvoreVazia(&arvore)) {
+                    printf("Árvore vazia!\n");
+                } else {
+                    printf("Percorrendo em ordem: ");
+                    antes = histogramaAgora();
+                    emOrdem(&arvore, arvore.raiz);
+                    latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    printf("\n");
+                }
+                break;
+
+            case 6:
+                printf("Quantidade de intervalos e de consultas: ");
+                scanf("%d %d", &inicio, &fim);
+                if (inicio > 0 && fim > 0) {
+                    medirDesempenho(inicio, fim);
+                }
+                break;
+
+            case 7:
+                latenciasImprimir(&latencias);
+                break;
+
+            case 0:
+                printf("Encerrando programa...\n");
+                break;
+
+            default:
+                printf("Opção inválida! Tente novamente.\n");
+        }
+
+    } while (opcao != 0);
+
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+
+    // Liberar toda a memória alocada
+    liberarArvore(&arvore, arvore.raiz);
+    free(arvore.nulo);
+    printf("Memória liberada. Programa encerrado.\n");
+
+    return 0;
+}
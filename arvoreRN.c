@@ -1,5 +1,30 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "log.h"
+#include "conjunto.h"
+#include "contadores.h"
+#include "rastro.h"
+#include "servidor.h"
+#include "ordenacao.h"
+#include "histograma.h"
+
+// Compilar com: gcc arvoreRN.c -o arvoreRN -pthread
+// Com contadores de instrumentação: gcc -DCONTADORES=1 arvoreRN.c -o arvoreRN -pthread
+
+// Campo de tamanho da subárvore (estatísticas de ordem: k-ésimo menor, posição).
+// Compile com -DESTATISTICA_ORDEM=0 para medir a árvore sem esse aumento.
+#ifndef ESTATISTICA_ORDEM
+#define ESTATISTICA_ORDEM 1
+#endif
+
+#define INTERVALO_INSTANTANEO 100000  // Operações entre instantâneos do log
+#define MINIMO_PARALELO 16384         // Valores abaixo dos quais a carga paralela não cria threads
+
+// Como módulo (-DSEM_MAIN, ver conjunto.h) só a tabela conjuntoRN é usada de
+// fora: o menu, as medições e as partes da API que só o menu usa ficam de fora
+// (#ifndef SEM_MAIN)
 
 // Cores para os nós da árvore
 typedef enum { VERMELHO, NEGRO } Cor;
@@ -11,6 +36,9 @@ typedef struct No {
     struct No *esquerda;
     struct No *direita;
     struct No *pai;
+#if ESTATISTICA_ORDEM
+    int tamanho;  // Quantidade de nós na subárvore (nó nulo tem 0)
+#endif
 } No;
 
 // Estrutura da Árvore Rubro-Negra
@@ -19,47 +47,86 @@ typedef struct {
     No *nulo;  // Nó nulo (folhas)
 } ArvoreRN;
 
+// Contadores de instrumentação de todas as árvores do módulo (contadores.h);
+// o nó nulo de cada árvore não entra nas alocações
+static Contadores contadores;
+
 // Função para criar um nó nulo (todas as folhas são nulos)
-No* criarNoNulo(No *pai) {
+static No* criarNoNulo(No *pai) {
     No *no = (No*)malloc(sizeof(No));
     no->valor = 0;
     no->cor = NEGRO;
     no->esquerda = NULL;
     no->direita = NULL;
     no->pai = pai;
+#if ESTATISTICA_ORDEM
+    no->tamanho = 0;
+#endif
     return no;
 }
 
 // Função para inicializar a árvore
-void inicializarArvore(ArvoreRN *arvore) {
+static void inicializarArvore(ArvoreRN *arvore) {
     arvore->nulo = criarNoNulo(NULL);
     arvore->raiz = arvore->nulo;
 }
 
 // Função para criar um novo nó
-No* criarNo(int valor) {
+static No* criarNo(int valor) {
     No *novoNo = (No*)malloc(sizeof(No));
     if (novoNo == NULL) {
         printf("Erro: Falha na alocação de memória!\n");
         return NULL;
     }
+    CONTAR(contadores, alocacoes);
     novoNo->valor = valor;
     novoNo->cor = VERMELHO;  // Novo nó é sempre vermelho
     novoNo->esquerda = NULL;
     novoNo->direita = NULL;
     novoNo->pai = NULL;
+#if ESTATISTICA_ORDEM
+    novoNo->tamanho = 1;
+#endif
     return novoNo;
 }
 
+#ifndef SEM_MAIN
 // Função para verificar se a árvore está vazia
-int arvoreVazia(ArvoreRN *arvore) {
+static int arvoreVazia(ArvoreRN *arvore) {
     return arvore->raiz == arvore->nulo;
 }
+#endif
+
+// Recalcular o tamanho da subárvore de um nó a partir dos filhos
+static void atualizarTamanho(ArvoreRN *arvore, No *no) {
+#if ESTATISTICA_ORDEM
+    if (no != arvore->nulo) {
+        no->tamanho = no->esquerda->tamanho + no->direita->tamanho + 1;
+    }
+#else
+    (void)arvore;
+    (void)no;
+#endif
+}
+
+// Recalcular os tamanhos de um nó até a raiz (caminho afetado por uma remoção)
+static void atualizarCaminho(ArvoreRN *arvore, No *no) {
+#if ESTATISTICA_ORDEM
+    while (no != arvore->nulo) {
+        atualizarTamanho(arvore, no);
+        no = no->pai;
+    }
+#else
+    (void)arvore;
+    (void)no;
+#endif
+}
 
 // ROTAÇÕES
 
 // Rotação à esquerda
-void rotacaoEsquerda(ArvoreRN *arvore, No *x) {
+static void rotacaoEsquerda(ArvoreRN *arvore, No *x) {
+    CONTAR(contadores, rotacoes);
     No *y = x->direita;
     x->direita = y->esquerda;
     
@@ -79,10 +146,15 @@ void rotacaoEsquerda(ArvoreRN *arvore, No *x) {
     
     y->esquerda = x;
     x->pai = y;
+    
+    // x agora é filho de y: atualizar de baixo para cima
+    atualizarTamanho(arvore, x);
+    atualizarTamanho(arvore, y);
 }
 
 // Rotação à direita
-void rotacaoDireita(ArvoreRN *arvore, No *y) {
+static void rotacaoDireita(ArvoreRN *arvore, No *y) {
+    CONTAR(contadores, rotacoes);
     No *x = y->esquerda;
     y->esquerda = x->direita;
     
@@ -102,29 +174,40 @@ void rotacaoDireita(ArvoreRN *arvore, No *y) {
     
     x->direita = y;
     y->pai = x;
+    
+    // y agora é filho de x: atualizar de baixo para cima
+    atualizarTamanho(arvore, y);
+    atualizarTamanho(arvore, x);
 }
 
 // FUNÇÕES AUXILIARES
 
 // Encontrar o nó com menor valor
-No* encontrarMinimo(ArvoreRN *arvore, No *no) {
+static No* encontrarMinimo(ArvoreRN *arvore, No *no) {
     while (no->esquerda != arvore->nulo) {
         no = no->esquerda;
     }
     return no;
 }
 
+#ifndef SEM_MAIN
 // Encontrar o nó com maior valor
-No* encontrarMaximo(ArvoreRN *arvore, No *no) {
+static No* encontrarMaximo(ArvoreRN *arvore, No *no) {
     while (no->direita != arvore->nulo) {
         no = no->direita;
     }
     return no;
 }
+#endif
 
 // Buscar um nó na árvore
-No* buscarNo(ArvoreRN *arvore, No *no, int valor) {
-    if (no == arvore->nulo || valor == no->valor) {
+static No* buscarNo(ArvoreRN *arvore, No *no, int valor) {
+    if (no == arvore->nulo) {
+        return no;
+    }
+    CONTAR(contadores, nosVisitados);
+    CONTAR(contadores, comparacoes);
+    if (valor == no->valor) {
         return no;
     }
     
@@ -138,10 +221,12 @@ No* buscarNo(ArvoreRN *arvore, No *no, int valor) {
 // CORREÇÃO DE INSERÇÃO
 
 // Corrigir violações após inserção
-void corrigirInsercao(ArvoreRN *arvore, No *k) {
+// Retorna 1 se a raiz precisou ser pintada de negro (a altura negra aumentou)
+static int corrigirInsercao(ArvoreRN *arvore, No *k) {
     No *tio;
     
     while (k->pai->cor == VERMELHO) {
+        CONTAR(contadores, correcoes);
         // Caso: Pai é filho esquerdo do avô
         if (k->pai == k->pai->pai->esquerda) {
             tio = k->pai->pai->direita;
@@ -194,15 +279,18 @@ void corrigirInsercao(ArvoreRN *arvore, No *k) {
         }
     }
     
+    int alturaAumentou = arvore->raiz->cor == VERMELHO;
     arvore->raiz->cor = NEGRO;  // Regra 2: raiz sempre negra
+    return alturaAumentou;
 }
 
 // INSERÇÃO
 
-// Inserir um valor na árvore
-void inserir(ArvoreRN *arvore, int valor) {
+// Inserir um valor descendo a partir de inicio, cuja subárvore deve conter a
+// posição do valor (retorna o novo nó)
+static No* inserirAPartirDe(ArvoreRN *arvore, No *inicio, int valor) {
     No *novoNo = criarNo(valor);
-    if (novoNo == NULL) return;
+    if (novoNo == NULL) return NULL;
     
     // Configurar os ponteiros do novo nó
     novoNo->esquerda = arvore->nulo;
@@ -211,10 +299,15 @@ void inserir(ArvoreRN *arvore, int valor) {
     
     // Inserção como em BST normal
     No *y = arvore->nulo;
-    No *x = arvore->raiz;
+    No *x = inicio;
     
     while (x != arvore->nulo) {
+        CONTAR(contadores, nosVisitados);
+        CONTAR(contadores, comparacoes);
         y = x;
+#if ESTATISTICA_ORDEM
+        x->tamanho++;  // O novo nó ficará nesta subárvore
+#endif
         if (novoNo->valor < x->valor) {
             x = x->esquerda;
         } else {
@@ -235,25 +328,117 @@ void inserir(ArvoreRN *arvore, int valor) {
     // Se novo nó é raiz, apenas colocar como negro e retornar
     if (novoNo->pai == arvore->nulo) {
         novoNo->cor = NEGRO;
-        printf("Valor %d inserido (raiz).\n", valor);
-        return;
+        return novoNo;
     }
     
     // Se avô é nulo, não precisa corrigir
     if (novoNo->pai->pai == arvore->nulo) {
-        printf("Valor %d inserido.\n", valor);
-        return;
+        return novoNo;
     }
     
     // Corrigir violações
     corrigirInsercao(arvore, novoNo);
-    printf("Valor %d inserido e árvore balanceada.\n", valor);
+    return novoNo;
+}
+
+// Inserir um valor na árvore sem exibir mensagens (retorna o novo nó)
+static No* inserirNo(ArvoreRN *arvore, int valor) {
+    return inserirAPartirDe(arvore, arvore->raiz, valor);
 }
 
+#ifndef SEM_MAIN
+
+// INSERÇÃO E BUSCA COM DICA
+
+// Subir a partir da dica até o primeiro nó cuja subárvore contém a posição de
+// valor. Em cada passo, os limites da subárvore são dados pelo primeiro
+// ancestral do lado oposto; se o valor cabe neles, a descida começa ali.
+// Quando os valores chegam quase ordenados, a dica já é esse nó ou está perto.
+static No* subirAteConter(ArvoreRN *arvore, No *no, int valor) {
+    for (;;) {
+        No *ancestral = no;
+        if (valor >= no->valor) {
+            // Limite superior: primeiro ancestral do qual no está à esquerda
+            while (ancestral->pai != arvore->nulo && ancestral == ancestral->pai->direita) {
+                ancestral = ancestral->pai;
+            }
+            if (ancestral->pai == arvore->nulo || valor < ancestral->pai->valor) {
+                return no;
+            }
+        } else {
+            // Limite inferior: primeiro ancestral do qual no está à direita
+            while (ancestral->pai != arvore->nulo && ancestral == ancestral->pai->esquerda) {
+                ancestral = ancestral->pai;
+            }
+            if (ancestral->pai == arvore->nulo || valor >= ancestral->pai->valor) {
+                return no;
+            }
+        }
+        no = ancestral->pai;  // O valor está além do limite: continuar a partir dele
+    }
+}
+
+// Inserir usando como ponto de partida um nó devolvido por operação anterior
+// (equivalente ao emplace_hint do std::map); dica nula usa a raiz.
+// Custo: sem ESTATISTICA_ORDEM, O(log d), com d a distância em ordem entre a
+// dica e a posição do valor (a correção das cores é O(1) amortizado). Com
+// ESTATISTICA_ORDEM, que é o padrão, todos os ancestrais do ponto de partida
+// ganham um nó no tamanho, e a inserção volta a ser O(altura): a dica só
+// poupa as comparações da descida.
+static No* inserirComDica(ArvoreRN *arvore, No *dica, int valor) {
+    if (dica == NULL || dica == arvore->nulo) {
+        return inserirNo(arvore, valor);
+    }
+    
+    No *inicio = subirAteConter(arvore, dica, valor);
+    
+#if ESTATISTICA_ORDEM
+    // Os ancestrais acima do ponto de partida também ganham um nó
+    for (No *ancestral = inicio->pai; ancestral != arvore->nulo; ancestral = ancestral->pai) {
+        ancestral->tamanho++;
+    }
+#endif
+    
+    return inserirAPartirDe(arvore, inicio, valor);
+}
+
+// Buscar um valor partindo de um nó devolvido por operação anterior
+static No* buscarComDica(ArvoreRN *arvore, No *dica, int valor) {
+    if (dica == NULL || dica == arvore->nulo) {
+        return buscarNo(arvore, arvore->raiz, valor);
+    }
+    
+    // Subir até um nó com o valor ou cuja subárvore guarda todas as ocorrências dele
+    No *no = dica;
+    while (no->pai != arvore->nulo && valor != no->valor) {
+        if (valor > no->valor) {
+            if (no == no->pai->esquerda && valor < no->pai->valor) break;
+        } else {
+            if (no == no->pai->direita && valor > no->pai->valor) break;
+        }
+        no = no->pai;
+    }
+    return buscarNo(arvore, no, valor);
+}
+
+// Inserir um valor na árvore
+static void inserir(ArvoreRN *arvore, int valor) {
+    No *novoNo = inserirNo(arvore, valor);
+    if (novoNo == NULL) return;
+    
+    if (novoNo == arvore->raiz) {
+        printf("Valor %d inserido (raiz).\n", valor);
+    } else {
+        printf("Valor %d inserido.\n", valor);
+    }
+}
+
+#endif
+
 // BUSCA
 
 // Buscar um valor na árvore
-int buscar(ArvoreRN *arvore, int valor) {
+static int buscar(ArvoreRN *arvore, int valor) {
     No *resultado = buscarNo(arvore, arvore->raiz, valor);
     return resultado != arvore->nulo;
 }
@@ -261,10 +446,11 @@ int buscar(ArvoreRN *arvore, int valor) {
 // CORREÇÃO DE REMOÇÃO
 
 // Corrigir violações após remoção
-void corrigirRemocao(ArvoreRN *arvore, No *x) {
+static void corrigirRemocao(ArvoreRN *arvore, No *x) {
     No *irmao;
     
     while (x != arvore->raiz && x->cor == NEGRO) {
+        CONTAR(contadores, correcoes);
         if (x == x->pai->esquerda) {
             irmao = x->pai->direita;
             
@@ -335,7 +521,7 @@ void corrigirRemocao(ArvoreRN *arvore, No *x) {
 }
 
 // Substituir um nó por outro na árvore
-void transplantar(ArvoreRN *arvore, No *u, No *v) {
+static void transplantar(ArvoreRN *arvore, No *u, No *v) {
     if (u->pai == arvore->nulo) {
         arvore->raiz = v;
     } else if (u == u->pai->esquerda) {
@@ -349,7 +535,7 @@ void transplantar(ArvoreRN *arvore, No *u, No *v) {
 // REMOÇÃO
 
 // Remover um valor da árvore
-int remover(ArvoreRN *arvore, int valor) {
+static int remover(ArvoreRN *arvore, int valor) {
     No *z = buscarNo(arvore, arvore->raiz, valor);
     if (z == arvore->nulo) {
         return 0;  // Valor não encontrado
@@ -384,7 +570,11 @@ int remover(ArvoreRN *arvore, int valor) {
         y->cor = z->cor;
     }
     
+    // Os tamanhos mudaram apenas no caminho de x até a raiz
+    atualizarCaminho(arvore, x->pai);
+    
     free(z);
+    CONTAR(contadores, liberacoes);
     
     if (corOriginalY == NEGRO) {
         corrigirRemocao(arvore, x);
@@ -393,10 +583,496 @@ int remover(ArvoreRN *arvore, int valor) {
     return 1;  // Remoção bem-sucedida
 }
 
+// ESTATÍSTICAS DE ORDEM (consultas do menu; os tamanhos das subárvores são
+// mantidos pela inserção e pela remoção também no módulo)
+
+#if ESTATISTICA_ORDEM && !defined(SEM_MAIN)
+// Quantidade total de valores na árvore
+static int tamanhoArvore(ArvoreRN *arvore) {
+    return arvore->raiz->tamanho;
+}
+
+// Encontrar o k-ésimo menor valor (k começa em 1) em O(log n)
+static No* selecionar(ArvoreRN *arvore, int k) {
+    No *no = arvore->raiz;
+    
+    while (no != arvore->nulo) {
+        int posicaoNo = no->esquerda->tamanho + 1;
+        if (k == posicaoNo) {
+            return no;
+        }
+        if (k < posicaoNo) {
+            no = no->esquerda;
+        } else {
+            k -= posicaoNo;
+            no = no->direita;
+        }
+    }
+    return arvore->nulo;  // k fora do intervalo [1, n]
+}
+
+// Contar quantos valores são menores que valor em O(log n)
+static int contarMenores(ArvoreRN *arvore, int valor) {
+    int contagem = 0;
+    No *no = arvore->raiz;
+    
+    while (no != arvore->nulo) {
+        if (no->valor < valor) {
+            contagem += no->esquerda->tamanho + 1;
+            no = no->direita;
+        } else {
+            no = no->esquerda;
+        }
+    }
+    return contagem;
+}
+
+// Contar quantos valores são menores ou iguais a valor em O(log n)
+static int contarMenoresOuIguais(ArvoreRN *arvore, int valor) {
+    int contagem = 0;
+    No *no = arvore->raiz;
+    
+    while (no != arvore->nulo) {
+        if (no->valor <= valor) {
+            contagem += no->esquerda->tamanho + 1;
+            no = no->direita;
+        } else {
+            no = no->esquerda;
+        }
+    }
+    return contagem;
+}
+
+// Contar quantos valores estão no intervalo [inicio, fim] em O(log n)
+static int contarIntervalo(ArvoreRN *arvore, int inicio, int fim) {
+    if (inicio > fim) return 0;
+    return contarMenoresOuIguais(arvore, fim) - contarMenores(arvore, inicio);
+}
+#endif
+
+// ITERAÇÃO E INTERVALOS
+//
+// Usam os ponteiros para o pai: não há pilha nem alocação, e percorrer k
+// valores a partir de uma posição custa O(log n + k) no total.
+
+// Próximo nó em ordem (nulo se no for o maior)
+static No* sucessor(ArvoreRN *arvore, No *no) {
+    if (no->direita != arvore->nulo) {
+        return encontrarMinimo(arvore, no->direita);
+    }
+    
+    // Subir enquanto viermos da direita
+    No *pai = no->pai;
+    while (pai != arvore->nulo && no == pai->direita) {
+        no = pai;
+        pai = pai->pai;
+    }
+    return pai;
+}
+
+#ifndef SEM_MAIN
+// Nó anterior em ordem (nulo se no for o menor)
+static No* predecessor(ArvoreRN *arvore, No *no) {
+    if (no->esquerda != arvore->nulo) {
+        return encontrarMaximo(arvore, no->esquerda);
+    }
+    
+    // Subir enquanto viermos da esquerda
+    No *pai = no->pai;
+    while (pai != arvore->nulo && no == pai->esquerda) {
+        no = pai;
+        pai = pai->pai;
+    }
+    return pai;
+}
+#endif
+
+// Primeiro nó com valor >= valor (nulo se não houver)
+static No* limiteInferior(ArvoreRN *arvore, int valor) {
+    No *resultado = arvore->nulo;
+    No *no = arvore->raiz;
+    
+    while (no != arvore->nulo) {
+        if (no->valor >= valor) {
+            resultado = no;
+            no = no->esquerda;
+        } else {
+            no = no->direita;
+        }
+    }
+    return resultado;
+}
+
+#ifndef SEM_MAIN
+// Primeiro nó com valor > valor (nulo se não houver)
+static No* limiteSuperior(ArvoreRN *arvore, int valor) {
+    No *resultado = arvore->nulo;
+    No *no = arvore->raiz;
+    
+    while (no != arvore->nulo) {
+        if (no->valor > valor) {
+            resultado = no;
+            no = no->esquerda;
+        } else {
+            no = no->direita;
+        }
+    }
+    return resultado;
+}
+#endif
+
+// Iterador sobre os valores de um intervalo fechado [inicio, fim]
+typedef struct {
+    ArvoreRN *arvore;
+    No *atual;  // Próximo nó a ser devolvido
+    int fim;
+} IteradorIntervalo;
+
+// Posicionar o iterador no primeiro valor >= inicio
+static void iniciarIntervalo(IteradorIntervalo *iterador, ArvoreRN *arvore, int inicio, int fim) {
+    iterador->arvore = arvore;
+    iterador->fim = fim;
+    iterador->atual = inicio <= fim ? limiteInferior(arvore, inicio) : arvore->nulo;
+}
+
+// Devolver o próximo nó do intervalo, ou NULL quando o intervalo terminar
+static No* proximoNoIntervalo(IteradorIntervalo *iterador) {
+    No *no = iterador->atual;
+    if (no == iterador->arvore->nulo || no->valor > iterador->fim) {
+        return NULL;
+    }
+    iterador->atual = sucessor(iterador->arvore, no);
+    return no;
+}
+
+// OPERAÇÕES DE CONJUNTOS (divisão e junção)
+//
+// União, interseção e diferença dividem uma árvore pela raiz da outra e
+// resolvem as duas metades independentes (em paralelo nos níveis de cima),
+// juntando os resultados com uma chave do meio. Custo total O(m log(n/m + 1)).
+// As operações consomem as duas árvores: o resultado fica na primeira.
+
+static void liberarArvore(ArvoreRN *arvore, No *no);
+
+#ifndef SEM_MAIN
+
+// Uma subárvore solta (raiz com pai nulo) e a sua altura negra
+typedef struct {
+    No *raiz;
+    int alturaNegra;  // Nós negros da raiz até as folhas, sem contar o nulo
+} Subarvore;
+
+#if ESTATISTICA_ORDEM
+// Somar delta ao tamanho de um nó e de todos os seus ancestrais
+static void ajustarTamanhos(ArvoreRN *arvore, No *no, int delta) {
+    for (; no != arvore->nulo; no = no->pai) {
+        no->tamanho += delta;
+    }
+}
+#endif
+
+// Calcular a altura negra descendo pela esquerda
+static int calcularAlturaNegra(ArvoreRN *arvore, No *no) {
+    int altura = 0;
+    for (; no != arvore->nulo; no = no->esquerda) {
+        if (no->cor == NEGRO) altura++;
+    }
+    return altura;
+}
+
+// Separar a raiz dos filhos; as alturas dos filhos saem da altura da raiz
+static No* separarRaiz(ArvoreRN *arvore, Subarvore t, Subarvore *esquerda, Subarvore *direita) {
+    No *raiz = t.raiz;
+    int alturaFilhos = t.alturaNegra - (raiz->cor == NEGRO ? 1 : 0);
+    
+    esquerda->raiz = raiz->esquerda;
+    esquerda->alturaNegra = alturaFilhos;
+    direita->raiz = raiz->direita;
+    direita->alturaNegra = alturaFilhos;
+    if (esquerda->raiz != arvore->nulo) esquerda->raiz->pai = arvore->nulo;
+    if (direita->raiz != arvore->nulo) direita->raiz->pai = arvore->nulo;
+    
+    raiz->esquerda = arvore->nulo;
+    raiz->direita = arvore->nulo;
+    raiz->pai = arvore->nulo;
+    atualizarTamanho(arvore, raiz);
+    return raiz;
+}
+
+// Juntar esquerda, k e direita, com esquerda < k < direita, em O(|diferença de alturas|).
+// k desce pela borda da árvore mais alta até um nó negro da altura da outra
+// e o vermelho resultante é corrigido como em uma inserção comum.
+static Subarvore juntar(ArvoreRN *arvore, Subarvore esquerda, No *k, Subarvore direita) {
+    No *nulo = arvore->nulo;
+    Subarvore resultado;
+    
+    // Raízes negras: a única violação possível passa a ser a do próprio k
+    if (esquerda.raiz->cor == VERMELHO) {
+        esquerda.raiz->cor = NEGRO;
+        esquerda.alturaNegra++;
+    }
+    if (direita.raiz->cor == VERMELHO) {
+        direita.raiz->cor = NEGRO;
+        direita.alturaNegra++;
+    }
+    
+    if (esquerda.alturaNegra == direita.alturaNegra) {
+        k->esquerda = esquerda.raiz;
+        k->direita = direita.raiz;
+        k->pai = nulo;
+        k->cor = NEGRO;
+        if (esquerda.raiz != nulo) esquerda.raiz->pai = k;
+        if (direita.raiz != nulo) direita.raiz->pai = k;
+        atualizarTamanho(arvore, k);
+        resultado.raiz = k;
+        resultado.alturaNegra = esquerda.alturaNegra + 1;
+        return resultado;
+    }
+    
+    int maisAltaEsquerda = esquerda.alturaNegra > direita.alturaNegra;
+    Subarvore alta = maisAltaEsquerda ? esquerda : direita;
+    Subarvore baixa = maisAltaEsquerda ? direita : esquerda;
+    
+    // Descer pela borda interna da árvore mais alta
+    No *pai = nulo;
+    No *x = alta.raiz;
+    int alturaX = alta.alturaNegra;
+    while (x->cor != NEGRO || alturaX != baixa.alturaNegra) {
+        if (x->cor == NEGRO) alturaX--;
+        pai = x;
+        x = maisAltaEsquerda ? x->direita : x->esquerda;
+    }
+    
+    // k (vermelho) ocupa o lugar de x, com x e a árvore baixa como filhos
+    k->cor = VERMELHO;
+    k->pai = pai;
+    if (maisAltaEsquerda) {
+        k->esquerda = x;
+        k->direita = baixa.raiz;
+        pai->direita = k;
+    } else {
+        k->esquerda = baixa.raiz;
+        k->direita = x;
+        pai->esquerda = k;
+    }
+    if (x != nulo) x->pai = k;
+    if (baixa.raiz != nulo) baixa.raiz->pai = k;
+    atualizarTamanho(arvore, k);
+#if ESTATISTICA_ORDEM
+    ajustarTamanhos(arvore, pai, k->tamanho - x->tamanho);
+#endif
+    
+    ArvoreRN vista;
+    vista.raiz = alta.raiz;
+    vista.nulo = nulo;
+    int aumentou = corrigirInsercao(&vista, k);
+    
+    resultado.raiz = vista.raiz;
+    resultado.alturaNegra = alta.alturaNegra + aumentou;
+    return resultado;
+}
+
+// Dividir t em valores menores e maiores que valor; o nó igual (se houver) sai em igual
+static void dividir(ArvoreRN *arvore, Subarvore t, int valor, Subarvore *menores, No **igual, Subarvore *maiores) {
+    if (t.raiz == arvore->nulo) {
+        menores->raiz = arvore->nulo;
+        menores->alturaNegra = 0;
+        *maiores = *menores;
+        *igual = NULL;
+        return;
+    }
+    
+    Subarvore esquerda, direita, parte;
+    No *meio = separarRaiz(arvore, t, &esquerda, &direita);
+    
+    if (valor == meio->valor) {
+        *menores = esquerda;
+        *igual = meio;
+        *maiores = direita;
+    } else if (valor < meio->valor) {
+        dividir(arvore, esquerda, valor, menores, igual, &parte);
+        *maiores = juntar(arvore, parte, meio, direita);
+    } else {
+        dividir(arvore, direita, valor, &parte, igual, maiores);
+        *menores = juntar(arvore, esquerda, meio, parte);
+    }
+}
+
+// Retirar o maior nó de t; o restante fica em resto
+static No* dividirUltimo(ArvoreRN *arvore, Subarvore t, Subarvore *resto) {
+    Subarvore esquerda, direita, parte;
+    No *meio = separarRaiz(arvore, t, &esquerda, &direita);
+    
+    if (direita.raiz == arvore->nulo) {
+        *resto = esquerda;
+        return meio;
+    }
+    
+    No *ultimo = dividirUltimo(arvore, direita, &parte);
+    *resto = juntar(arvore, esquerda, meio, parte);
+    return ultimo;
+}
+
+// Juntar duas árvores sem chave do meio (todas de esquerda < todas de direita)
+static Subarvore juntarSemChave(ArvoreRN *arvore, Subarvore esquerda, Subarvore direita) {
+    if (esquerda.raiz == arvore->nulo) return direita;
+    if (direita.raiz == arvore->nulo) return esquerda;
+    
+    Subarvore resto;
+    No *ultimo = dividirUltimo(arvore, esquerda, &resto);
+    return juntar(arvore, resto, ultimo, direita);
+}
+
+typedef enum { UNIAO, INTERSECAO, DIFERENCA } OperacaoConjunto;
+
+// Uma chamada recursiva de operação de conjuntos (executável em outra thread)
+typedef struct {
+    ArvoreRN *arvore;
+    OperacaoConjunto operacao;
+    Subarvore a;
+    Subarvore b;
+    int nivelParalelo;  // Quantos níveis ainda podem criar threads
+    Subarvore resultado;
+} TarefaConjunto;
+
+static Subarvore operarConjuntos(ArvoreRN *arvore, OperacaoConjunto operacao, Subarvore a, Subarvore b, int nivelParalelo);
+
+// Ponto de entrada das threads criadas pela recursão
+static void* executarTarefaConjunto(void *argumento) {
+    TarefaConjunto *tarefa = (TarefaConjunto*)argumento;
+    tarefa->resultado = operarConjuntos(tarefa->arvore, tarefa->operacao,
+                                        tarefa->a, tarefa->b, tarefa->nivelParalelo);
+    return NULL;
+}
+
+// Resolver as duas metades; nos níveis de cima a da esquerda vai para outra thread
+static void resolverMetades(TarefaConjunto *esquerda, TarefaConjunto *direita) {
+    pthread_t thread;
+    int paralelo = esquerda->nivelParalelo > 0 &&
+                   esquerda->a.alturaNegra + esquerda->b.alturaNegra >= 12 &&
+                   pthread_create(&thread, NULL, executarTarefaConjunto, esquerda) == 0;
+    
+    if (!paralelo) {
+        executarTarefaConjunto(esquerda);
+    }
+    executarTarefaConjunto(direita);
+    if (paralelo) {
+        pthread_join(thread, NULL);
+    }
+}
+
+// Liberar uma subárvore que não faz parte do resultado
+static void descartarSubarvore(ArvoreRN *arvore, Subarvore t) {
+    liberarArvore(arvore, t.raiz);
+}
+
+// Aplicar a operação dividindo a pela raiz de b
+static Subarvore operarConjuntos(ArvoreRN *arvore, OperacaoConjunto operacao, Subarvore a, Subarvore b, int nivelParalelo) {
+    if (b.raiz == arvore->nulo) {
+        if (operacao == INTERSECAO) {
+            descartarSubarvore(arvore, a);
+            return b;
+        }
+        return a;  // União e diferença: sobra a
+    }
+    if (a.raiz == arvore->nulo) {
+        if (operacao == UNIAO) {
+            return b;
+        }
+        descartarSubarvore(arvore, b);
+        return a;  // Interseção e diferença com vazio: vazio
+    }
+    
+    Subarvore esquerdaB, direitaB;
+    No *chave = separarRaiz(arvore, b, &esquerdaB, &direitaB);
+    
+    TarefaConjunto esquerda, direita;
+    No *igual;
+    dividir(arvore, a, chave->valor, &esquerda.a, &igual, &direita.a);
+    
+    esquerda.arvore = direita.arvore = arvore;
+    esquerda.operacao = direita.operacao = operacao;
+    esquerda.b = esquerdaB;
+    direita.b = direitaB;
+    esquerda.nivelParalelo = direita.nivelParalelo = nivelParalelo - 1;
+    resolverMetades(&esquerda, &direita);
+    
+    // A chave fica no resultado na união, e na interseção só se estava nas duas
+    int manterChave = operacao == UNIAO || (operacao == INTERSECAO && igual != NULL);
+    if (igual != NULL) {
+        free(igual);
+        CONTAR(contadores, liberacoes);
+    }
+    if (manterChave) {
+        return juntar(arvore, esquerda.resultado, chave, direita.resultado);
+    }
+    free(chave);
+    CONTAR(contadores, liberacoes);
+    return juntarSemChave(arvore, esquerda.resultado, direita.resultado);
+}
+
+// Trocar o nó nulo de uma árvore pelo de outra (para as duas compartilharem folhas)
+static void trocarNulo(No *no, No *antigo, No *novo) {
+    while (no != antigo) {
+        if (no->esquerda == antigo) {
+            no->esquerda = novo;
+        } else {
+            trocarNulo(no->esquerda, antigo, novo);
+        }
+        if (no->direita == antigo) {
+            no->direita = novo;
+            return;
+        }
+        no = no->direita;
+    }
+}
+
+// Aplicar a operação entre destino e outra com até threads threads;
+// o resultado fica em destino e outra fica vazia
+static void operarArvores(ArvoreRN *destino, ArvoreRN *outra, OperacaoConjunto operacao, int threads) {
+    No *raizOutra = destino->nulo;
+    if (outra->raiz != outra->nulo) {
+        raizOutra = outra->raiz;
+        trocarNulo(raizOutra, outra->nulo, destino->nulo);
+        raizOutra->pai = destino->nulo;
+    }
+    outra->raiz = outra->nulo;
+    
+    Subarvore a = { destino->raiz, calcularAlturaNegra(destino, destino->raiz) };
+    Subarvore b = { raizOutra, calcularAlturaNegra(destino, raizOutra) };
+    
+    int nivelParalelo = 0;
+    while ((1 << nivelParalelo) < threads) {
+        nivelParalelo++;
+    }
+    
+    Subarvore resultado = operarConjuntos(destino, operacao, a, b, nivelParalelo);
+    destino->raiz = resultado.raiz;
+    destino->raiz->pai = destino->nulo;
+    if (destino->raiz != destino->nulo) {
+        destino->raiz->cor = NEGRO;
+    }
+}
+
+// União: destino passa a ter os valores das duas árvores
+static void uniao(ArvoreRN *destino, ArvoreRN *outra, int threads) {
+    operarArvores(destino, outra, UNIAO, threads);
+}
+
+// Interseção: destino fica só com os valores presentes nas duas
+static void intersecao(ArvoreRN *destino, ArvoreRN *outra, int threads) {
+    operarArvores(destino, outra, INTERSECAO, threads);
+}
+
+// Diferença: destino perde os valores presentes em outra
+static void diferenca(ArvoreRN *destino, ArvoreRN *outra, int threads) {
+    operarArvores(destino, outra, DIFERENCA, threads);
+}
+
 // PERCURSOS
 
 // Pré-ordem: Raiz → Esquerda → Direita
-void preOrdem(ArvoreRN *arvore, No *no) {
+static void preOrdem(ArvoreRN *arvore, No *no) {
     if (no != arvore->nulo) {
         printf("%d(%s) ", no->valor, no->cor == VERMELHO ? "V" : "N");
         preOrdem(arvore, no->esquerda);
@@ -405,7 +1081,7 @@ void preOrdem(ArvoreRN *arvore, No *no) {
 }
 
 // Em ordem: Esquerda → Raiz → Direita
-void emOrdem(ArvoreRN *arvore, No *no) {
+static void emOrdem(ArvoreRN *arvore, No *no) {
     if (no != arvore->nulo) {
         emOrdem(arvore, no->esquerda);
         printf("%d(%s) ", no->valor, no->cor == VERMELHO ? "V" : "N");
@@ -414,7 +1090,7 @@ void emOrdem(ArvoreRN *arvore, No *no) {
 }
 
 // Pós-ordem: Esquerda → Direita → Raiz
-void posOrdem(ArvoreRN *arvore, No *no) {
+static void posOrdem(ArvoreRN *arvore, No *no) {
     if (no != arvore->nulo) {
         posOrdem(arvore, no->esquerda);
         posOrdem(arvore, no->direita);
@@ -422,30 +1098,732 @@ void posOrdem(ArvoreRN *arvore, No *no) {
     }
 }
 
+// CARGA A PARTIR DE VALORES ORDENADOS
+
+// Montar uma árvore balanceada com os valores ordenados de inicio a fim. Com
+// o do meio como raiz, os níveis acima de profundidadeVermelha ficam
+// completos; só os nós do último nível (incompleto) são vermelhos, e todo
+// caminho passa pela mesma quantidade de nós negros.
+static No* construirBalanceada(ArvoreRN *arvore, const int *valores, int inicio, int fim, No *pai, int profundidade, int profundidadeVermelha) {
+    if (inicio > fim) {
+        return arvore->nulo;
+    }
+    
+    int meio = inicio + (fim - inicio) / 2;
+    No *no = criarNo(valores[meio]);
+    no->cor = profundidade == profundidadeVermelha ? VERMELHO : NEGRO;
+    no->pai = pai;
+    no->esquerda = construirBalanceada(arvore, valores, inicio, meio - 1, no, profundidade + 1, profundidadeVermelha);
+    no->direita = construirBalanceada(arvore, valores, meio + 1, fim, no, profundidade + 1, profundidadeVermelha);
+    atualizarTamanho(arvore, no);
+    return no;
+}
+
+// Níveis completos de uma árvore balanceada com n nós: floor(log2(n + 1))
+static int niveisCompletos(int n) {
+    int niveis = 0;
+    while ((2LL << niveis) <= (long long)n + 1) {
+        niveis++;
+    }
+    return niveis;
+}
+
+// Substituir o conteúdo da árvore pelos n valores ordenados, em O(n)
+static void carregarOrdenados(ArvoreRN *arvore, const int *valores, int n) {
+    liberarArvore(arvore, arvore->raiz);
+    arvore->raiz = construirBalanceada(arvore, valores, 0, n - 1, arvore->nulo, 0, niveisCompletos(n));
+}
+
+// Uma chamada de construirBalanceadaParalela (executável em outra thread)
+typedef struct {
+    ArvoreRN *arvore;
+    const int *valores;
+    int inicio;
+    int fim;
+    No *pai;
+    int profundidade;
+    int profundidadeVermelha;
+    int nivelParalelo;  // Quantos níveis ainda podem criar threads
+    No *raiz;
+} TarefaConstrucao;
+
+static No* construirBalanceadaParalela(TarefaConstrucao *tarefa);
+
+// Ponto de entrada das threads criadas pela construção
+static void* executarTarefaConstrucao(void *argumento) {
+    TarefaConstrucao *tarefa = (TarefaConstrucao*)argumento;
+    tarefa->raiz = construirBalanceadaParalela(tarefa);
+    return NULL;
+}
+
+// Como construirBalanceada (mesmas cores), mas nos nivelParalelo níveis de
+// cima a metade da esquerda é montada em outra thread. Os nós desses níveis
+// formam a espinha e as subárvores abaixo deles são disjuntas: só o nó nulo
+// é compartilhado, e a montagem não escreve nele.
+static No* construirBalanceadaParalela(TarefaConstrucao *tarefa) {
+    ArvoreRN *arvore = tarefa->arvore;
+    if (tarefa->nivelParalelo <= 0 || tarefa->fim - tarefa->inicio < MINIMO_PARALELO) {
+        return construirBalanceada(arvore, tarefa->valores, tarefa->inicio, tarefa->fim, tarefa->pai,
+                                   tarefa->profundidade, tarefa->profundidadeVermelha);
+    }
+    
+    int meio = tarefa->inicio + (tarefa->fim - tarefa->inicio) / 2;
+    No *no = criarNo(tarefa->valores[meio]);
+    no->cor = tarefa->profundidade == tarefa->profundidadeVermelha ? VERMELHO : NEGRO;
+    no->pai = tarefa->pai;
+    
+    TarefaConstrucao esquerda = *tarefa, direita = *tarefa;
+    esquerda.fim = meio - 1;
+    direita.inicio = meio + 1;
+    esquerda.pai = direita.pai = no;
+    esquerda.profundidade = direita.profundidade = tarefa->profundidade + 1;
+    esquerda.nivelParalelo = direita.nivelParalelo = tarefa->nivelParalelo - 1;
+    
+    pthread_t thread;
+    int paralelo = pthread_create(&thread, NULL, executarTarefaConstrucao, &esquerda) == 0;
+    if (!paralelo) {
+        executarTarefaConstrucao(&esquerda);
+    }
+    no->direita = construirBalanceadaParalela(&direita);
+    if (paralelo) {
+        pthread_join(thread, NULL);
+    }
+    no->esquerda = esquerda.raiz;
+    atualizarTamanho(arvore, no);
+    return no;
+}
+
+// Níveis de recursão com threads para ocupar threads threads
+static int niveisParalelos(int threads) {
+    int niveis = 0;
+    while ((1 << niveis) < threads && niveis < 16) {
+        niveis++;
+    }
+    return niveis;
+}
+
+// Substituir o conteúdo da árvore pelas n chaves (fora de ordem e com
+// repetidos), ordenadas e montadas com threads threads. O vetor fica ordenado
+// e sem repetidos no começo. Retorna a quantidade de chaves distintas (-1 se
+// faltar memória).
+static int carregarEmParalelo(ArvoreRN *arvore, int *chaves, int n, int threads) {
+    int distintos = ordenarSemRepetidos(chaves, n, threads);
+    if (distintos < 0) return -1;
+    
+    liberarArvore(arvore, arvore->raiz);
+    TarefaConstrucao tarefa = { arvore, chaves, 0, distintos - 1, arvore->nulo, 0,
+                                niveisCompletos(distintos), niveisParalelos(threads), NULL };
+    arvore->raiz = construirBalanceadaParalela(&tarefa);
+    return distintos;
+}
+
+// Contar os nós da árvore
+static int contarNos(ArvoreRN *arvore, No *no) {
+    if (no == arvore->nulo) {
+        return 0;
+    }
+    return contarNos(arvore, no->esquerda) + contarNos(arvore, no->direita) + 1;
+}
+
+#endif
+
+// Altura da subárvore de no, sem contar o nulo (0 se vazia)
+static int altura(ArvoreRN *arvore, No *no) {
+    if (no == arvore->nulo) return 0;
+    int esquerda = altura(arvore, no->esquerda);
+    int direita = altura(arvore, no->direita);
+    return 1 + (esquerda > direita ? esquerda : direita);
+}
+
+#ifndef SEM_MAIN
+
+// Copiar os valores em ordem para o vetor, a partir da posição *pos
+static void copiarEmOrdem(ArvoreRN *arvore, No *no, int *valores, int *pos) {
+    if (no != arvore->nulo) {
+        copiarEmOrdem(arvore, no->esquerda, valores, pos);
+        valores[(*pos)++] = no->valor;
+        copiarEmOrdem(arvore, no->direita, valores, pos);
+    }
+}
+
+// LOG E RECUPERAÇÃO (log.h)
+
+// Reaplicar uma operação do log (a árvore não guarda dados)
+static void aplicarOperacao(void *estrutura, char operacao, int chave, int dado) {
+    (void)dado;
+    ArvoreRN *arvore = (ArvoreRN*)estrutura;
+    if (operacao == LOG_INSERIR) {
+        if (!buscar(arvore, chave)) {
+            inserirNo(arvore, chave);
+        }
+    } else {
+        remover(arvore, chave);
+    }
+}
+
+// Substituir a árvore pelos valores ordenados do instantâneo
+static void carregarInstantaneo(void *estrutura, const int *chaves, const int *dados, int n) {
+    (void)dados;
+    carregarOrdenados((ArvoreRN*)estrutura, chaves, n);
+}
+
+// Gravar um instantâneo com os valores da árvore (esvazia o log)
+static void gravarInstantaneo(LogOperacoes *log, ArvoreRN *arvore) {
+    int n = contarNos(arvore, arvore->raiz), pos = 0;
+    int *valores = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    copiarEmOrdem(arvore, arvore->raiz, valores, &pos);
+    logGravarInstantaneo(log, valores, NULL, n);
+    free(valores);
+}
+
+// Registrar uma operação já feita na árvore (e o instantâneo, se for a hora)
+static void registrarOperacao(LogOperacoes *log, ArvoreRN *arvore, char operacao, int chave) {
+    logRegistrar(log, operacao, chave);
+    if (logPrecisaInstantaneo(log)) {
+        gravarInstantaneo(log, arvore);
+    }
+}
+
+// Abrir o log de base e recuperar a árvore a partir dele
+static bool abrirLog(LogOperacoes *log, ArvoreRN *arvore, const char *base, int grupo, long long intervalo) {
+    if (!logAbrir(log, base, grupo, intervalo)) {
+        return false;
+    }
+    
+    int numChaves;
+    long long numRegistros;
+    liberarArvore(arvore, arvore->raiz);
+    arvore->raiz = arvore->nulo;
+    
+    clock_t inicio = clock();
+    if (!logRecuperar(log, arvore, carregarInstantaneo, aplicarOperacao, &numChaves, &numRegistros)) {
+        logFechar(log);
+        return false;
+    }
+    double tempo = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    printf("Recuperação: %d valores do instantâneo e %lld operações do log em %.3f s.\n",
+           numChaves, numRegistros, tempo);
+    
+    gravarInstantaneo(log, arvore);
+    return true;
+}
+
+// MEDIÇÃO DE DESEMPENHO
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+static unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Segundos decorridos desde o instante inicio
+static double segundosDesde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Medir inserção, busca e remoção de n valores aleatórios em uma árvore separada
+static void medirDesempenho(int n) {
+    ArvoreRN teste;
+    inicializarArvore(&teste);
+    
+    int *valores = (int*)malloc(sizeof(int) * n);
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        valores[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        inserirNo(&teste, valores[i]);
+    }
+    double tempoInsercao = segundosDesde(inicio);
+    
+    int encontrados = 0;
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        encontrados += buscar(&teste, valores[i]);
+    }
+    double tempoBusca = segundosDesde(inicio);
+    
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        remover(&teste, valores[i]);
+    }
+    double tempoRemocao = segundosDesde(inicio);
+    
+    printf("Estatísticas de ordem: %s\n", ESTATISTICA_ORDEM ? "ativadas" : "desativadas");
+    printf("Inserção: %.3f s (%.1f ns/op)\n", tempoInsercao, tempoInsercao * 1e9 / n);
+    printf("Busca:    %.3f s (%.1f ns/op, %d encontrados)\n", tempoBusca, tempoBusca * 1e9 / n, encontrados);
+    printf("Remoção:  %.3f s (%.1f ns/op)\n", tempoRemocao, tempoRemocao * 1e9 / n);
+    
+    liberarArvore(&teste, teste.raiz);
+    free(teste.nulo);
+    free(valores);
+}
+
+// Gerar n valores ordenados (tipo 0), quase ordenados (tipo 1) ou aleatórios (tipo 2)
+static void gerarValores(int *valores, int n, int tipo, unsigned int *estado) {
+    for (int i = 0; i < n; i++) {
+        if (tipo == 2) {
+            valores[i] = (int)(proximoAleatorio(estado) >> 1);
+        } else {
+            valores[i] = i * 4;
+            if (tipo == 1) {
+                valores[i] += (int)(proximoAleatorio(estado) % 16);  // Pequena desordem local
+            }
+        }
+    }
+}
+
+// Comparar inserção e busca a partir da raiz com as versões que usam o último
+// nó como dica
+static void medirInsercaoComDica(int n) {
+    const char *nomes[] = { "ordenada", "quase ordenada", "aleatória" };
+#if ESTATISTICA_ORDEM
+    printf("Com ESTATISTICA_ORDEM a inserção com dica ainda sobe até a raiz para atualizar os\n"
+           "tamanhos (O(altura)); compile com -DESTATISTICA_ORDEM=0 para a versão O(log d).\n");
+#endif
+    int *valores = (int*)malloc(sizeof(int) * n);
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    
+    for (int tipo = 0; tipo < 3; tipo++) {
+        unsigned int estado = 2463534242u;
+        gerarValores(valores, n, tipo, &estado);
+        
+        ArvoreRN semDica, comDica;
+        inicializarArvore(&semDica);
+        inicializarArvore(&comDica);
+        
+        clock_t inicio = clock();
+        for (int i = 0; i < n; i++) {
+            inserirNo(&semDica, valores[i]);
+        }
+        double tempoRaiz = segundosDesde(inicio);
+        
+        No *dica = NULL;
+        inicio = clock();
+        for (int i = 0; i < n; i++) {
+            dica = inserirComDica(&comDica, dica, valores[i]);
+        }
+        double tempoDica = segundosDesde(inicio);
+        
+        // Buscas na mesma ordem: da raiz e a partir do último nó encontrado
+        int achados = 0;
+        inicio = clock();
+        for (int i = 0; i < n; i++) {
+            achados += buscarNo(&semDica, semDica.raiz, valores[i]) != semDica.nulo;
+        }
+        double tempoBuscaRaiz = segundosDesde(inicio);
+        
+        dica = NULL;
+        inicio = clock();
+        for (int i = 0; i < n; i++) {
+            No *no = buscarComDica(&comDica, dica, valores[i]);
+            if (no != comDica.nulo) {
+                dica = no;
+                achados++;
+            }
+        }
+        double tempoBuscaDica = segundosDesde(inicio);
+        
+        printf("Entrada %-15s inserção raiz: %.1f ns/op   dica: %.1f ns/op   busca raiz: %.1f ns/op   dica: %.1f ns/op\n",
+               nomes[tipo], tempoRaiz * 1e9 / n, tempoDica * 1e9 / n,
+               tempoBuscaRaiz * 1e9 / n, tempoBuscaDica * 1e9 / n);
+        if (achados != 2 * n) {
+            printf("Erro: %d buscas não encontraram o valor!\n", 2 * n - achados);
+        }
+        
+        liberarArvore(&semDica, semDica.raiz);
+        free(semDica.nulo);
+        liberarArvore(&comDica, comDica.raiz);
+        free(comDica.nulo);
+    }
+    
+    free(valores);
+}
+
+// Instante atual em segundos (relógio de parede, para medições com threads)
+static double agora() {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return instante.tv_sec + instante.tv_nsec / 1e9;
+}
+
+// Preencher uma árvore com n valores aleatórios distintos em [0, limite)
+static void preencherAleatoria(ArvoreRN *arvore, int n, int limite, unsigned int estado) {
+    inicializarArvore(arvore);
+    for (int i = 0; i < n; i++) {
+        int valor = (int)(proximoAleatorio(&estado) % limite);
+        if (!buscar(arvore, valor)) {
+            inserirNo(arvore, valor);
+        }
+    }
+}
+
+// Operação feita valor a valor: percorre outra e insere, busca ou remove em destino
+static void operarValorAValor(ArvoreRN *destino, ArvoreRN *outra, No *no, OperacaoConjunto operacao, ArvoreRN *comuns) {
+    if (no == outra->nulo) return;
+    
+    operarValorAValor(destino, outra, no->esquerda, operacao, comuns);
+    if (operacao == UNIAO) {
+        if (!buscar(destino, no->valor)) inserirNo(destino, no->valor);
+    } else if (operacao == INTERSECAO) {
+        if (buscar(destino, no->valor)) inserirNo(comuns, no->valor);
+    } else {
+        remover(destino, no->valor);
+    }
+    operarValorAValor(destino, outra, no->direita, operacao, comuns);
+}
+
+// Comparar a operação valor a valor com a versão por divisão e junção
+// para |A| = n e |B| = m, com 1, 2, 4 e 8 threads
+static void medirOperacoesConjuntos(int n, int m) {
+    const char *nomes[] = { "união", "interseção", "diferença" };
+    int limite = 2 * (n > m ? n : m);
+    
+    for (int operacao = UNIAO; operacao <= DIFERENCA; operacao++) {
+        ArvoreRN a, b, comuns;
+        preencherAleatoria(&a, n, limite, 2463534242u);
+        preencherAleatoria(&b, m, limite, 88675123u);
+        inicializarArvore(&comuns);
+        
+        double inicio = agora();
+        operarValorAValor(&a, &b, b.raiz, (OperacaoConjunto)operacao, &comuns);
+        double tempoValorAValor = agora() - inicio;
+        printf("%-10s valor a valor: %8.2f ms\n", nomes[operacao], tempoValorAValor * 1e3);
+        
+        liberarArvore(&a, a.raiz);
+        liberarArvore(&b, b.raiz);
+        liberarArvore(&comuns, comuns.raiz);
+        free(a.nulo);
+        free(b.nulo);
+        free(comuns.nulo);
+        
+        for (int threads = 1; threads <= 8; threads *= 2) {
+            preencherAleatoria(&a, n, limite, 2463534242u);
+            preencherAleatoria(&b, m, limite, 88675123u);
+            
+            inicio = agora();
+            operarArvores(&a, &b, (OperacaoConjunto)operacao, threads);
+            double tempoJuncao = agora() - inicio;
+            printf("%-10s junção, %d thread(s): %8.2f ms\n", nomes[operacao], threads, tempoJuncao * 1e3);
+            
+            liberarArvore(&a, a.raiz);
+            free(a.nulo);
+            free(b.nulo);
+        }
+    }
+}
+
+// Medir o custo do log por operação e a recuperação: n operações aleatórias
+// (uma remoção a cada quatro) sem log e com log confirmado a cada grupo
+// operações, com instantâneos a cada n / 4. Depois, simulando uma queda,
+// recuperar do instantâneo e do log e comparar com refazer tudo pela inserção.
+static void medirLog(int n, int grupo) {
+    const char *base = "arvoreRN_medicao";
+    int *chaves = (int*)malloc(sizeof(int) * n);
+    if (chaves == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        chaves[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    // Sem log (o mesmo que refazer as operações pela inserção)
+    ArvoreRN semLog;
+    inicializarArvore(&semLog);
+    double inicio = agora();
+    for (int i = 0; i < n; i++) {
+        int chave = i % 4 == 3 ? chaves[i - 2] : chaves[i];
+        aplicarOperacao(&semLog, i % 4 == 3 ? LOG_REMOVER : LOG_INSERIR, chave, chave);
+    }
+    double tempoSemLog = agora() - inicio;
+    
+    // Com log (tempo de parede: a espera do fsync não conta como CPU)
+    static LogOperacoes logMedicao;
+    char nome[64];
+    snprintf(nome, sizeof(nome), "%s.log", base);
+    remove(nome);
+    snprintf(nome, sizeof(nome), "%s.inst", base);
+    remove(nome);
+    
+    ArvoreRN comLog;
+    inicializarArvore(&comLog);
+    if (!logAbrir(&logMedicao, base, grupo, n / 4 + 1)) {
+        liberarArvore(&semLog, semLog.raiz);
+        free(semLog.nulo);
+        free(comLog.nulo);
+        free(chaves);
+        return;
+    }
+    inicio = agora();
+    for (int i = 0; i < n; i++) {
+        char operacao = i % 4 == 3 ? LOG_REMOVER : LOG_INSERIR;
+        int chave = i % 4 == 3 ? chaves[i - 2] : chaves[i];
+        aplicarOperacao(&comLog, operacao, chave, chave);
+        registrarOperacao(&logMedicao, &comLog, operacao, chave);
+    }
+    logFechar(&logMedicao);  // Queda: sem instantâneo final
+    double tempoComLog = agora() - inicio;
+    long long sincronizacoes = logMedicao.sincronizacoes;
+    
+    // Recuperação
+    ArvoreRN recuperada;
+    inicializarArvore(&recuperada);
+    int numChaves = 0;
+    long long numRegistros = 0;
+    inicio = agora();
+    if (logAbrir(&logMedicao, base, grupo, 0)) {
+        logRecuperar(&logMedicao, &recuperada, carregarInstantaneo, aplicarOperacao, &numChaves, &numRegistros);
+        logFechar(&logMedicao);
+    }
+    double tempoRecuperacao = agora() - inicio;
+    
+    // Conferir a árvore recuperada
+    int total = contarNos(&comLog, comLog.raiz), pos1 = 0, pos2 = 0;
+    bool igual = total == contarNos(&recuperada, recuperada.raiz);
+    if (igual && total > 0) {
+        int *esperado = (int*)malloc(sizeof(int) * total);
+        int *obtido = (int*)malloc(sizeof(int) * total);
+        copiarEmOrdem(&comLog, comLog.raiz, esperado, &pos1);
+        copiarEmOrdem(&recuperada, recuperada.raiz, obtido, &pos2);
+        igual = memcmp(esperado, obtido, sizeof(int) * total) == 0;
+        free(esperado);
+        free(obtido);
+    }
+    
+    printf("Sem log:     %.3f s (%.1f ns/op)\n", tempoSemLog, tempoSemLog * 1e9 / n);
+    printf("Com log:     %.3f s (%.1f ns/op, +%.1f ns/op, %lld sincronizações, grupo de %d)\n",
+           tempoComLog, tempoComLog * 1e9 / n, (tempoComLog - tempoSemLog) * 1e9 / n, sincronizacoes, logMedicao.tamanhoGrupo);
+    printf("Recuperação: %.3f s (%d valores do instantâneo + %lld operações do log), árvore %s\n",
+           tempoRecuperacao, numChaves, numRegistros, igual ? "conferida" : "DIFERENTE");
+    printf("Refazer as %d operações pela inserção: %.3f s\n", n, tempoSemLog);
+    
+    snprintf(nome, sizeof(nome), "%s.log", base);
+    remove(nome);
+    snprintf(nome, sizeof(nome), "%s.inst", base);
+    remove(nome);
+    liberarArvore(&semLog, semLog.raiz);
+    liberarArvore(&comLog, comLog.raiz);
+    liberarArvore(&recuperada, recuperada.raiz);
+    free(semLog.nulo);
+    free(comLog.nulo);
+    free(recuperada.nulo);
+    free(chaves);
+}
+
+// Medir a carga em lote de n chaves aleatórias (com repetidos) com 1, 2, 4...
+// até maxThreads threads, separando a ordenação da montagem, e comparar com
+// inserir uma a uma. Cada árvore montada é conferida com a ordenação.
+static void medirConstrucaoParalela(int n, int maxThreads) {
+    int *chaves = (int*)malloc(sizeof(int) * n);
+    int *trabalho = (int*)malloc(sizeof(int) * n);
+    int *emOrdem = (int*)malloc(sizeof(int) * n);
+    if (chaves == NULL || trabalho == NULL || emOrdem == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(chaves);
+        free(trabalho);
+        free(emOrdem);
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        chaves[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    // Uma a uma, pela inserção
+    ArvoreRN arvore;
+    inicializarArvore(&arvore);
+    double inicio = agora();
+    for (int i = 0; i < n; i++) {
+        inserirNo(&arvore, chaves[i]);
+    }
+    double tempoInsercao = agora() - inicio;
+    printf("Inserção uma a uma: %.3f s (%d nós, altura %d)\n", tempoInsercao,
+           contarNos(&arvore, arvore.raiz), altura(&arvore, arvore.raiz));
+    
+    double base = 0;
+    for (int threads = 1; ; threads = threads * 2 <= maxThreads ? threads * 2 : maxThreads) {
+        // A ordenação sozinha, e depois a carga inteira sobre outra cópia
+        for (int i = 0; i < n; i++) {
+            trabalho[i] = chaves[i];
+        }
+        inicio = agora();
+        ordenarSemRepetidos(trabalho, n, threads);
+        double tempoOrdenacao = agora() - inicio;
+        
+        for (int i = 0; i < n; i++) {
+            trabalho[i] = chaves[i];
+        }
+        liberarArvore(&arvore, arvore.raiz);  // Fora do tempo medido
+        arvore.raiz = arvore.nulo;
+        inicio = agora();
+        int distintos = carregarEmParalelo(&arvore, trabalho, n, threads);
+        double total = agora() - inicio;
+        if (distintos < 0) break;
+        double tempoMontagem = total > tempoOrdenacao ? total - tempoOrdenacao : 0;
+        if (threads == 1) base = total;
+        
+        int pos = 0;
+        copiarEmOrdem(&arvore, arvore.raiz, emOrdem, &pos);
+        bool confere = pos == distintos;
+        for (int i = 0; confere && i < distintos; i++) {
+            confere = emOrdem[i] == trabalho[i];
+        }
+        
+        printf("%3d threads: ordenação %.3f s + montagem %.3f s = %.3f s (%.2fx sobre 1 thread, %.1fx sobre a inserção), "
+               "%d chaves, altura %d, %s\n", threads, tempoOrdenacao, tempoMontagem, total, base / total,
+               tempoInsercao / total, distintos, altura(&arvore, arvore.raiz), confere ? "conferida" : "DIFERENTE");
+        if (threads == maxThreads) break;
+    }
+    
+    liberarArvore(&arvore, arvore.raiz);
+    free(arvore.nulo);
+    free(chaves);
+    free(trabalho);
+    free(emOrdem);
+}
+
+#endif
+
+// INTERFACE DE CONJUNTO (conjunto.h)
+
+// Estado do conjunto: a árvore e a quantidade de valores (com
+// ESTATISTICA_ORDEM ela também está no tamanho da raiz)
+typedef struct {
+    ArvoreRN arvore;
+    long long tamanho;
+} ConjuntoRN;
+
+static void* criarConjuntoRN(void) {
+    ConjuntoRN *conjunto = (ConjuntoRN*)malloc(sizeof(ConjuntoRN));
+    if (conjunto == NULL) return NULL;
+    inicializarArvore(&conjunto->arvore);
+    conjunto->tamanho = 0;
+    return conjunto;
+}
+
+static bool inserirConjuntoRN(void *estado, int chave) {
+    ConjuntoRN *conjunto = (ConjuntoRN*)estado;
+    // inserirNo aceita repetidos; o conjunto não
+    if (buscar(&conjunto->arvore, chave)) return false;
+    if (inserirNo(&conjunto->arvore, chave) == NULL) return false;
+    conjunto->tamanho++;
+    return true;
+}
+
+static bool contemConjuntoRN(void *estado, int chave) {
+    return buscar(&((ConjuntoRN*)estado)->arvore, chave);
+}
+
+static bool removerConjuntoRN(void *estado, int chave) {
+    ConjuntoRN *conjunto = (ConjuntoRN*)estado;
+    if (!remover(&conjunto->arvore, chave)) return false;
+    conjunto->tamanho--;
+    return true;
+}
+
+// Em ordem pelos sucessores, sem recursão
+static void percorrerConjuntoRN(void *estado, ConjuntoVisitar visitar, void *contexto) {
+    ArvoreRN *arvore = &((ConjuntoRN*)estado)->arvore;
+    if (arvore->raiz == arvore->nulo) return;
+    for (No *no = encontrarMinimo(arvore, arvore->raiz); no != arvore->nulo; no = sucessor(arvore, no)) {
+        visitar(no->valor, contexto);
+    }
+}
+
+// Pelo iterador de intervalo: O(log n) até o primeiro valor, depois sucessores
+static void percorrerIntervaloRN(void *estado, int inicio, int fim, ConjuntoVisitar visitar, void *contexto) {
+    IteradorIntervalo iterador;
+    iniciarIntervalo(&iterador, &((ConjuntoRN*)estado)->arvore, inicio, fim);
+    for (No *no = proximoNoIntervalo(&iterador); no != NULL; no = proximoNoIntervalo(&iterador)) {
+        visitar(no->valor, contexto);
+    }
+}
+
+static long long tamanhoConjuntoRN(void *estado) {
+    return ((ConjuntoRN*)estado)->tamanho;
+}
+
+static int alturaConjuntoRN(void *estado) {
+    ArvoreRN *arvore = &((ConjuntoRN*)estado)->arvore;
+    return altura(arvore, arvore->raiz);
+}
+
+static Contadores* contadoresRN(void) {
+    return &contadores;
+}
+
+static void destruirConjuntoRN(void *estado) {
+    ArvoreRN *arvore = &((ConjuntoRN*)estado)->arvore;
+    liberarArvore(arvore, arvore->raiz);
+    free(arvore->nulo);
+    free(estado);
+}
+
+const OperacoesConjunto conjuntoRN = {
+    "Rubro-Negra", criarConjuntoRN, inserirConjuntoRN, contemConjuntoRN, removerConjuntoRN,
+    percorrerConjuntoRN, percorrerIntervaloRN, tamanhoConjuntoRN, alturaConjuntoRN, destruirConjuntoRN, contadoresRN
+};
+
 // FUNÇÕES AUXILIARES E MENU
 
 // Função para liberar toda a memória da árvore
-void liberarArvore(ArvoreRN *arvore, No *no) {
+static void liberarArvore(ArvoreRN *arvore, No *no) {
     if (no != arvore->nulo) {
         liberarArvore(arvore, no->esquerda);
         liberarArvore(arvore, no->direita);
         free(no);
+        CONTAR(contadores, liberacoes);
     }
 }
 
+#ifndef SEM_MAIN
+
 // Função para exibir o menu principal
-void exibirMenuPrincipal() {
+static void exibirMenuPrincipal() {
     printf("\n=== ÁRVORE RUBRO-NEGRA ===\n");
     printf("1 - Inserir valor\n");
     printf("2 - Buscar valor\n");
     printf("3 - Remover valor\n");
     printf("4 - Percorrer árvore\n");
+    printf("5 - Estatísticas de ordem\n");
+    printf("6 - Medir desempenho\n");
+    printf("7 - Medir inserção e busca com dica\n");
+    printf("8 - Operações de conjuntos\n");
+    printf("9 - Medir operações de conjuntos\n");
+    printf("10 - Listar valores de um intervalo\n");
+    printf("11 - Abrir log e recuperar\n");
+    printf("12 - Medir log e recuperação\n");
+    printf("13 - Contadores de instrumentação\n");
+    printf("14 - Medir carga em lote paralela\n");
+    printf("15 - Latências das operações do menu\n");
     printf("0 - Sair\n");
     printf("Escolha uma opção: ");
 }
 
 // Função para exibir o submenu de percursos
-void exibirSubmenuPercursos() {
+static void exibirSubmenuPercursos() {
     printf("\n--- TIPOS DE PERCURSO ---\n");
     printf("1 - Pré-ordem\n");
     printf("2 - Em ordem\n");
@@ -453,12 +1831,53 @@ void exibirSubmenuPercursos() {
     printf("Escolha o tipo de percurso: ");
 }
 
-// Função principal
-int main() {
+#if ESTATISTICA_ORDEM
+// Função para exibir o submenu de estatísticas de ordem
+static void exibirSubmenuEstatisticas() {
+    printf("\n--- ESTATÍSTICAS DE ORDEM ---\n");
+    printf("1 - k-ésimo menor valor\n");
+    printf("2 - Posição de um valor\n");
+    printf("3 - Contar valores em um intervalo\n");
+    printf("Escolha uma opção: ");
+}
+#endif
+
+// Função para exibir o submenu de operações de conjuntos
+static void exibirSubmenuConjuntos() {
+    printf("\n--- OPERAÇÕES DE CONJUNTOS ---\n");
+    printf("1 - União\n");
+    printf("2 - Interseção\n");
+    printf("3 - Diferença\n");
+    printf("Escolha a operação: ");
+}
+
+// Função principal. Com um nome de arquivo na linha de comando, as operações
+// de inserção, busca e remoção do menu são gravadas nele (rastro.h, replay.c).
+// Com -s e o caminho de um socket, a árvore atende pedidos pelo socket em vez
+// de abrir o menu (servidor.h, carga.c).
+int main(int argc, char **argv) {
+    // Modo servidor: arvoreRN -s caminho.sock
+    if (argc > 2 && strcmp(argv[1], "-s") == 0) {
+        return servirConjunto(&conjuntoRN, argv[2]);
+    }
+    
     ArvoreRN arvore;
     inicializarArvore(&arvore);
     
     int opcao, subOpcao, valor;
+    unsigned long long antes;
+    
+    // Latências das operações do menu (opção 15, e o relatório ao sair)
+    static LatenciasMenu latencias;
+    
+    // Log das operações (opção 11); cada operação do menu é confirmada na hora
+    static LogOperacoes logOperacoes;
+    bool logAtivo = false;
+    char base[200];
+    
+    // Rastro das operações, se o nome do arquivo vier na linha de comando
+    static Rastro rastro;
+    bool rastroAtivo = argc > 1 && rastroAbrir(&rastro, argv[1]);
     
     do {
         exibirMenuPrincipal();
@@ -468,13 +1887,33 @@ int main() {
             case 1:
                 printf("Digite o valor a ser inserido: ");
                 scanf("%d", &valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_INSERIR, valor);
+                }
+                // A árvore é um conjunto (como no log e em conjunto.h): repetidos não entram
+                antes = histogramaAgora();
+                if (buscar(&arvore, valor)) {
+                    printf("Valor %d já existe na árvore.\n", valor);
+                    break;
+                }
                 inserir(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                if (logAtivo) {
+                    registrarOperacao(&logOperacoes, &arvore, LOG_INSERIR, valor);
+                    logConfirmar(&logOperacoes);
+                }
                 break;
                 
             case 2:
                 printf("Digite o valor a ser buscado: ");
                 scanf("%d", &valor);
-                if (buscar(&arvore, valor)) {
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_BUSCAR, valor);
+                }
+                antes = histogramaAgora();
+                bool encontrado = buscar(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
+                if (encontrado) {
                     printf("Valor %d encontrado na árvore.\n", valor);
                 } else {
                     printf("Valor %d não encontrado na árvore.\n", valor);
@@ -484,7 +1923,17 @@ int main() {
             case 3:
                 printf("Digite o valor a ser removido: ");
                 scanf("%d", &valor);
-                if (remover(&arvore, valor)) {
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_REMOVER, valor);
+                }
+                antes = histogramaAgora();
+                bool removido = remover(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                if (removido) {
+                    if (logAtivo) {
+                        registrarOperacao(&logOperacoes, &arvore, LOG_REMOVER, valor);
+                        logConfirmar(&logOperacoes);
+                    }
                     printf("Valor %d removido da árvore.\n", valor);
                 } else {
                     printf("Valor %d não encontrado na árvore.\n", valor);
@@ -499,6 +1948,7 @@ int main() {
                     scanf("%d", &subOpcao);
                     
                     printf("Percorrendo árvore: ");
+                    antes = histogramaAgora();
                     switch (subOpcao) {
                         case 1:
                             preOrdem(&arvore, arvore.raiz);
@@ -515,9 +1965,192 @@ int main() {
                         default:
                             printf("Opção inválida!\n");
                     }
+                    if (subOpcao >= 1 && subOpcao <= 3) {
+                        latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    }
                 }
                 break;
                 
+            case 5:
+#if ESTATISTICA_ORDEM
+                exibirSubmenuEstatisticas();
+                scanf("%d", &subOpcao);
+                
+                switch (subOpcao) {
+                    case 1: {
+                        printf("Digite k (1 a %d): ", tamanhoArvore(&arvore));
+                        scanf("%d", &valor);
+                        No *no = selecionar(&arvore, valor);
+                        if (no != arvore.nulo) {
+                            printf("O %d-ésimo menor valor é %d.\n", valor, no->valor);
+                        } else {
+                            printf("Posição inválida!\n");
+                        }
+                        break;
+                    }
+                    case 2:
+                        printf("Digite o valor: ");
+                        scanf("%d", &valor);
+                        if (buscar(&arvore, valor)) {
+                            printf("Valor %d está na posição %d.\n", valor, contarMenores(&arvore, valor) + 1);
+                        } else {
+                            printf("Valor %d não encontrado; %d valores são menores.\n", valor, contarMenores(&arvore, valor));
+                        }
+                        break;
+                    case 3: {
+                        int fim;
+                        printf("Digite o início e o fim do intervalo: ");
+                        scanf("%d %d", &valor, &fim);
+                        printf("%d valores em [%d, %d].\n", contarIntervalo(&arvore, valor, fim), valor, fim);
+                        break;
+                    }
+                    default:
+                        printf("Opção inválida!\n");
+                }
+#else
+                printf("Compilado sem estatísticas de ordem (ESTATISTICA_ORDEM=0).\n");
+#endif
+                break;
+                
+            case 6:
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                if (valor > 0) {
+                    medirDesempenho(valor);
+                }
+                break;
+                
+            case 7:
+                printf("Quantidade de valores: ");
+                scanf("%d", &valor);
+                if (valor > 0) {
+                    medirInsercaoComDica(valor);
+                }
+                break;
+                
+            case 8:
+                exibirSubmenuConjuntos();
+                scanf("%d", &subOpcao);
+                if (subOpcao < 1 || subOpcao > 3) {
+                    printf("Opção inválida!\n");
+                } else {
+                    ArvoreRN outra;
+                    inicializarArvore(&outra);
+                    int quantidade;
+                    printf("Quantidade de valores do outro conjunto: ");
+                    scanf("%d", &quantidade);
+                    printf("Digite os valores: ");
+                    for (int i = 0; i < quantidade; i++) {
+                        scanf("%d", &valor);
+                        if (!buscar(&outra, valor)) {
+                            inserirNo(&outra, valor);
+                        }
+                    }
+                    
+                    if (subOpcao == 1) {
+                        uniao(&arvore, &outra, 1);
+                    } else if (subOpcao == 2) {
+                        intersecao(&arvore, &outra, 1);
+                    } else {
+                        diferenca(&arvore, &outra, 1);
+                    }
+                    free(outra.nulo);
+                    
+                    // O resultado não passa pelo log: vira o novo instantâneo
+                    if (logAtivo) {
+                        gravarInstantaneo(&logOperacoes, &arvore);
+                    }
+
+                    printf("Resultado: ");
+                    emOrdem(&arvore, arvore.raiz);
+                    printf("\n");
+                }
+                break;
+                
+            case 9:
+                printf("Tamanho dos dois conjuntos: ");
+                scanf("%d %d", &valor, &subOpcao);
+                if (valor > 0 && subOpcao > 0) {
+                    medirOperacoesConjuntos(valor, subOpcao);
+                }
+                break;
+                
+            case 10: {
+                int fim;
+                printf("Digite o início e o fim do intervalo: ");
+                scanf("%d %d", &valor, &fim);
+                
+                IteradorIntervalo iterador;
+                iniciarIntervalo(&iterador, &arvore, valor, fim);
+                printf("Valores em [%d, %d]: ", valor, fim);
+                for (No *no = proximoNoIntervalo(&iterador); no != NULL; no = proximoNoIntervalo(&iterador)) {
+                    printf("%d ", no->valor);
+                }
+                printf("\n");
+                
+                // Vizinhos do intervalo: o maior valor antes dele e o menor depois
+                No *primeiro = limiteInferior(&arvore, valor);
+                No *anterior = arvore.nulo;
+                if (primeiro != arvore.nulo) {
+                    anterior = predecessor(&arvore, primeiro);
+                } else if (!arvoreVazia(&arvore)) {
+                    anterior = encontrarMaximo(&arvore, arvore.raiz);
+                }
+                No *seguinte = limiteSuperior(&arvore, fim > valor ? fim : valor);
+                if (anterior != arvore.nulo) {
+                    printf("Anterior ao intervalo: %d\n", anterior->valor);
+                }
+                if (seguinte != arvore.nulo) {
+                    printf("Seguinte ao intervalo: %d\n", seguinte->valor);
+                }
+                break;
+            }
+                
+            case 11:
+                printf("Nome base dos arquivos do log: ");
+                scanf("%199s", base);
+                if (logAtivo) {
+                    gravarInstantaneo(&logOperacoes, &arvore);
+                    logFechar(&logOperacoes);
+                }
+                // A árvore atual é substituída pela recuperada
+                logAtivo = abrirLog(&logOperacoes, &arvore, base, 1, INTERVALO_INSTANTANEO);
+                break;
+                
+            case 12: {
+                int grupo;
+                printf("Quantidade de operações: ");
+                scanf("%d", &valor);
+                printf("Operações por sincronização do log: ");
+                scanf("%d", &grupo);
+                if (valor > 0) {
+                    medirLog(valor, grupo);
+                }
+                break;
+            }
+                
+            case 13:
+                // Contagem desde a última consulta (ou desde o início)
+                imprimirContadores(&contadores);
+                zerarContadores(&contadores);
+                break;
+                
+            case 14: {
+                int maxThreads;
+                printf("Quantidade de chaves: ");
+                scanf("%d", &valor);
+                printf("Máximo de threads: ");
+                scanf("%d", &maxThreads);
+                if (valor > 0 && maxThreads > 0) {
+                    medirConstrucaoParalela(valor, maxThreads);
+                }
+                break;
+            }
+                
+            case 15:
+                latenciasImprimir(&latencias);
+                break;
+                
             case 0:
                 printf("Encerrando programa...\n");
                 break;
@@ -528,10 +2161,30 @@ int main() {
         
     } while (opcao != 0);
     
+    // Instantâneo final: o próximo início não precisa reaplicar o log
+    if (logAtivo) {
+        gravarInstantaneo(&logOperacoes, &arvore);
+        logFechar(&logOperacoes);
+    }
+    
+    if (rastroAtivo) {
+        if (rastroFechar(&rastro)) {
+            printf("Rastro com %lld operações gravado em %s.\n", rastro.operacoes, argv[1]);
+        } else {
+            printf("Erro: Falha ao gravar o rastro %s!\n", argv[1]);
+        }
+    }
+    
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+    
     // Liberar toda a memória alocada
     liberarArvore(&arvore, arvore.raiz);
     free(arvore.nulo);
     printf("Memória liberada. Programa encerrado.\n");
     
     return 0;
-}
\ No newline at end of file
+}
+
+#endif
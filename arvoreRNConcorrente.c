@@ -0,0 +1,813 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include "histograma.h"
+
+// Árvore Rubro-Negra concorrente: leituras otimistas sem travas e um escritor
+// por vez (protegido por uma trava de escrita).
+// O escritor incrementa um contador de sequência antes e depois de cada
+// mudança estrutural que pode esconder um valor de quem está descendo
+// (rotações e a troca pelo sucessor na remoção). O leitor guarda a sequência
+// antes de descer e só refaz a busca se ela mudou no meio do caminho.
+// Nós removidos só são liberados quando nenhum leitor pode mais enxergá-los
+// (recuperação por épocas).
+//
+// Compilar com: gcc arvoreRNConcorrente.c -o arvoreRNConcorrente -pthread
+
+// Leitura e escrita de campos compartilhados com os leitores
+#define LER(campo) __atomic_load_n(&(campo), __ATOMIC_ACQUIRE)
+#define ESCREVER(campo, valor) __atomic_store_n(&(campo), (valor), __ATOMIC_RELEASE)
+
+#define MAX_LEITORES 64   // Quantidade máxima de threads leitoras registradas
+#define ALTURA_MAXIMA 128 // Limite de passos na descida de um leitor
+#define LINHA_CACHE 64
+
+// Cores para os nós da árvore
+typedef enum { VERMELHO, NEGRO } Cor;
+
+// Estrutura do nó da Árvore Rubro-Negra
+typedef struct No {
+    int valor;
+    Cor cor;
+    struct No *esquerda;
+    struct No *direita;
+    struct No *pai;         // Usado apenas pelo escritor
+    struct No *proximoLixo; // Lista de nós aguardando liberação
+    unsigned long epoca;    // Época em que o nó foi removido
+} No;
+
+// Época anunciada por um leitor, numa linha de cache só dela: cada leitor
+// escreve a sua duas vezes por busca e não pode invalidar a dos outros
+typedef struct {
+    _Alignas(LINHA_CACHE) atomic_ulong epoca;   // 0 = leitor fora de uma leitura
+} EpocaLeitor;
+
+// Estrutura da Árvore Rubro-Negra Concorrente. Os campos que o escritor muda
+// e os leitores leem a cada busca ficam em linhas de cache separadas.
+typedef struct {
+    No *raiz;
+    No *nulo;                       // Nó nulo (folhas)
+    _Alignas(LINHA_CACHE) atomic_uint sequencia;    // Ímpar enquanto há mudança estrutural
+    _Alignas(LINHA_CACHE) atomic_ulong epocaGlobal;
+    EpocaLeitor epocaLeitor[MAX_LEITORES];
+    pthread_mutex_t escrita;        // Serializa os escritores
+    No *lixo;                       // Nós removidos ainda não liberados
+    int quantidadeLixo;
+    atomic_ulong repeticoes;        // Leituras refeitas por causa de rotações
+} ArvoreConcorrente;
+
+// Função para criar um nó nulo (todas as folhas são nulos)
+No* criarNoNulo(No *pai) {
+    No *no = (No*)malloc(sizeof(No));
+    no->valor = 0;
+    no->cor = NEGRO;
+    no->esquerda = NULL;
+    no->direita = NULL;
+    no->pai = pai;
+    no->proximoLixo = NULL;
+    no->epoca = 0;
+    return no;
+}
+
+// Função para inicializar a árvore
+void inicializarArvore(ArvoreConcorrente *arvore) {
+    arvore->nulo = criarNoNulo(NULL);
+    arvore->raiz = arvore->nulo;
+    atomic_init(&arvore->sequencia, 0);
+    pthread_mutex_init(&arvore->escrita, NULL);
+    atomic_init(&arvore->epocaGlobal, 1);
+    for (int i = 0; i < MAX_LEITORES; i++) {
+        atomic_init(&arvore->epocaLeitor[i].epoca, 0);
+    }
+    arvore->lixo = NULL;
+    arvore->quantidadeLixo = 0;
+    atomic_init(&arvore->repeticoes, 0);
+}
+
+// Função para criar um novo nó
+No* criarNo(int valor) {
+    No *novoNo = (No*)malloc(sizeof(No));
+    if (novoNo == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return NULL;
+    }
+    novoNo->valor = valor;
+    novoNo->cor = VERMELHO;  // Novo nó é sempre vermelho
+    novoNo->esquerda = NULL;
+    novoNo->direita = NULL;
+    novoNo->pai = NULL;
+    novoNo->proximoLixo = NULL;
+    novoNo->epoca = 0;
+    return novoNo;
+}
+
+// Função para verificar se a árvore está vazia
+int arvoreVazia(ArvoreConcorrente *arvore) {
+    return LER(arvore->raiz) == arvore->nulo;
+}
+
+// SEQUÊNCIA (escritor)
+
+// Marcar o início de uma mudança estrutural (sequência fica ímpar)
+void iniciarMudanca(ArvoreConcorrente *arvore) {
+    atomic_fetch_add_explicit(&arvore->sequencia, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+// Marcar o fim de uma mudança estrutural (sequência volta a ser par)
+void terminarMudanca(ArvoreConcorrente *arvore) {
+    atomic_fetch_add_explicit(&arvore->sequencia, 1, memory_order_release);
+}
+
+// RECUPERAÇÃO POR ÉPOCAS
+
+// Leitor anuncia a época em que começou a ler
+void entrarLeitura(ArvoreConcorrente *arvore, int leitor) {
+    atomic_store(&arvore->epocaLeitor[leitor].epoca, atomic_load(&arvore->epocaGlobal));
+    atomic_thread_fence(memory_order_seq_cst);  // Anúncio visível antes da descida
+}
+
+// Leitor anuncia que não guarda mais ponteiros para nós
+void sairLeitura(ArvoreConcorrente *arvore, int leitor) {
+    atomic_store_explicit(&arvore->epocaLeitor[leitor].epoca, 0, memory_order_release);
+}
+
+// Liberar os nós removidos que nenhum leitor ativo pode estar visitando
+void coletarLixo(ArvoreConcorrente *arvore) {
+    unsigned long menorEpoca = atomic_fetch_add(&arvore->epocaGlobal, 1) + 1;
+    for (int i = 0; i < MAX_LEITORES; i++) {
+        unsigned long epoca = atomic_load(&arvore->epocaLeitor[i].epoca);
+        if (epoca != 0 && epoca < menorEpoca) {
+            menorEpoca = epoca;
+        }
+    }
+
+    No **atual = &arvore->lixo;
+    while (*atual != NULL) {
+        No *no = *atual;
+        if (no->epoca < menorEpoca) {
+            *atual = no->proximoLixo;
+            free(no);
+            arvore->quantidadeLixo--;
+        } else {
+            atual = &no->proximoLixo;
+        }
+    }
+}
+
+// Adiar a liberação de um nó removido
+void descartarNo(ArvoreConcorrente *arvore, No *no) {
+    no->epoca = atomic_load(&arvore->epocaGlobal);
+    no->proximoLixo = arvore->lixo;
+    arvore->lixo = no;
+    arvore->quantidadeLixo++;
+
+    if (arvore->quantidadeLixo >= 64) {
+        coletarLixo(arvore);
+    }
+}
+
+// ROTAÇÕES
+
+// Rotação à esquerda
+void rotacaoEsquerda(ArvoreConcorrente *arvore, No *x) {
+    No *y = x->direita;
+
+    iniciarMudanca(arvore);
+    ESCREVER(x->direita, y->esquerda);
+
+    if (y->esquerda != arvore->nulo) {
+        y->esquerda->pai = x;
+    }
+
+    y->pai = x->pai;
+
+    if (x->pai == arvore->nulo) {
+        ESCREVER(arvore->raiz, y);
+    } else if (x == x->pai->esquerda) {
+        ESCREVER(x->pai->esquerda, y);
+    } else {
+        ESCREVER(x->pai->direita, y);
+    }
+
+    ESCREVER(y->esquerda, x);
+    x->pai = y;
+    terminarMudanca(arvore);
+}
+
+// Rotação à direita
+void rotacaoDireita(ArvoreConcorrente *arvore, No *y) {
+    No *x = y->esquerda;
+
+    iniciarMudanca(arvore);
+    ESCREVER(y->esquerda, x->direita);
+
+    if (x->direita != arvore->nulo) {
+        x->direita->pai = y;
+    }
+
+    x->pai = y->pai;
+
+    if (y->pai == arvore->nulo) {
+        ESCREVER(arvore->raiz, x);
+    } else if (y == y->pai->esquerda) {
+        ESCREVER(y->pai->esquerda, x);
+    } else {
+        ESCREVER(y->pai->direita, x);
+    }
+
+    ESCREVER(x->direita, y);
+    y->pai = x;
+    terminarMudanca(arvore);
+}
+
+// FUNÇÕES AUXILIARES
+
+// Encontrar o nó com menor valor
+No* encontrarMinimo(ArvoreConcorrente *arvore, No *no) {
+    while (no->esquerda != arvore->nulo) {
+        no = no->esquerda;
+    }
+    return no;
+}
+
+// Buscar um nó na árvore (somente o escritor)
+No* buscarNo(ArvoreConcorrente *arvore, int valor) {
+    No *no = arvore->raiz;
+    while (no != arvore->nulo && valor != no->valor) {
+        no = valor < no->valor ? no->esquerda : no->direita;
+    }
+    return no;
+}
+
+// CORREÇÃO DE INSERÇÃO
+
+// Corrigir violações após inserção
+void corrigirInsercao(ArvoreConcorrente *arvore, No *k) {
+    No *tio;
+
+    while (k->pai->cor == VERMELHO) {
+        // Caso: Pai é filho esquerdo do avô
+        if (k->pai == k->pai->pai->esquerda) {
+            tio = k->pai->pai->direita;
+
+            // CASO 1: Tio é vermelho
+            if (tio->cor == VERMELHO) {
+                k->pai->cor = NEGRO;
+                tio->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                k = k->pai->pai;
+            } else {
+                // CASO 2: k é filho direito
+                if (k == k->pai->direita) {
+                    k = k->pai;
+                    rotacaoEsquerda(arvore, k);
+                }
+
+                // CASO 3: k é filho esquerdo
+                k->pai->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                rotacaoDireita(arvore, k->pai->pai);
+            }
+        }
+        // Caso: Pai é filho direito do avô (simétrico)
+        else {
+            tio = k->pai->pai->esquerda;
+
+            // CASO 1: Tio é vermelho
+            if (tio->cor == VERMELHO) {
+                k->pai->cor = NEGRO;
+                tio->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                k = k->pai->pai;
+            } else {
+                // CASO 2: k é filho esquerdo
+                if (k == k->pai->esquerda) {
+                    k = k->pai;
+                    rotacaoDireita(arvore, k);
+                }
+
+                // CASO 3: k é filho direito
+                k->pai->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                rotacaoEsquerda(arvore, k->pai->pai);
+            }
+        }
+
+        if (k == arvore->raiz) {
+            break;
+        }
+    }
+
+    arvore->raiz->cor = NEGRO;  // Regra 2: raiz sempre negra
+}
+
+// INSERÇÃO
+
+// Inserir um valor (valores repetidos são ignorados); retorna 1 se inseriu
+int inserir(ArvoreConcorrente *arvore, int valor) {
+    pthread_mutex_lock(&arvore->escrita);
+
+    No *y = arvore->nulo;
+    No *x = arvore->raiz;
+
+    while (x != arvore->nulo) {
+        y = x;
+        if (valor == x->valor) {
+            pthread_mutex_unlock(&arvore->escrita);
+            return 0;
+        }
+        x = valor < x->valor ? x->esquerda : x->direita;
+    }
+
+    No *novoNo = criarNo(valor);
+    if (novoNo == NULL) {
+        pthread_mutex_unlock(&arvore->escrita);
+        return 0;
+    }
+    novoNo->esquerda = arvore->nulo;
+    novoNo->direita = arvore->nulo;
+    novoNo->pai = y;
+
+    // Pendurar uma folha nova não esconde nenhum valor: sem mudança de sequência
+    if (y == arvore->nulo) {
+        novoNo->cor = NEGRO;
+        ESCREVER(arvore->raiz, novoNo);
+    } else if (valor < y->valor) {
+        ESCREVER(y->esquerda, novoNo);
+    } else {
+        ESCREVER(y->direita, novoNo);
+    }
+
+    if (y != arvore->nulo && y->pai != arvore->nulo) {
+        corrigirInsercao(arvore, novoNo);
+    }
+
+    pthread_mutex_unlock(&arvore->escrita);
+    return 1;
+}
+
+// BUSCA
+
+// Buscar um valor sem travas; leitor é o índice da thread (0 a MAX_LEITORES-1)
+int buscar(ArvoreConcorrente *arvore, int leitor, int valor) {
+    int encontrado;
+    entrarLeitura(arvore, leitor);
+
+    for (;;) {
+        unsigned int sequencia = atomic_load_explicit(&arvore->sequencia, memory_order_acquire);
+        if (sequencia & 1) {
+            continue;  // Rotação em andamento
+        }
+
+        encontrado = 0;
+        No *no = LER(arvore->raiz);
+        for (int passos = 0; no != arvore->nulo && passos < ALTURA_MAXIMA; passos++) {
+            int valorNo = LER(no->valor);
+            if (valor == valorNo) {
+                encontrado = 1;
+                break;
+            }
+            no = valor < valorNo ? LER(no->esquerda) : LER(no->direita);
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&arvore->sequencia, memory_order_relaxed) == sequencia) {
+            break;
+        }
+        atomic_fetch_add_explicit(&arvore->repeticoes, 1, memory_order_relaxed);
+    }
+
+    sairLeitura(arvore, leitor);
+    return encontrado;
+}
+
+// CORREÇÃO DE REMOÇÃO
+
+// Corrigir violações após remoção
+void corrigirRemocao(ArvoreConcorrente *arvore, No *x) {
+    No *irmao;
+
+    while (x != arvore->raiz && x->cor == NEGRO) {
+        if (x == x->pai->esquerda) {
+            irmao = x->pai->direita;
+
+            // CASO 1: Irmão é vermelho
+            if (irmao->cor == VERMELHO) {
+                irmao->cor = NEGRO;
+                x->pai->cor = VERMELHO;
+                rotacaoEsquerda(arvore, x->pai);
+                irmao = x->pai->direita;
+            }
+
+            // CASO 2: Ambos os filhos do irmão são negros
+            if (irmao->esquerda->cor == NEGRO && irmao->direita->cor == NEGRO) {
+                irmao->cor = VERMELHO;
+                x = x->pai;
+            } else {
+                // CASO 3: Filho esquerdo do irmão é vermelho, direito é negro
+                if (irmao->direita->cor == NEGRO) {
+                    irmao->esquerda->cor = NEGRO;
+                    irmao->cor = VERMELHO;
+                    rotacaoDireita(arvore, irmao);
+                    irmao = x->pai->direita;
+                }
+
+                // CASO 4: Filho direito do irmão é vermelho
+                irmao->cor = x->pai->cor;
+                x->pai->cor = NEGRO;
+                irmao->direita->cor = NEGRO;
+                rotacaoEsquerda(arvore, x->pai);
+                x = arvore->raiz;
+            }
+        } else {
+            // Caso simétrico
+            irmao = x->pai->esquerda;
+
+            // CASO 1: Irmão é vermelho
+            if (irmao->cor == VERMELHO) {
+                irmao->cor = NEGRO;
+                x->pai->cor = VERMELHO;
+                rotacaoDireita(arvore, x->pai);
+                irmao = x->pai->esquerda;
+            }
+
+            // CASO 2: Ambos os filhos do irmão são negros
+            if (irmao->direita->cor == NEGRO && irmao->esquerda->cor == NEGRO) {
+                irmao->cor = VERMELHO;
+                x = x->pai;
+            } else {
+                // CASO 3: Filho direito do irmão é vermelho, esquerdo é negro
+                if (irmao->esquerda->cor == NEGRO) {
+                    irmao->direita->cor = NEGRO;
+                    irmao->cor = VERMELHO;
+                    rotacaoEsquerda(arvore, irmao);
+                    irmao = x->pai->esquerda;
+                }
+
+                // CASO 4: Filho esquerdo do irmão é vermelho
+                irmao->cor = x->pai->cor;
+                x->pai->cor = NEGRO;
+                irmao->esquerda->cor = NEGRO;
+                rotacaoDireita(arvore, x->pai);
+                x = arvore->raiz;
+            }
+        }
+    }
+
+    x->cor = NEGRO;
+}
+
+// Substituir um nó por outro na árvore
+void transplantar(ArvoreConcorrente *arvore, No *u, No *v) {
+    if (u->pai == arvore->nulo) {
+        ESCREVER(arvore->raiz, v);
+    } else if (u == u->pai->esquerda) {
+        ESCREVER(u->pai->esquerda, v);
+    } else {
+        ESCREVER(u->pai->direita, v);
+    }
+    v->pai = u->pai;
+}
+
+// REMOÇÃO
+
+// Remover um valor da árvore
+int remover(ArvoreConcorrente *arvore, int valor) {
+    pthread_mutex_lock(&arvore->escrita);
+
+    No *z = buscarNo(arvore, valor);
+    if (z == arvore->nulo) {
+        pthread_mutex_unlock(&arvore->escrita);
+        return 0;  // Valor não encontrado
+    }
+
+    No *y = z;
+    No *x;
+    Cor corOriginalY = y->cor;
+
+    // Com no máximo um filho, o filho apenas sobe: nenhum valor fica escondido
+    if (z->esquerda == arvore->nulo) {
+        x = z->direita;
+        transplantar(arvore, z, z->direita);
+    } else if (z->direita == arvore->nulo) {
+        x = z->esquerda;
+        transplantar(arvore, z, z->esquerda);
+    } else {
+        // O sucessor muda de lugar: leitores que estiverem descendo refazem
+        iniciarMudanca(arvore);
+        y = encontrarMinimo(arvore, z->direita);
+        corOriginalY = y->cor;
+        x = y->direita;
+
+        if (y->pai == z) {
+            x->pai = y;
+        } else {
+            transplantar(arvore, y, y->direita);
+            ESCREVER(y->direita, z->direita);
+            y->direita->pai = y;
+        }
+
+        transplantar(arvore, z, y);
+        ESCREVER(y->esquerda, z->esquerda);
+        y->esquerda->pai = y;
+        y->cor = z->cor;
+        terminarMudanca(arvore);
+    }
+
+    descartarNo(arvore, z);
+
+    if (corOriginalY == NEGRO) {
+        corrigirRemocao(arvore, x);
+    }
+
+    pthread_mutex_unlock(&arvore->escrita);
+    return 1;  // Remoção bem-sucedida
+}
+
+// PERCURSOS
+
+// Em ordem: Esquerda → Raiz → Direita (chamar sem escritores ativos)
+void emOrdem(ArvoreConcorrente *arvore, No *no) {
+    if (no != arvore->nulo) {
+        emOrdem(arvore, no->esquerda);
+        printf("%d(%s) ", no->valor, no->cor == VERMELHO ? "V" : "N");
+        emOrdem(arvore, no->direita);
+    }
+}
+
+// Função para liberar toda a memória da árvore
+void liberarNos(ArvoreConcorrente *arvore, No *no) {
+    if (no != arvore->nulo) {
+        liberarNos(arvore, no->esquerda);
+        liberarNos(arvore, no->direita);
+        free(no);
+    }
+}
+
+// Liberar a árvore inteira (sem leitores nem escritores ativos)
+void liberarArvore(ArvoreConcorrente *arvore) {
+    liberarNos(arvore, arvore->raiz);
+    while (arvore->lixo != NULL) {
+        No *proximo = arvore->lixo->proximoLixo;
+        free(arvore->lixo);
+        arvore->lixo = proximo;
+    }
+    free(arvore->nulo);
+    pthread_mutex_destroy(&arvore->escrita);
+}
+
+// MEDIÇÃO DE DESEMPENHO
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Instante atual em segundos (relógio de parede)
+double agora() {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return instante.tv_sec + instante.tv_nsec / 1e9;
+}
+
+// Parâmetros compartilhados pelas threads de uma medição
+typedef struct {
+    ArvoreConcorrente *arvore;
+    pthread_rwlock_t *trava;  // NULL = leitura otimista; senão trava de leitura
+    int indice;
+    int limite;               // Valores buscados ficam em [0, limite)
+    atomic_int *parar;
+    long leituras;
+} Trabalho;
+
+// Thread leitora: busca valores aleatórios até receber o sinal de parada
+void* executarLeitor(void *argumento) {
+    Trabalho *trabalho = (Trabalho*)argumento;
+    unsigned int estado = 2463534242u + trabalho->indice * 7919u;
+    long leituras = 0;
+
+    while (!atomic_load_explicit(trabalho->parar, memory_order_relaxed)) {
+        int valor = (int)(proximoAleatorio(&estado) % trabalho->limite);
+        if (trabalho->trava == NULL) {
+            buscar(trabalho->arvore, trabalho->indice, valor);
+        } else {
+            pthread_rwlock_rdlock(trabalho->trava);
+            buscar(trabalho->arvore, trabalho->indice, valor);
+            pthread_rwlock_unlock(trabalho->trava);
+        }
+        leituras++;
+    }
+
+    trabalho->leituras = leituras;
+    return NULL;
+}
+
+// Thread escritora: insere e remove valores aleatórios até a parada
+void* executarEscritor(void *argumento) {
+    Trabalho *trabalho = (Trabalho*)argumento;
+    unsigned int estado = 88675123u;
+    long escritas = 0;
+
+    while (!atomic_load_explicit(trabalho->parar, memory_order_relaxed)) {
+        int valor = (int)(proximoAleatorio(&estado) % trabalho->limite);
+        if (trabalho->trava != NULL) pthread_rwlock_wrlock(trabalho->trava);
+        if (escritas % 2 == 0) {
+            inserir(trabalho->arvore, valor);
+        } else {
+            remover(trabalho->arvore, valor);
+        }
+        if (trabalho->trava != NULL) pthread_rwlock_unlock(trabalho->trava);
+        escritas++;
+    }
+
+    trabalho->leituras = escritas;
+    return NULL;
+}
+
+// Medir leituras por segundo com t leitores e um escritor durante segundos
+double medirLeituras(ArvoreConcorrente *arvore, pthread_rwlock_t *trava,
+                     int t, int limite, double segundos, long *escritas) {
+    pthread_t threads[MAX_LEITORES + 1];
+    Trabalho trabalhos[MAX_LEITORES + 1];
+    atomic_int parar;
+    atomic_init(&parar, 0);
+
+    for (int i = 0; i <= t; i++) {
+        trabalhos[i].arvore = arvore;
+        trabalhos[i].trava = trava;
+        trabalhos[i].indice = i;
+        trabalhos[i].limite = limite;
+        trabalhos[i].parar = &parar;
+        trabalhos[i].leituras = 0;
+    }
+
+    double inicio = agora();
+    for (int i = 0; i < t; i++) {
+        pthread_create(&threads[i], NULL, executarLeitor, &trabalhos[i]);
+    }
+    pthread_create(&threads[t], NULL, executarEscritor, &trabalhos[t]);
+
+    while (agora() - inicio < segundos) {
+        struct timespec pausa = { 0, 10000000 };
+        nanosleep(&pausa, NULL);
+    }
+    atomic_store(&parar, 1);
+
+    long total = 0;
+    for (int i = 0; i <= t; i++) {
+        pthread_join(threads[i], NULL);
+        if (i < t) total += trabalhos[i].leituras;
+    }
+    *escritas = trabalhos[t].leituras;
+    return total / (agora() - inicio);
+}
+
+// Curva de escalabilidade de leitura: 1 a 64 leitores, otimista x trava de leitura
+void medirEscalabilidade(int n) {
+    ArvoreConcorrente teste;
+    inicializarArvore(&teste);
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        inserir(&teste, (int)(proximoAleatorio(&estado) % (2 * n)));
+    }
+
+    pthread_rwlock_t trava;
+    pthread_rwlock_init(&trava, NULL);
+
+    printf("leitores;otimista_leituras_s;trava_leituras_s;escritas_otimista;escritas_trava;repeticoes\n");
+    for (int t = 1; t <= MAX_LEITORES; t *= 2) {
+        long escritasOtimista, escritasTrava;
+        atomic_store(&teste.repeticoes, 0);
+        double otimista = medirLeituras(&teste, NULL, t, 2 * n, 1.0, &escritasOtimista);
+        unsigned long repeticoes = atomic_load(&teste.repeticoes);
+        double comTrava = medirLeituras(&teste, &trava, t, 2 * n, 1.0, &escritasTrava);
+        printf("%d;%.0f;%.0f;%ld;%ld;%lu\n", t, otimista, comTrava,
+               escritasOtimista, escritasTrava, repeticoes);
+    }
+
+    pthread_rwlock_destroy(&trava);
+    liberarArvore(&teste);
+}
+
+// FUNÇÕES DE MENU
+
+// Função para exibir o menu principal
+void exibirMenuPrincipal() {
+    printf("\n=== ÁRVORE RUBRO-NEGRA CONCORRENTE ===\n");
+    printf("1 - Inserir valor\n");
+    printf("2 - Buscar valor\n");
+    printf("3 - Remover valor\n");
+    printf("4 - Percorrer árvore\n");
+    printf("5 - Medir escalabilidade de leitura\n");
+    printf("6 - Latências das operações do menu\n");
+    printf("0 - Sair\n");
+    printf("Escolha uma opção: ");
+}
+
+// Função principal
+int main() {
+    ArvoreConcorrente arvore;
+    inicializarArvore(&arvore);
+
+    int opcao, valor, ok;
+    unsigned long long antes;
+
+    // Latências das operações do menu (opção 6, e o relatório ao sair)
+    static LatenciasMenu latencias;
+
+    do {
+        exibirMenuPrincipal();
+        scanf("%d", &opcao);
+
+        switch (opcao) {
+            case 1:
+                printf("Digite o valor a ser inserido: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                ok = inserir(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                if (ok) {
+                    printf("Valor %d inserido.\n", valor);
+                } else {
+                    printf("Valor %d já existe na árvore.\n", valor);
+                }
+                break;
+
+            case 2:
+                printf("Digite o valor a ser buscado: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                ok = buscar(&arvore, 0, valor);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
+                if (ok) {
+                    printf("Valor %d encontrado na árvore.\n", valor);
+                } else {
+                    printf("Valor %d não encontrado na árvore.\n", valor);
+                }
+                break;
+
+            case 3:
+                printf("Digite o valor a ser removido: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                ok = remover(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                if (ok) {
+                    printf("Valor %d removido da árvore.\n", valor);
+                } else {
+                    printf("Valor %d não encontrado na árvore.\n", valor);
+                }
+                break;
+
+            case 4:
+                if (arvoreVazia(&arvore)) {
+                    printf("Árvore vazia!\n");
+                } else {
+                    printf("Percorrendo em ordem: ");
+                    antes = histogramaAgora();
+                    emOrdem(&arvore, arvore.raiz);
+                    latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    printf("\n");
+                }
+                break;
+
+            case 5:
+                printf("Quantidade de valores na árvore: ");
+                scanf("%d", &valor);
+                if (valor > 0) {
+                    medirEscalabilidade(valor);
+                }
+                break;
+
+            case 6:
+                latenciasImprimir(&latencias);
+                break;
+
+            case 0:
+                printf("Encerrando programa...\n");
+                break;
+
+            default:
+                printf("Opção inválida! Tente novamente.\n");
+        }
+
+    } while (opcao != 0);
+
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+
+    // Liberar toda a memória alocada
+    liberarArvore(&arvore);
+    printf("Memória liberada. Programa encerrado.\n");
+
+    return 0;
+}
@@ -0,0 +1,282 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "histograma.h"
+
+// Exemplos de instâncias da árvore rubro-negra genérica (arvoreRNGenerica.h)
+// e medição da instância de int com a mesma carga do "Medir desempenho" de
+// arvoreRN.c, para comparar com a versão escrita à mão.
+
+// Chaves int (mesma árvore de arvoreRN.c)
+#define ARVORE_NOME ArvoreInt
+#define ARVORE_CHAVE int
+#define ARVORE_VALOR int
+#define ARVORE_MENOR(a, b) ((a) < (b))
+#define ARVORE_IGUAL(a, b) ((a) == (b))
+#include "arvoreRNGenerica.h"
+
+// Chaves de 64 bits
+#define ARVORE_NOME ArvoreLonga
+#define ARVORE_CHAVE long long
+#define ARVORE_VALOR int
+#define ARVORE_MENOR(a, b) ((a) < (b))
+#define ARVORE_IGUAL(a, b) ((a) == (b))
+#include "arvoreRNGenerica.h"
+
+// Chaves de texto, com contagem de ocorrências como valor
+#define ARVORE_NOME ArvoreTexto
+#define ARVORE_CHAVE char*
+#define ARVORE_VALOR int
+#define ARVORE_MENOR(a, b) (strcmp((a), (b)) < 0)
+#define ARVORE_IGUAL(a, b) (strcmp((a), (b)) == 0)
+#include "arvoreRNGenerica.h"
+
+#define TAMANHO_TEXTO 100
+
+// MEDIÇÃO DE DESEMPENHO
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Segundos decorridos desde o instante inicio
+double segundosDesde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Medir inserção, busca e remoção de n valores aleatórios com chaves int
+// (mesmos valores e mesma ordem da medição de arvoreRN.c)
+void medirDesempenhoInt(int n) {
+    ArvoreInt teste;
+    ArvoreIntInicializar(&teste);
+
+    int *valores = (int*)malloc(sizeof(int) * n);
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        valores[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        ArvoreIntInserir(&teste, valores[i], i);
+    }
+    double tempoInsercao = segundosDesde(inicio);
+
+    int encontrados = 0;
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        encontrados += ArvoreIntBuscar(&teste, valores[i]) != NULL;
+    }
+    double tempoBusca = segundosDesde(inicio);
+
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        ArvoreIntRemover(&teste, valores[i]);
+    }
+    double tempoRemocao = segundosDesde(inicio);
+
+    printf("Chaves int (genérica)\n");
+    printf("Inserção: %.3f s (%.1f ns/op)\n", tempoInsercao, tempoInsercao * 1e9 / n);
+    printf("Busca:    %.3f s (%.1f ns/op, %d encontrados)\n", tempoBusca, tempoBusca * 1e9 / n, encontrados);
+    printf("Remoção:  %.3f s (%.1f ns/op)\n", tempoRemocao, tempoRemocao * 1e9 / n);
+
+    ArvoreIntLiberar(&teste);
+    free(valores);
+}
+
+// Mesma medição com chaves de 64 bits espalhadas por todo o intervalo
+void medirDesempenhoLonga(int n) {
+    ArvoreLonga teste;
+    ArvoreLongaInicializar(&teste);
+
+    long long *valores = (long long*)malloc(sizeof(long long) * n);
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        unsigned long long alto = proximoAleatorio(&estado);
+        valores[i] = (long long)((alto << 31) ^ proximoAleatorio(&estado));
+    }
+
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        ArvoreLongaInserir(&teste, valores[i], i);
+    }
+    double tempoInsercao = segundosDesde(inicio);
+
+    int encontrados = 0;
+    inicio = clock();
+    for (int i = 0; i < n; i++) {
+        encontrados += ArvoreLongaBuscar(&teste, valores[i]) != NULL;
+    }
+    double tempoBusca = segundosDesde(inicio);
+
+    printf("Chaves de 64 bits (genérica)\n");
+    printf("Inserção: %.3f s (%.1f ns/op)\n", tempoInsercao, tempoInsercao * 1e9 / n);
+    printf("Busca:    %.3f s (%.1f ns/op, %d encontrados)\n", tempoBusca, tempoBusca * 1e9 / n, encontrados);
+
+    ArvoreLongaLiberar(&teste);
+    free(valores);
+}
+
+// FUNÇÕES DE MENU
+
+// Função para exibir o menu principal
+void exibirMenuPrincipal() {
+    printf("\n=== ÁRVORE RUBRO-NEGRA GENÉRICA ===\n");
+    printf("1 - Inserir palavra\n");
+    printf("2 - Buscar palavra\n");
+    printf("3 - Remover palavra\n");
+    printf("4 - Listar palavras em ordem\n");
+    printf("5 - Medir desempenho (chaves int)\n");
+    printf("6 - Medir desempenho (chaves de 64 bits)\n");
+    printf("7 - Latências das operações do menu\n");
+    printf("0 - Sair\n");
+    printf("Escolha uma opção: ");
+}
+
+// Liberar as palavras copiadas e a árvore de texto
+void liberarPalavras(ArvoreTexto *palavras) {
+    for (ArvoreTextoNo *no = ArvoreTextoPrimeiro(palavras); no != NULL; no = ArvoreTextoSucessor(palavras, no)) {
+        free(no->chave);
+    }
+    ArvoreTextoLiberar(palavras);
+}
+
+// Função principal
+int main() {
+    ArvoreTexto palavras;
+    ArvoreTextoInicializar(&palavras);
+
+    char texto[TAMANHO_TEXTO];
+    int opcao, quantidade;
+    unsigned long long antes;
+
+    // Latências das operações do menu (opção 7, e o relatório ao sair); a
+    // inserção inclui a busca que decide entre contar e inserir a palavra
+    static LatenciasMenu latencias;
+
+    do {
+        exibirMenuPrincipal();
+        scanf("%d", &opcao);
+
+        switch (opcao) {
+            case 1: {
+                printf("Digite a palavra: ");
+                scanf("%99s", texto);
+                antes = histogramaAgora();
+                ArvoreTextoNo *no = ArvoreTextoBuscar(&palavras, texto);
+                if (no != NULL) {
+                    no->valor++;
+                    latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                    printf("Palavra \"%s\" agora aparece %d vezes.\n", texto, no->valor);
+                } else {
+                    char *copia = (char*)malloc(strlen(texto) + 1);
+                    if (copia == NULL) {
+                        printf("Erro: Falha na alocação de memória!\n");
+                        break;
+                    }
+                    strcpy(copia, texto);
+                    ArvoreTextoInserir(&palavras, copia, 1);
+                    latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                    printf("Palavra \"%s\" inserida.\n", texto);
+                }
+                break;
+            }
+
+            case 2: {
+                printf("Digite a palavra: ");
+                scanf("%99s", texto);
+                antes = histogramaAgora();
+                ArvoreTextoNo *no = ArvoreTextoBuscar(&palavras, texto);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
+                if (no != NULL) {
+                    printf("Palavra \"%s\" encontrada (%d vezes).\n", texto, no->valor);
+                } else {
+                    printf("Palavra \"%s\" não encontrada.\n", texto);
+                }
+                break;
+            }
+
+            case 3: {
+                printf("Digite a palavra: ");
+                scanf("%99s", texto);
+                antes = histogramaAgora();
+                ArvoreTextoNo *no = ArvoreTextoBuscar(&palavras, texto);
+                if (no != NULL) {
+                    char *chave = no->chave;
+                    ArvoreTextoRemover(&palavras, texto);
+                    free(chave);
+                    latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                    printf("Palavra \"%s\" removida.\n", texto);
+                } else {
+                    printf("Palavra \"%s\" não encontrada.\n", texto);
+                }
+                break;
+            }
+
+            case 4:
+                if (palavras.tamanho == 0) {
+                    printf("Árvore vazia!\n");
+                } else {
+                    printf("%zu palavra(s): ", palavras.tamanho);
+                    antes = histogramaAgora();
+                    for (ArvoreTextoNo *no = ArvoreTextoPrimeiro(&palavras); no != NULL; no = ArvoreTextoSucessor(&palavras, no)) {
+                        printf("%s(%d) ", no->chave, no->valor);
+                    }
+                    latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    printf("\n");
+                }
+                break;
+
+            case 5:
+            case 6:
+                printf("Quantidade de valores: ");
+                scanf("%d", &quantidade);
+                if (quantidade > 0) {
+                    if (opcao == 5) {
+                        medirDesempenhoInt(quantidade);
+                    } else {
+                        medirDesempenhoLonga(quantidade);
+                    }
+                }
+                break;
+
+            case 7:
+                latenciasImprimir(&latencias);
+                break;
+
+            case 0:
+                printf("Encerrando programa...\n");
+                break;
+
+            default:
+                printf("Opção inválida! Tente novamente.\n");
+        }
+
+    } while (opcao != 0);
+
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+
+    liberarPalavras(&palavras);
+    printf("Memória liberada. Programa encerrado.\n");
+
+    return 0;
+}
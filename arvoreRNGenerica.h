@@ -0,0 +1,406 @@
+// Árvore Rubro-Negra genérica, gerada em tempo de compilação.
+//
+// Antes de incluir este arquivo, defina:
+//   ARVORE_NOME              prefixo dos tipos e funções gerados (ex.: ArvoreInt)
+//   ARVORE_CHAVE             tipo da chave
+//   ARVORE_VALOR             tipo do valor associado à chave
+//   ARVORE_MENOR(a, b)       expressão verdadeira se a vem antes de b
+//   ARVORE_IGUAL(a, b)       expressão verdadeira se a e b são a mesma chave
+//
+// As expressões são expandidas em linha, sem chamada indireta por ponteiro de
+// função. Não se usa uma comparação de três vias (< 0, 0, > 0) nem a igualdade
+// derivada de MENOR: com chaves int o compilador deixa de gerar a descida sem
+// desvios (cmov) e a busca fica até duas vezes mais lenta que a de arvoreRN.c.
+//
+// O arquivo pode ser incluído várias vezes, com parâmetros diferentes, no
+// mesmo programa; os parâmetros são apagados no final de cada inclusão.
+// As chaves são únicas: inserir uma chave existente só atualiza o valor.
+// A árvore não copia chaves apontadas (ex.: textos), apenas o ponteiro.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if !defined(ARVORE_NOME) || !defined(ARVORE_CHAVE) || !defined(ARVORE_VALOR) || !defined(ARVORE_MENOR) || !defined(ARVORE_IGUAL)
+#error "Defina ARVORE_NOME, ARVORE_CHAVE, ARVORE_VALOR, ARVORE_MENOR e ARVORE_IGUAL antes de incluir arvoreRNGenerica.h"
+#endif
+
+#ifndef ARVORE_RN_GENERICA_COMUM
+#define ARVORE_RN_GENERICA_COMUM
+
+// Cores para os nós da árvore
+typedef enum { VERMELHO, NEGRO } Cor;
+
+#define ARVORE_JUNTAR_(a, b) a##b
+#define ARVORE_JUNTAR(a, b) ARVORE_JUNTAR_(a, b)
+
+#endif
+
+// Nome gerado: ARVORE_F(Inserir) vira <ARVORE_NOME>Inserir
+#define ARVORE_F(nome) ARVORE_JUNTAR(ARVORE_NOME, nome)
+#define NO_T ARVORE_F(No)
+
+// Estrutura do nó
+typedef struct ARVORE_F(No) {
+    ARVORE_CHAVE chave;
+    ARVORE_VALOR valor;
+    Cor cor;
+    struct ARVORE_F(No) *esquerda;
+    struct ARVORE_F(No) *direita;
+    struct ARVORE_F(No) *pai;
+} NO_T;
+
+// Estrutura da árvore (o nó nulo fica dentro dela, sem alocação extra)
+typedef struct {
+    NO_T *raiz;
+    NO_T nulo;
+    size_t tamanho;
+} ARVORE_NOME;
+
+// Inicializar a árvore vazia
+static inline void ARVORE_F(Inicializar)(ARVORE_NOME *arvore) {
+    arvore->nulo.cor = NEGRO;
+    arvore->nulo.esquerda = NULL;
+    arvore->nulo.direita = NULL;
+    arvore->nulo.pai = NULL;
+    arvore->raiz = &arvore->nulo;
+    arvore->tamanho = 0;
+}
+
+// Rotação à esquerda
+static inline void ARVORE_F(RotacaoEsquerda)(ARVORE_NOME *arvore, NO_T *x) {
+    NO_T *nulo = &arvore->nulo;
+    NO_T *y = x->direita;
+    x->direita = y->esquerda;
+
+    if (y->esquerda != nulo) {
+        y->esquerda->pai = x;
+    }
+
+    y->pai = x->pai;
+
+    if (x->pai == nulo) {
+        arvore->raiz = y;
+    } else if (x == x->pai->esquerda) {
+        x->pai->esquerda = y;
+    } else {
+        x->pai->direita = y;
+    }
+
+    y->esquerda = x;
+    x->pai = y;
+}
+
+// Rotação à direita
+static inline void ARVORE_F(RotacaoDireita)(ARVORE_NOME *arvore, NO_T *y) {
+    NO_T *nulo = &arvore->nulo;
+    NO_T *x = y->esquerda;
+    y->esquerda = x->direita;
+
+    if (x->direita != nulo) {
+        x->direita->pai = y;
+    }
+
+    x->pai = y->pai;
+
+    if (y->pai == nulo) {
+        arvore->raiz = x;
+    } else if (y == y->pai->esquerda) {
+        y->pai->esquerda = x;
+    } else {
+        y->pai->direita = x;
+    }
+
+    x->direita = y;
+    y->pai = x;
+}
+
+// Buscar o nó de uma chave (NULL se não existir)
+static inline NO_T* ARVORE_F(Buscar)(ARVORE_NOME *arvore, ARVORE_CHAVE chave) {
+    NO_T *no = arvore->raiz;
+
+    while (no != &arvore->nulo) {
+        if (ARVORE_IGUAL(chave, no->chave)) {
+            return no;
+        }
+        no = ARVORE_MENOR(chave, no->chave) ? no->esquerda : no->direita;
+    }
+    return NULL;
+}
+
+// Corrigir violações após inserção
+static inline void ARVORE_F(CorrigirInsercao)(ARVORE_NOME *arvore, NO_T *k) {
+    NO_T *tio;
+
+    while (k->pai->cor == VERMELHO) {
+        // Caso: Pai é filho esquerdo do avô
+        if (k->pai == k->pai->pai->esquerda) {
+            tio = k->pai->pai->direita;
+
+            if (tio->cor == VERMELHO) {
+                // CASO 1: Tio é vermelho
+                k->pai->cor = NEGRO;
+                tio->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                k = k->pai->pai;
+            } else {
+                // CASO 2: k é filho direito
+                if (k == k->pai->direita) {
+                    k = k->pai;
+                    ARVORE_F(RotacaoEsquerda)(arvore, k);
+                }
+
+                // CASO 3: k é filho esquerdo
+                k->pai->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                ARVORE_F(RotacaoDireita)(arvore, k->pai->pai);
+            }
+        }
+        // Caso: Pai é filho direito do avô (simétrico)
+        else {
+            tio = k->pai->pai->esquerda;
+
+            if (tio->cor == VERMELHO) {
+                k->pai->cor = NEGRO;
+                tio->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                k = k->pai->pai;
+            } else {
+                if (k == k->pai->esquerda) {
+                    k = k->pai;
+                    ARVORE_F(RotacaoDireita)(arvore, k);
+                }
+
+                k->pai->cor = NEGRO;
+                k->pai->pai->cor = VERMELHO;
+                ARVORE_F(RotacaoEsquerda)(arvore, k->pai->pai);
+            }
+        }
+    }
+
+    arvore->raiz->cor = NEGRO;  // Regra 2: raiz sempre negra
+}
+
+// Inserir ou atualizar uma chave; retorna o nó da chave (NULL se faltar memória)
+static inline NO_T* ARVORE_F(Inserir)(ARVORE_NOME *arvore, ARVORE_CHAVE chave, ARVORE_VALOR valor) {
+    NO_T *nulo = &arvore->nulo;
+    NO_T *y = nulo;
+    NO_T *x = arvore->raiz;
+    int menor = 0;
+
+    while (x != nulo) {
+        y = x;
+        if (ARVORE_IGUAL(chave, x->chave)) {
+            x->valor = valor;  // Chave existente: apenas atualizar
+            return x;
+        }
+        menor = ARVORE_MENOR(chave, x->chave);
+        x = menor ? x->esquerda : x->direita;
+    }
+
+    NO_T *novoNo = (NO_T*)malloc(sizeof(NO_T));
+    if (novoNo == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return NULL;
+    }
+    novoNo->chave = chave;
+    novoNo->valor = valor;
+    novoNo->cor = VERMELHO;  // Novo nó é sempre vermelho
+    novoNo->esquerda = nulo;
+    novoNo->direita = nulo;
+    novoNo->pai = y;
+
+    if (y == nulo) {
+        arvore->raiz = novoNo;
+    } else if (menor) {
+        y->esquerda = novoNo;
+    } else {
+        y->direita = novoNo;
+    }
+    arvore->tamanho++;
+
+    ARVORE_F(CorrigirInsercao)(arvore, novoNo);
+    return novoNo;
+}
+
+// Encontrar o nó com menor chave a partir de no
+static inline NO_T* ARVORE_F(Minimo)(ARVORE_NOME *arvore, NO_T *no) {
+    while (no->esquerda != &arvore->nulo) {
+        no = no->esquerda;
+    }
+    return no;
+}
+
+// Primeiro nó em ordem (NULL se a árvore estiver vazia)
+static inline NO_T* ARVORE_F(Primeiro)(ARVORE_NOME *arvore) {
+    if (arvore->raiz == &arvore->nulo) return NULL;
+    return ARVORE_F(Minimo)(arvore, arvore->raiz);
+}
+
+// Próximo nó em ordem (NULL se no for o último)
+static inline NO_T* ARVORE_F(Sucessor)(ARVORE_NOME *arvore, NO_T *no) {
+    NO_T *nulo = &arvore->nulo;
+    if (no->direita != nulo) {
+        return ARVORE_F(Minimo)(arvore, no->direita);
+    }
+
+    NO_T *pai = no->pai;
+    while (pai != nulo && no == pai->direita) {
+        no = pai;
+        pai = pai->pai;
+    }
+    return pai == nulo ? NULL : pai;
+}
+
+// Corrigir violações após remoção
+static inline void ARVORE_F(CorrigirRemocao)(ARVORE_NOME *arvore, NO_T *x) {
+    NO_T *irmao;
+
+    while (x != arvore->raiz && x->cor == NEGRO) {
+        if (x == x->pai->esquerda) {
+            irmao = x->pai->direita;
+
+            // CASO 1: Irmão é vermelho
+            if (irmao->cor == VERMELHO) {
+                irmao->cor = NEGRO;
+                x->pai->cor = VERMELHO;
+                ARVORE_F(RotacaoEsquerda)(arvore, x->pai);
+                irmao = x->pai->direita;
+            }
+
+            // CASO 2: Ambos os filhos do irmão são negros
+            if (irmao->esquerda->cor == NEGRO && irmao->direita->cor == NEGRO) {
+                irmao->cor = VERMELHO;
+                x = x->pai;
+            } else {
+                // CASO 3: Filho esquerdo do irmão é vermelho, direito é negro
+                if (irmao->direita->cor == NEGRO) {
+                    irmao->esquerda->cor = NEGRO;
+                    irmao->cor = VERMELHO;
+                    ARVORE_F(RotacaoDireita)(arvore, irmao);
+                    irmao = x->pai->direita;
+                }
+
+                // CASO 4: Filho direito do irmão é vermelho
+                irmao->cor = x->pai->cor;
+                x->pai->cor = NEGRO;
+                irmao->direita->cor = NEGRO;
+                ARVORE_F(RotacaoEsquerda)(arvore, x->pai);
+                x = arvore->raiz;
+            }
+        } else {
+            // Caso simétrico
+            irmao = x->pai->esquerda;
+
+            if (irmao->cor == VERMELHO) {
+                irmao->cor = NEGRO;
+                x->pai->cor = VERMELHO;
+                ARVORE_F(RotacaoDireita)(arvore, x->pai);
+                irmao = x->pai->esquerda;
+            }
+
+            if (irmao->direita->cor == NEGRO && irmao->esquerda->cor == NEGRO) {
+                irmao->cor = VERMELHO;
+                x = x->pai;
+            } else {
+                if (irmao->esquerda->cor == NEGRO) {
+                    irmao->direita->cor = NEGRO;
+                    irmao->cor = VERMELHO;
+                    ARVORE_F(RotacaoEsquerda)(arvore, irmao);
+                    irmao = x->pai->esquerda;
+                }
+
+                irmao->cor = x->pai->cor;
+                x->pai->cor = NEGRO;
+                irmao->esquerda->cor = NEGRO;
+                ARVORE_F(RotacaoDireita)(arvore, x->pai);
+                x = arvore->raiz;
+            }
+        }
+    }
+
+    x->cor = NEGRO;
+}
+
+// Substituir um nó por outro na árvore
+static inline void ARVORE_F(Transplantar)(ARVORE_NOME *arvore, NO_T *u, NO_T *v) {
+    if (u->pai == &arvore->nulo) {
+        arvore->raiz = v;
+    } else if (u == u->pai->esquerda) {
+        u->pai->esquerda = v;
+    } else {
+        u->pai->direita = v;
+    }
+    v->pai = u->pai;
+}
+
+// Remover uma chave; retorna 1 se ela existia
+static inline int ARVORE_F(Remover)(ARVORE_NOME *arvore, ARVORE_CHAVE chave) {
+    NO_T *nulo = &arvore->nulo;
+    NO_T *z = ARVORE_F(Buscar)(arvore, chave);
+    if (z == NULL) {
+        return 0;
+    }
+
+    NO_T *y = z;
+    NO_T *x;
+    Cor corOriginalY = y->cor;
+
+    if (z->esquerda == nulo) {
+        x = z->direita;
+        ARVORE_F(Transplantar)(arvore, z, z->direita);
+    } else if (z->direita == nulo) {
+        x = z->esquerda;
+        ARVORE_F(Transplantar)(arvore, z, z->esquerda);
+    } else {
+        y = ARVORE_F(Minimo)(arvore, z->direita);
+        corOriginalY = y->cor;
+        x = y->direita;
+
+        if (y->pai == z) {
+            x->pai = y;
+        } else {
+            ARVORE_F(Transplantar)(arvore, y, y->direita);
+            y->direita = z->direita;
+            y->direita->pai = y;
+        }
+
+        ARVORE_F(Transplantar)(arvore, z, y);
+        y->esquerda = z->esquerda;
+        y->esquerda->pai = y;
+        y->cor = z->cor;
+    }
+
+    free(z);
+    arvore->tamanho--;
+
+    if (corOriginalY == NEGRO) {
+        ARVORE_F(CorrigirRemocao)(arvore, x);
+    }
+
+    return 1;
+}
+
+// Liberar os nós de uma subárvore
+static inline void ARVORE_F(LiberarNos)(ARVORE_NOME *arvore, NO_T *no) {
+    while (no != &arvore->nulo) {
+        ARVORE_F(LiberarNos)(arvore, no->esquerda);
+        NO_T *direita = no->direita;
+        free(no);
+        no = direita;
+    }
+}
+
+// Liberar toda a memória da árvore, deixando-a vazia
+static inline void ARVORE_F(Liberar)(ARVORE_NOME *arvore) {
+    ARVORE_F(LiberarNos)(arvore, arvore->raiz);
+    arvore->raiz = &arvore->nulo;
+    arvore->tamanho = 0;
+}
+
+#undef NO_T
+#undef ARVORE_F
+#undef ARVORE_NOME
+#undef ARVORE_CHAVE
+#undef ARVORE_VALOR
+#undef ARVORE_MENOR
+#undef ARVORE_IGUAL
@@ -0,0 +1,516 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "histograma.h"
+
+// Árvore Rubro-Negra persistente (cópia de caminho).
+// Cada atualização copia apenas os nós do caminho da raiz até a posição
+// alterada e compartilha todas as outras subárvores com a versão anterior.
+// Versões antigas continuam válidas e podem ser lidas sem travas enquanto
+// alguém mantiver uma referência a elas. Como os nós são compartilhados entre
+// versões, não há ponteiro para o pai: as rotações recebem a raiz da
+// subárvore e devolvem a nova raiz (formulação rubro-negra "caída à esquerda").
+//
+// Compilar com: gcc arvoreRNPersistente.c -o arvoreRNPersistente -pthread
+
+// Cores para os nós da árvore
+typedef enum { VERMELHO, NEGRO } Cor;
+
+// Estrutura do nó (imutável depois de publicado em uma versão)
+typedef struct No {
+    int valor;
+    Cor cor;
+    struct No *esquerda;
+    struct No *direita;
+    atomic_int referencias;  // Pais e versões que apontam para este nó
+    unsigned long versao;    // Atualização que criou o nó
+} No;
+
+// Uma versão capturada da árvore (somente leitura)
+typedef struct {
+    No *raiz;
+    unsigned long numero;
+} Versao;
+
+// Estrutura da Árvore Persistente
+typedef struct {
+    No *raiz;                     // Versão atual publicada
+    unsigned long versaoAtual;    // Número da atualização em andamento (escritor)
+    unsigned long versaoPublicada; // Número da versão visível aos leitores
+    pthread_mutex_t publicacao;   // Protege apenas a troca/captura da raiz
+} ArvorePersistente;
+
+// Quantidade de nós alocados em todas as versões (mostra o compartilhamento)
+atomic_long nosVivos = 0;
+
+// Função para inicializar a árvore
+void inicializarArvore(ArvorePersistente *arvore) {
+    arvore->raiz = NULL;
+    arvore->versaoAtual = 0;
+    arvore->versaoPublicada = 0;
+    pthread_mutex_init(&arvore->publicacao, NULL);
+}
+
+// Função para criar um novo nó
+No* criarNo(int valor, unsigned long versao) {
+    No *novoNo = (No*)malloc(sizeof(No));
+    if (novoNo == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        exit(1);
+    }
+    novoNo->valor = valor;
+    novoNo->cor = VERMELHO;  // Novo nó é sempre vermelho
+    novoNo->esquerda = NULL;
+    novoNo->direita = NULL;
+    atomic_init(&novoNo->referencias, 1);
+    novoNo->versao = versao;
+    atomic_fetch_add(&nosVivos, 1);
+    return novoNo;
+}
+
+// Adicionar uma referência a um nó (se existir)
+void reterNo(No *no) {
+    if (no != NULL) {
+        atomic_fetch_add_explicit(&no->referencias, 1, memory_order_relaxed);
+    }
+}
+
+// Remover uma referência; o último a soltar libera o nó e solta os filhos
+void liberarNo(No *no) {
+    while (no != NULL) {
+        if (atomic_fetch_sub_explicit(&no->referencias, 1, memory_order_acq_rel) != 1) {
+            return;
+        }
+        No *esquerda = no->esquerda;
+        No *direita = no->direita;
+        free(no);
+        atomic_fetch_sub(&nosVivos, 1);
+        liberarNo(esquerda);
+        no = direita;  // Continuar pela direita sem recursão
+    }
+}
+
+// Obter uma cópia privada do nó para a atualização em andamento.
+// Nós criados nesta mesma atualização ainda não foram publicados e podem ser
+// alterados diretamente; os demais são copiados e a referência que o chamador
+// tinha para o original é solta.
+No* tornarPrivado(ArvorePersistente *arvore, No *no) {
+    if (no == NULL || no->versao == arvore->versaoAtual) {
+        return no;
+    }
+
+    No *copia = criarNo(no->valor, arvore->versaoAtual);
+    copia->cor = no->cor;
+    copia->esquerda = no->esquerda;
+    copia->direita = no->direita;
+    reterNo(copia->esquerda);
+    reterNo(copia->direita);
+
+    liberarNo(no);
+    return copia;
+}
+
+// Verificar se um nó é vermelho (nulo é negro)
+int ehVermelho(No *no) {
+    return no != NULL && no->cor == VERMELHO;
+}
+
+// ROTAÇÕES (sem ponteiro para o pai: devolvem a nova raiz da subárvore)
+
+// Rotação à esquerda; h já é privado
+No* rotacaoEsquerda(ArvorePersistente *arvore, No *h) {
+    No *x = tornarPrivado(arvore, h->direita);
+    h->direita = x->esquerda;
+    x->esquerda = h;
+    x->cor = h->cor;
+    h->cor = VERMELHO;
+    return x;
+}
+
+// Rotação à direita; h já é privado
+No* rotacaoDireita(ArvorePersistente *arvore, No *h) {
+    No *x = tornarPrivado(arvore, h->esquerda);
+    h->esquerda = x->direita;
+    x->direita = h;
+    x->cor = h->cor;
+    h->cor = VERMELHO;
+    return x;
+}
+
+// Inverter as cores de um nó e dos dois filhos; h já é privado
+void inverterCores(ArvorePersistente *arvore, No *h) {
+    h->esquerda = tornarPrivado(arvore, h->esquerda);
+    h->direita = tornarPrivado(arvore, h->direita);
+    h->cor = !h->cor;
+    h->esquerda->cor = !h->esquerda->cor;
+    h->direita->cor = !h->direita->cor;
+}
+
+// Restaurar as invariantes na subida da recursão
+No* balancear(ArvorePersistente *arvore, No *h) {
+    if (ehVermelho(h->direita) && !ehVermelho(h->esquerda)) {
+        h = rotacaoEsquerda(arvore, h);
+    }
+    if (ehVermelho(h->esquerda) && ehVermelho(h->esquerda->esquerda)) {
+        h = rotacaoDireita(arvore, h);
+    }
+    if (ehVermelho(h->esquerda) && ehVermelho(h->direita)) {
+        inverterCores(arvore, h);
+    }
+    return h;
+}
+
+// BUSCA (em qualquer versão, sem travas)
+
+// Buscar um valor a partir de uma raiz
+int buscarNaRaiz(No *no, int valor) {
+    while (no != NULL) {
+        if (valor == no->valor) return 1;
+        no = valor < no->valor ? no->esquerda : no->direita;
+    }
+    return 0;
+}
+
+// INSERÇÃO
+
+// Inserir recursivamente; h é a referência herdada do pai (ou da versão)
+No* inserirNo(ArvorePersistente *arvore, No *h, int valor) {
+    if (h == NULL) {
+        return criarNo(valor, arvore->versaoAtual);
+    }
+
+    if (valor == h->valor) {
+        return h;  // Valores repetidos são ignorados, nada é copiado
+    }
+
+    h = tornarPrivado(arvore, h);
+
+    if (valor < h->valor) {
+        h->esquerda = inserirNo(arvore, h->esquerda, valor);
+    } else {
+        h->direita = inserirNo(arvore, h->direita, valor);
+    }
+
+    return balancear(arvore, h);
+}
+
+// REMOÇÃO
+
+// Empurrar um vermelho para a esquerda antes de descer; h já é privado
+No* moverVermelhoEsquerda(ArvorePersistente *arvore, No *h) {
+    inverterCores(arvore, h);
+    if (ehVermelho(h->direita->esquerda)) {
+        h->direita = rotacaoDireita(arvore, h->direita);
+        h = rotacaoEsquerda(arvore, h);
+        inverterCores(arvore, h);
+    }
+    return h;
+}
+
+// Empurrar um vermelho para a direita antes de descer; h já é privado
+No* moverVermelhoDireita(ArvorePersistente *arvore, No *h) {
+    inverterCores(arvore, h);
+    if (ehVermelho(h->esquerda->esquerda)) {
+        h = rotacaoDireita(arvore, h);
+        inverterCores(arvore, h);
+    }
+    return h;
+}
+
+// Remover o menor valor da subárvore; h é a referência herdada do pai
+No* removerMinimo(ArvorePersistente *arvore, No *h) {
+    h = tornarPrivado(arvore, h);
+
+    if (h->esquerda == NULL) {
+        liberarNo(h);
+        return NULL;
+    }
+
+    if (!ehVermelho(h->esquerda) && !ehVermelho(h->esquerda->esquerda)) {
+        h = moverVermelhoEsquerda(arvore, h);
+    }
+
+    h->esquerda = removerMinimo(arvore, h->esquerda);
+    return balancear(arvore, h);
+}
+
+// Remover recursivamente um valor que existe na subárvore
+No* removerNo(ArvorePersistente *arvore, No *h, int valor) {
+    h = tornarPrivado(arvore, h);
+
+    if (valor < h->valor) {
+        if (!ehVermelho(h->esquerda) && !ehVermelho(h->esquerda->esquerda)) {
+            h = moverVermelhoEsquerda(arvore, h);
+        }
+        h->esquerda = removerNo(arvore, h->esquerda, valor);
+    } else {
+        if (ehVermelho(h->esquerda)) {
+            h = rotacaoDireita(arvore, h);
+        }
+
+        if (valor == h->valor && h->direita == NULL) {
+            liberarNo(h);
+            return NULL;
+        }
+
+        if (!ehVermelho(h->direita) && !ehVermelho(h->direita->esquerda)) {
+            h = moverVermelhoDireita(arvore, h);
+        }
+
+        if (valor == h->valor) {
+            // Substituir pelo sucessor e remover o sucessor da direita
+            No *sucessor = h->direita;
+            while (sucessor->esquerda != NULL) {
+                sucessor = sucessor->esquerda;
+            }
+            h->valor = sucessor->valor;
+            h->direita = removerMinimo(arvore, h->direita);
+        } else {
+            h->direita = removerNo(arvore, h->direita, valor);
+        }
+    }
+
+    return balancear(arvore, h);
+}
+
+// VERSÕES
+
+// Publicar uma nova raiz e soltar a referência da árvore à raiz anterior
+void publicarRaiz(ArvorePersistente *arvore, No *novaRaiz) {
+    pthread_mutex_lock(&arvore->publicacao);
+    No *antiga = arvore->raiz;
+    arvore->raiz = novaRaiz;
+    arvore->versaoPublicada = arvore->versaoAtual;
+    pthread_mutex_unlock(&arvore->publicacao);
+    liberarNo(antiga);
+}
+
+// Começar uma atualização: nova versão e referência própria à raiz atual
+No* iniciarAtualizacao(ArvorePersistente *arvore) {
+    arvore->versaoAtual++;
+    reterNo(arvore->raiz);
+    return arvore->raiz;
+}
+
+// Inserir um valor gerando uma nova versão (um escritor por vez)
+void inserir(ArvorePersistente *arvore, int valor) {
+    No *raiz = inserirNo(arvore, iniciarAtualizacao(arvore), valor);
+    if (raiz->cor != NEGRO) {
+        raiz->cor = NEGRO;  // Raiz vermelha só pode ser uma cópia privada
+    }
+    publicarRaiz(arvore, raiz);
+}
+
+// Remover um valor gerando uma nova versão (um escritor por vez)
+int remover(ArvorePersistente *arvore, int valor) {
+    if (!buscarNaRaiz(arvore->raiz, valor)) {
+        return 0;  // Valor não encontrado: nenhuma versão nova
+    }
+
+    No *raiz = tornarPrivado(arvore, iniciarAtualizacao(arvore));
+    if (!ehVermelho(raiz->esquerda) && !ehVermelho(raiz->direita)) {
+        raiz->cor = VERMELHO;
+    }
+
+    raiz = removerNo(arvore, raiz, valor);
+    if (raiz != NULL) {
+        raiz->cor = NEGRO;
+    }
+    publicarRaiz(arvore, raiz);
+    return 1;
+}
+
+// Capturar a versão atual para leitura; a versão fica válida até ser liberada
+Versao capturarVersao(ArvorePersistente *arvore) {
+    Versao versao;
+    pthread_mutex_lock(&arvore->publicacao);
+    versao.raiz = arvore->raiz;
+    versao.numero = arvore->versaoPublicada;
+    reterNo(versao.raiz);
+    pthread_mutex_unlock(&arvore->publicacao);
+    return versao;
+}
+
+// Liberar uma versão capturada (nós não compartilhados são liberados)
+void liberarVersao(Versao *versao) {
+    liberarNo(versao->raiz);
+    versao->raiz = NULL;
+}
+
+// Buscar um valor em uma versão capturada (sem travas)
+int buscar(Versao *versao, int valor) {
+    return buscarNaRaiz(versao->raiz, valor);
+}
+
+// PERCURSOS
+
+// Em ordem: Esquerda → Raiz → Direita
+void emOrdem(No *no) {
+    if (no != NULL) {
+        emOrdem(no->esquerda);
+        printf("%d(%s) ", no->valor, no->cor == VERMELHO ? "V" : "N");
+        emOrdem(no->direita);
+    }
+}
+
+// FUNÇÕES AUXILIARES E MENU
+
+#define MAX_VERSOES 10
+
+// Função para exibir o menu principal
+void exibirMenuPrincipal() {
+    printf("\n=== ÁRVORE RUBRO-NEGRA PERSISTENTE ===\n");
+    printf("1 - Inserir valor\n");
+    printf("2 - Buscar valor (versão atual)\n");
+    printf("3 - Remover valor\n");
+    printf("4 - Percorrer versão atual\n");
+    printf("5 - Capturar versão\n");
+    printf("6 - Percorrer versão capturada\n");
+    printf("7 - Liberar versão capturada\n");
+    printf("8 - Latências das operações do menu\n");
+    printf("0 - Sair\n");
+    printf("Escolha uma opção: ");
+}
+
+// Ler o índice de uma versão capturada válida (ou -1)
+int lerVersao(Versao versoes[], int quantidade) {
+    int indice;
+    printf("Digite o índice da versão (0 a %d): ", quantidade - 1);
+    scanf("%d", &indice);
+    if (indice < 0 || indice >= quantidade || versoes[indice].raiz == NULL) {
+        printf("Versão inválida!\n");
+        return -1;
+    }
+    return indice;
+}
+
+// Função principal
+int main() {
+    ArvorePersistente arvore;
+    inicializarArvore(&arvore);
+
+    Versao versoes[MAX_VERSOES];
+    int quantidadeVersoes = 0;
+    int opcao, valor, indice;
+    unsigned long long antes;
+
+    // Latências das operações do menu (opção 8, e o relatório ao sair); a
+    // busca inclui capturar e liberar a versão atual, como faz um leitor
+    static LatenciasMenu latencias;
+
+    do {
+        exibirMenuPrincipal();
+        scanf("%d", &opcao);
+
+        switch (opcao) {
+            case 1:
+                printf("Digite o valor a ser inserido: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                inserir(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                printf("Valor %d inserido (versão %lu, %ld nós vivos).\n",
+                       valor, arvore.versaoAtual, (long)nosVivos);
+                break;
+
+            case 2: {
+                printf("Digite o valor a ser buscado: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                Versao atual = capturarVersao(&arvore);
+                int encontrado = buscar(&atual, valor);
+                liberarVersao(&atual);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
+                if (encontrado) {
+                    printf("Valor %d encontrado na árvore.\n", valor);
+                } else {
+                    printf("Valor %d não encontrado na árvore.\n", valor);
+                }
+                break;
+            }
+
+            case 3:
+                printf("Digite o valor a ser removido: ");
+                scanf("%d", &valor);
+                antes = histogramaAgora();
+                int removido = remover(&arvore, valor);
+                latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                if (removido) {
+                    printf("Valor %d removido (versão %lu, %ld nós vivos).\n",
+                           valor, arvore.versaoAtual, (long)nosVivos);
+                } else {
+                    printf("Valor %d não encontrado na árvore.\n", valor);
+                }
+                break;
+
+            case 4:
+                if (arvore.raiz == NULL) {
+                    printf("Árvore vazia!\n");
+                } else {
+                    printf("Percorrendo versão %lu: ", arvore.versaoAtual);
+                    antes = histogramaAgora();
+                    emOrdem(arvore.raiz);
+                    latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    printf("\n");
+                }
+                break;
+
+            case 5:
+                if (quantidadeVersoes == MAX_VERSOES) {
+                    printf("Limite de %d versões capturadas atingido.\n", MAX_VERSOES);
+                } else {
+                    versoes[quantidadeVersoes] = capturarVersao(&arvore);
+                    printf("Versão %lu capturada no índice %d.\n",
+                           versoes[quantidadeVersoes].numero, quantidadeVersoes);
+                    quantidadeVersoes++;
+                }
+                break;
+
+            case 6:
+                indice = lerVersao(versoes, quantidadeVersoes);
+                if (indice >= 0) {
+                    printf("Percorrendo versão %lu: ", versoes[indice].numero);
+                    antes = histogramaAgora();
+                    emOrdem(versoes[indice].raiz);
+                    latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    printf("\n");
+                }
+                break;
+
+            case 7:
+                indice = lerVersao(versoes, quantidadeVersoes);
+                if (indice >= 0) {
+                    liberarVersao(&versoes[indice]);
+                    printf("Versão liberada (%ld nós vivos).\n", (long)nosVivos);
+                }
+                break;
+
+            case 8:
+                latenciasImprimir(&latencias);
+                break;
+
+            case 0:
+                printf("Encerrando programa...\n");
+                break;
+
+            default:
+                printf("Opção inválida! Tente novamente.\n");
+        }
+
+    } while (opcao != 0);
+
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+
+    // Liberar todas as versões e a versão atual
+    for (int i = 0; i < quantidadeVersoes; i++) {
+        liberarVersao(&versoes[i]);
+    }
+    publicarRaiz(&arvore, NULL);
+    pthread_mutex_destroy(&arvore.publicacao);
+    printf("Memória liberada (%ld nós vivos). Programa encerrado.\n", (long)nosVivos);
+
+    return 0;
+}
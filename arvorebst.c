@@ -1,5 +1,23 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "log.h"
+#include "conjunto.h"
+#include "contadores.h"
+#include "rastro.h"
+#include "servidor.h"
+#include "ordenacao.h"
+#include "histograma.h"
+
+// Compilar com: gcc arvorebst.c -o arvorebst -pthread
+//
+// Compilado como módulo (-DSEM_MAIN, ver conjunto.h), só a interface de
+// conjunto fica: o menu, os percursos impressos, a carga em lote, o log e as
+// medições ficam de fora (#ifndef SEM_MAIN)
+
+#define INTERVALO_INSTANTANEO 100000  // Operações entre instantâneos do log
+#define MINIMO_PARALELO 16384         // Valores abaixo dos quais a carga paralela não cria threads
 
 // Estrutura do nó da Árvore Binária de Busca
 typedef struct No {
@@ -13,13 +31,17 @@ typedef struct {
     No *raiz;
 } Arvore;
 
+// Contadores de instrumentação de todas as árvores do módulo (contadores.h)
+static Contadores contadores;
+
 // Função para criar um novo nó
-No* criarNo(int valor) {
+static No* criarNo(int valor) {
     No *novoNo = (No*)malloc(sizeof(No));
     if (novoNo == NULL) {
         printf("Erro: Falha na alocação de memória!\n");
         return NULL;
     }
+    CONTAR(contadores, alocacoes);
     novoNo->valor = valor;
     novoNo->esquerda = NULL;
     novoNo->direita = NULL;
@@ -27,21 +49,25 @@ No* criarNo(int valor) {
 }
 
 // Função para inicializar a árvore
-void inicializarArvore(Arvore *arvore) {
+static void inicializarArvore(Arvore *arvore) {
     arvore->raiz = NULL;
 }
 
+#ifndef SEM_MAIN
 // Função para verificar se a árvore está vazia
-int arvoreVazia(Arvore *arvore) {
+static int arvoreVazia(Arvore *arvore) {
     return arvore->raiz == NULL;
 }
+#endif
 
 // 1. FUNÇÃO DE INSERÇÃO
-No* inserir(No *raiz, int valor) {
+static No* inserir(No *raiz, int valor) {
     // Caso base: árvore vazia ou chegou na posição de inserção
     if (raiz == NULL) {
         return criarNo(valor);
     }
+    CONTAR(contadores, nosVisitados);
+    CONTAR(contadores, comparacoes);
     
     // Inserir na subárvore esquerda se valor for menor
     if (valor < raiz->valor) {
@@ -58,9 +84,14 @@ No* inserir(No *raiz, int valor) {
 }
 
 // 2. FUNÇÃO DE BUSCA
-No* buscar(No *raiz, int valor) {
+static No* buscar(No *raiz, int valor) {
     // Caso base: árvore vazia ou valor encontrado
-    if (raiz == NULL || raiz->valor == valor) {
+    if (raiz == NULL) {
+        return raiz;
+    }
+    CONTAR(contadores, nosVisitados);
+    CONTAR(contadores, comparacoes);
+    if (raiz->valor == valor) {
         return raiz;
     }
     
@@ -75,7 +106,7 @@ No* buscar(No *raiz, int valor) {
 }
 
 // Função auxiliar para encontrar o menor valor (sucessor in-order)
-No* encontrarMenor(No *raiz) {
+static No* encontrarMenor(No *raiz) {
     No *atual = raiz;
     // Percorre sempre para a esquerda até encontrar o menor
     while (atual && atual->esquerda != NULL) {
@@ -85,11 +116,13 @@ No* encontrarMenor(No *raiz) {
 }
 
 // 3. FUNÇÃO DE REMOÇÃO
-No* remover(No *raiz, int valor) {
+static No* remover(No *raiz, int valor) {
     // Caso base: árvore vazia
     if (raiz == NULL) {
         return raiz;
     }
+    CONTAR(contadores, nosVisitados);
+    CONTAR(contadores, comparacoes);
     
     // Encontrar o nó a ser removido
     if (valor < raiz->valor) {
@@ -105,11 +138,13 @@ No* remover(No *raiz, int valor) {
         if (raiz->esquerda == NULL) {
             No *temp = raiz->direita;
             free(raiz);
+            CONTAR(contadores, liberacoes);
             return temp;
         }
         else if (raiz->direita == NULL) {
             No *temp = raiz->esquerda;
             free(raiz);
+            CONTAR(contadores, liberacoes);
             return temp;
         }
         
@@ -128,8 +163,9 @@ No* remover(No *raiz, int valor) {
 
 // 4. FUNÇÕES DE PERCURSO
 
+#ifndef SEM_MAIN
 // Pré-ordem: Raiz -> Esquerda -> Direita
-void preOrdem(No *raiz) {
+static void preOrdem(No *raiz) {
     if (raiz != NULL) {
         printf("%d ", raiz->valor);
         preOrdem(raiz->esquerda);
@@ -138,7 +174,7 @@ void preOrdem(No *raiz) {
 }
 
 // Em ordem: Esquerda -> Raiz -> Direita
-void emOrdem(No *raiz) {
+static void emOrdem(No *raiz) {
     if (raiz != NULL) {
         emOrdem(raiz->esquerda);
         printf("%d ", raiz->valor);
@@ -147,36 +183,493 @@ void emOrdem(No *raiz) {
 }
 
 // Pós-ordem: Esquerda -> Direita -> Raiz
-void posOrdem(No *raiz) {
+static void posOrdem(No *raiz) {
     if (raiz != NULL) {
         posOrdem(raiz->esquerda);
         posOrdem(raiz->direita);
         printf("%d ", raiz->valor);
     }
 }
+#endif
 
 // Função para liberar toda a memória da árvore
-void liberarArvore(No *raiz) {
+static void liberarArvore(No *raiz) {
     if (raiz != NULL) {
         liberarArvore(raiz->esquerda);
         liberarArvore(raiz->direita);
         free(raiz);
+        CONTAR(contadores, liberacoes);
+    }
+}
+
+#ifndef SEM_MAIN
+
+// 5. CARGA A PARTIR DE VALORES ORDENADOS
+
+// Montar uma árvore balanceada com os valores ordenados de inicio a fim
+// (o do meio vira a raiz, sem comparações nem desbalanceamento)
+static No* construirBalanceada(const int *valores, int inicio, int fim) {
+    if (inicio > fim) {
+        return NULL;
+    }
+    
+    int meio = inicio + (fim - inicio) / 2;
+    No *raiz = criarNo(valores[meio]);
+    raiz->esquerda = construirBalanceada(valores, inicio, meio - 1);
+    raiz->direita = construirBalanceada(valores, meio + 1, fim);
+    return raiz;
+}
+
+// Uma chamada de construirBalanceadaParalela (executável em outra thread)
+typedef struct {
+    const int *valores;
+    int inicio;
+    int fim;
+    int nivelParalelo;  // Quantos níveis ainda podem criar threads
+    No *raiz;
+} TarefaConstrucao;
+
+static No* construirBalanceadaParalela(const int *valores, int inicio, int fim, int nivelParalelo);
+
+// Ponto de entrada das threads criadas pela construção
+static void* executarTarefaConstrucao(void *argumento) {
+    TarefaConstrucao *tarefa = (TarefaConstrucao*)argumento;
+    tarefa->raiz = construirBalanceadaParalela(tarefa->valores, tarefa->inicio, tarefa->fim, tarefa->nivelParalelo);
+    return NULL;
+}
+
+// Como construirBalanceada, mas nos nivelParalelo níveis de cima a metade da
+// esquerda é montada em outra thread. Os nós desses níveis formam a espinha
+// e as subárvores abaixo deles são disjuntas, montadas sem sincronização.
+static No* construirBalanceadaParalela(const int *valores, int inicio, int fim, int nivelParalelo) {
+    if (nivelParalelo <= 0 || fim - inicio < MINIMO_PARALELO) {
+        return construirBalanceada(valores, inicio, fim);
+    }
+    
+    int meio = inicio + (fim - inicio) / 2;
+    No *raiz = criarNo(valores[meio]);
+    TarefaConstrucao esquerda = { valores, inicio, meio - 1, nivelParalelo - 1, NULL };
+    pthread_t thread;
+    int paralelo = pthread_create(&thread, NULL, executarTarefaConstrucao, &esquerda) == 0;
+    
+    if (!paralelo) {
+        executarTarefaConstrucao(&esquerda);
+    }
+    raiz->direita = construirBalanceadaParalela(valores, meio + 1, fim, nivelParalelo - 1);
+    if (paralelo) {
+        pthread_join(thread, NULL);
+    }
+    raiz->esquerda = esquerda.raiz;
+    return raiz;
+}
+
+// Níveis de recursão com threads para ocupar threads threads
+static int niveisParalelos(int threads) {
+    int niveis = 0;
+    while ((1 << niveis) < threads && niveis < 16) {
+        niveis++;
+    }
+    return niveis;
+}
+
+// Substituir a árvore pelas n chaves (fora de ordem e com repetidos),
+// ordenadas e montadas com threads threads. O vetor fica ordenado e sem
+// repetidos no começo. Retorna a quantidade de chaves distintas (-1 se faltar
+// memória).
+static int carregarEmParalelo(Arvore *arvore, int *chaves, int n, int threads) {
+    int distintos = ordenarSemRepetidos(chaves, n, threads);
+    if (distintos < 0) return -1;
+    
+    liberarArvore(arvore->raiz);
+    arvore->raiz = construirBalanceadaParalela(chaves, 0, distintos - 1, niveisParalelos(threads));
+    return distintos;
+}
+
+// Contar os nós da árvore
+static int contarNos(No *raiz) {
+    if (raiz == NULL) {
+        return 0;
+    }
+    return contarNos(raiz->esquerda) + contarNos(raiz->direita) + 1;
+}
+
+#endif
+
+// Altura da árvore (0 se vazia)
+static int altura(No *raiz) {
+    if (raiz == NULL) return 0;
+    int esquerda = altura(raiz->esquerda);
+    int direita = altura(raiz->direita);
+    return 1 + (esquerda > direita ? esquerda : direita);
+}
+
+#ifndef SEM_MAIN
+
+// Copiar os valores em ordem para o vetor, a partir da posição *pos
+static void copiarEmOrdem(No *raiz, int *valores, int *pos) {
+    if (raiz != NULL) {
+        copiarEmOrdem(raiz->esquerda, valores, pos);
+        valores[(*pos)++] = raiz->valor;
+        copiarEmOrdem(raiz->direita, valores, pos);
+    }
+}
+
+// 6. LOG E RECUPERAÇÃO (log.h)
+
+// Reaplicar uma operação do log (a árvore não guarda dados)
+static void aplicarOperacao(void *estrutura, char operacao, int chave, int dado) {
+    (void)dado;
+    Arvore *arvore = (Arvore*)estrutura;
+    if (operacao == LOG_INSERIR) {
+        arvore->raiz = inserir(arvore->raiz, chave);
+    } else {
+        arvore->raiz = remover(arvore->raiz, chave);
+    }
+}
+
+// Substituir a árvore pelos valores ordenados do instantâneo
+static void carregarInstantaneo(void *estrutura, const int *chaves, const int *dados, int n) {
+    (void)dados;
+    Arvore *arvore = (Arvore*)estrutura;
+    liberarArvore(arvore->raiz);
+    arvore->raiz = construirBalanceada(chaves, 0, n - 1);
+}
+
+// Gravar um instantâneo com os valores da árvore (esvazia o log)
+static void gravarInstantaneo(LogOperacoes *log, Arvore *arvore) {
+    int n = contarNos(arvore->raiz), pos = 0;
+    int *valores = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (valores == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    copiarEmOrdem(arvore->raiz, valores, &pos);
+    logGravarInstantaneo(log, valores, NULL, n);
+    free(valores);
+}
+
+// Registrar uma operação já feita na árvore (e o instantâneo, se for a hora)
+static void registrarOperacao(LogOperacoes *log, Arvore *arvore, char operacao, int chave) {
+    logRegistrar(log, operacao, chave);
+    if (logPrecisaInstantaneo(log)) {
+        gravarInstantaneo(log, arvore);
+    }
+}
+
+// Abrir o log de base e recuperar a árvore a partir dele
+static bool abrirLog(LogOperacoes *log, Arvore *arvore, const char *base, int grupo, long long intervalo) {
+    if (!logAbrir(log, base, grupo, intervalo)) {
+        return false;
+    }
+    
+    int numChaves;
+    long long numRegistros;
+    liberarArvore(arvore->raiz);
+    arvore->raiz = NULL;
+    
+    clock_t inicio = clock();
+    if (!logRecuperar(log, arvore, carregarInstantaneo, aplicarOperacao, &numChaves, &numRegistros)) {
+        logFechar(log);
+        return false;
+    }
+    double tempo = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    printf("Recuperação: %d valores do instantâneo e %lld operações do log em %.3f s.\n",
+           numChaves, numRegistros, tempo);
+    
+    gravarInstantaneo(log, arvore);
+    return true;
+}
+
+// 7. MEDIÇÃO DE DESEMPENHO
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+static unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Instante atual em segundos (relógio de parede: a espera do fsync não
+// aparece no tempo de CPU medido por clock)
+static double agora() {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return instante.tv_sec + instante.tv_nsec / 1e9;
+}
+
+// Medir o custo do log por operação e a recuperação: n operações aleatórias
+// (uma remoção a cada quatro) sem log e com log confirmado a cada grupo
+// operações, com instantâneos a cada n / 4. Depois, simulando uma queda,
+// recuperar do instantâneo e do log e comparar com refazer tudo pela inserção.
+static void medirLog(int n, int grupo) {
+    const char *base = "arvorebst_medicao";
+    int *chaves = (int*)malloc(sizeof(int) * n);
+    if (chaves == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        chaves[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    // Sem log (o mesmo que refazer as operações pela inserção)
+    Arvore semLog;
+    inicializarArvore(&semLog);
+    double inicio = agora();
+    for (int i = 0; i < n; i++) {
+        int chave = i % 4 == 3 ? chaves[i - 2] : chaves[i];
+        aplicarOperacao(&semLog, i % 4 == 3 ? LOG_REMOVER : LOG_INSERIR, chave, chave);
+    }
+    double tempoSemLog = agora() - inicio;
+    
+    // Com log
+    static LogOperacoes logMedicao;
+    char nome[64];
+    snprintf(nome, sizeof(nome), "%s.log", base);
+    remove(nome);
+    snprintf(nome, sizeof(nome), "%s.inst", base);
+    remove(nome);
+    
+    Arvore comLog;
+    inicializarArvore(&comLog);
+    if (!logAbrir(&logMedicao, base, grupo, n / 4 + 1)) {
+        liberarArvore(semLog.raiz);
+        free(chaves);
+        return;
+    }
+    inicio = agora();
+    for (int i = 0; i < n; i++) {
+        char operacao = i % 4 == 3 ? LOG_REMOVER : LOG_INSERIR;
+        int chave = i % 4 == 3 ? chaves[i - 2] : chaves[i];
+        aplicarOperacao(&comLog, operacao, chave, chave);
+        registrarOperacao(&logMedicao, &comLog, operacao, chave);
+    }
+    logFechar(&logMedicao);  // Queda: sem instantâneo final
+    double tempoComLog = agora() - inicio;
+    long long sincronizacoes = logMedicao.sincronizacoes;
+    
+    // Recuperação
+    Arvore recuperada;
+    inicializarArvore(&recuperada);
+    int numChaves = 0;
+    long long numRegistros = 0;
+    inicio = agora();
+    if (logAbrir(&logMedicao, base, grupo, 0)) {
+        logRecuperar(&logMedicao, &recuperada, carregarInstantaneo, aplicarOperacao, &numChaves, &numRegistros);
+        logFechar(&logMedicao);
+    }
+    double tempoRecuperacao = agora() - inicio;
+    
+    // Conferir a árvore recuperada
+    int total = contarNos(comLog.raiz), pos1 = 0, pos2 = 0;
+    bool igual = total == contarNos(recuperada.raiz);
+    if (igual && total > 0) {
+        int *esperado = (int*)malloc(sizeof(int) * total);
+        int *obtido = (int*)malloc(sizeof(int) * total);
+        copiarEmOrdem(comLog.raiz, esperado, &pos1);
+        copiarEmOrdem(recuperada.raiz, obtido, &pos2);
+        igual = memcmp(esperado, obtido, sizeof(int) * total) == 0;
+        free(esperado);
+        free(obtido);
     }
+    
+    printf("Sem log:     %.3f s (%.1f ns/op)\n", tempoSemLog, tempoSemLog * 1e9 / n);
+    printf("Com log:     %.3f s (%.1f ns/op, +%.1f ns/op, %lld sincronizações, grupo de %d)\n",
+           tempoComLog, tempoComLog * 1e9 / n, (tempoComLog - tempoSemLog) * 1e9 / n, sincronizacoes, logMedicao.tamanhoGrupo);
+    printf("Recuperação: %.3f s (%d valores do instantâneo + %lld operações do log), árvore %s\n",
+           tempoRecuperacao, numChaves, numRegistros, igual ? "conferida" : "DIFERENTE");
+    printf("Refazer as %d operações pela inserção: %.3f s\n", n, tempoSemLog);
+    
+    snprintf(nome, sizeof(nome), "%s.log", base);
+    remove(nome);
+    snprintf(nome, sizeof(nome), "%s.inst", base);
+    remove(nome);
+    liberarArvore(semLog.raiz);
+    liberarArvore(comLog.raiz);
+    liberarArvore(recuperada.raiz);
+    free(chaves);
+}
+
+// Medir a carga em lote de n chaves aleatórias (com repetidos) com 1, 2, 4...
+// até maxThreads threads, separando a ordenação da montagem, e comparar com
+// inserir uma a uma. Cada árvore montada é conferida com a ordenação.
+static void medirConstrucaoParalela(int n, int maxThreads) {
+    int *chaves = (int*)malloc(sizeof(int) * n);
+    int *trabalho = (int*)malloc(sizeof(int) * n);
+    int *emOrdem = (int*)malloc(sizeof(int) * n);
+    if (chaves == NULL || trabalho == NULL || emOrdem == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(chaves);
+        free(trabalho);
+        free(emOrdem);
+        return;
+    }
+    
+    unsigned int estado = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        chaves[i] = (int)(proximoAleatorio(&estado) >> 1);
+    }
+    
+    // Uma a uma, pela inserção
+    Arvore arvore;
+    inicializarArvore(&arvore);
+    double inicio = agora();
+    for (int i = 0; i < n; i++) {
+        arvore.raiz = inserir(arvore.raiz, chaves[i]);
+    }
+    double tempoInsercao = agora() - inicio;
+    printf("Inserção uma a uma: %.3f s (%d nós, altura %d)\n", tempoInsercao, contarNos(arvore.raiz), altura(arvore.raiz));
+    
+    double base = 0;
+    for (int threads = 1; ; threads = threads * 2 <= maxThreads ? threads * 2 : maxThreads) {
+        // A ordenação sozinha, e depois a carga inteira sobre outra cópia
+        for (int i = 0; i < n; i++) {
+            trabalho[i] = chaves[i];
+        }
+        inicio = agora();
+        ordenarSemRepetidos(trabalho, n, threads);
+        double tempoOrdenacao = agora() - inicio;
+        
+        for (int i = 0; i < n; i++) {
+            trabalho[i] = chaves[i];
+        }
+        liberarArvore(arvore.raiz);  // Fora do tempo medido
+        arvore.raiz = NULL;
+        inicio = agora();
+        int distintos = carregarEmParalelo(&arvore, trabalho, n, threads);
+        double total = agora() - inicio;
+        if (distintos < 0) break;
+        double tempoMontagem = total > tempoOrdenacao ? total - tempoOrdenacao : 0;
+        if (threads == 1) base = total;
+        
+        int pos = 0;
+        copiarEmOrdem(arvore.raiz, emOrdem, &pos);
+        bool confere = pos == distintos;
+        for (int i = 0; confere && i < distintos; i++) {
+            confere = emOrdem[i] == trabalho[i];
+        }
+        
+        printf("%3d threads: ordenação %.3f s + montagem %.3f s = %.3f s (%.2fx sobre 1 thread, %.1fx sobre a inserção), "
+               "%d chaves, altura %d, %s\n", threads, tempoOrdenacao, tempoMontagem, total, base / total,
+               tempoInsercao / total, distintos, altura(arvore.raiz), confere ? "conferida" : "DIFERENTE");
+        if (threads == maxThreads) break;
+    }
+    
+    liberarArvore(arvore.raiz);
+    free(chaves);
+    free(trabalho);
+    free(emOrdem);
+}
+
+#endif
+
+// 8. INTERFACE DE CONJUNTO (conjunto.h)
+
+// Estado do conjunto: a árvore e a quantidade de valores
+typedef struct {
+    Arvore arvore;
+    long long tamanho;
+} ConjuntoBST;
+
+static void* criarConjuntoBST(void) {
+    ConjuntoBST *conjunto = (ConjuntoBST*)malloc(sizeof(ConjuntoBST));
+    if (conjunto == NULL) return NULL;
+    inicializarArvore(&conjunto->arvore);
+    conjunto->tamanho = 0;
+    return conjunto;
+}
+
+static bool inserirConjuntoBST(void *estado, int chave) {
+    ConjuntoBST *conjunto = (ConjuntoBST*)estado;
+    if (buscar(conjunto->arvore.raiz, chave) != NULL) return false;
+    conjunto->arvore.raiz = inserir(conjunto->arvore.raiz, chave);
+    conjunto->tamanho++;
+    return true;
+}
+
+static bool contemConjuntoBST(void *estado, int chave) {
+    return buscar(((ConjuntoBST*)estado)->arvore.raiz, chave) != NULL;
+}
+
+static bool removerConjuntoBST(void *estado, int chave) {
+    ConjuntoBST *conjunto = (ConjuntoBST*)estado;
+    if (buscar(conjunto->arvore.raiz, chave) == NULL) return false;
+    conjunto->arvore.raiz = remover(conjunto->arvore.raiz, chave);
+    conjunto->tamanho--;
+    return true;
+}
+
+// Em ordem, chamando visitar para cada valor
+static void percorrerEmOrdem(No *raiz, ConjuntoVisitar visitar, void *contexto) {
+    if (raiz == NULL) return;
+    percorrerEmOrdem(raiz->esquerda, visitar, contexto);
+    visitar(raiz->valor, contexto);
+    percorrerEmOrdem(raiz->direita, visitar, contexto);
+}
+
+static void percorrerConjuntoBST(void *estado, ConjuntoVisitar visitar, void *contexto) {
+    percorrerEmOrdem(((ConjuntoBST*)estado)->arvore.raiz, visitar, contexto);
+}
+
+// Em ordem, descendo só nas subárvores que podem ter valores de [inicio, fim]
+static void percorrerIntervaloEmOrdem(No *raiz, int inicio, int fim, ConjuntoVisitar visitar, void *contexto) {
+    if (raiz == NULL) return;
+    if (inicio < raiz->valor) percorrerIntervaloEmOrdem(raiz->esquerda, inicio, fim, visitar, contexto);
+    if (inicio <= raiz->valor && raiz->valor <= fim) visitar(raiz->valor, contexto);
+    if (raiz->valor < fim) percorrerIntervaloEmOrdem(raiz->direita, inicio, fim, visitar, contexto);
+}
+
+static void percorrerIntervaloBST(void *estado, int inicio, int fim, ConjuntoVisitar visitar, void *contexto) {
+    percorrerIntervaloEmOrdem(((ConjuntoBST*)estado)->arvore.raiz, inicio, fim, visitar, contexto);
+}
+
+static long long tamanhoConjuntoBST(void *estado) {
+    return ((ConjuntoBST*)estado)->tamanho;
+}
+
+static int alturaConjuntoBST(void *estado) {
+    return altura(((ConjuntoBST*)estado)->arvore.raiz);
 }
 
+static Contadores* contadoresBST(void) {
+    return &contadores;
+}
+
+static void destruirConjuntoBST(void *estado) {
+    liberarArvore(((ConjuntoBST*)estado)->arvore.raiz);
+    free(estado);
+}
+
+const OperacoesConjunto conjuntoBST = {
+    "BST", criarConjuntoBST, inserirConjuntoBST, contemConjuntoBST, removerConjuntoBST,
+    percorrerConjuntoBST, percorrerIntervaloBST, tamanhoConjuntoBST, alturaConjuntoBST, destruirConjuntoBST, contadoresBST
+};
+
+#ifndef SEM_MAIN
+
 // Função para exibir o menu principal
-void exibirMenuPrincipal() {
+static void exibirMenuPrincipal() {
     printf("\n=== ÁRVORE BINÁRIA DE BUSCA ===\n");
     printf("1 - Inserir valor\n");
     printf("2 - Buscar valor\n");
     printf("3 - Remover valor\n");
     printf("4 - Percorrer árvore\n");
+    printf("5 - Abrir log e recuperar\n");
+    printf("6 - Medir log e recuperação\n");
+    printf("7 - Contadores de instrumentação\n");
+    printf("8 - Medir carga em lote paralela\n");
+    printf("9 - Latências das operações do menu\n");
     printf("0 - Sair\n");
     printf("Escolha uma opção: ");
 }
 
 // Função para exibir o submenu de percursos
-void exibirSubmenuPercursos() {
+static void exibirSubmenuPercursos() {
     printf("\n--- TIPOS DE PERCURSO ---\n");
     printf("1 - Pré-ordem\n");
     printf("2 - Em ordem\n");
@@ -184,13 +677,34 @@ void exibirSubmenuPercursos() {
     printf("Escolha o tipo de percurso: ");
 }
 
-// Função principal
-int main() {
+// Função principal. Com um nome de arquivo na linha de comando, as operações
+// de inserção, busca e remoção do menu são gravadas nele (rastro.h, replay.c).
+// Com -s e o caminho de um socket, a árvore atende pedidos pelo socket em vez
+// de abrir o menu (servidor.h, carga.c).
+int main(int argc, char **argv) {
+    // Modo servidor: arvorebst -s caminho.sock
+    if (argc > 2 && strcmp(argv[1], "-s") == 0) {
+        return servirConjunto(&conjuntoBST, argv[2]);
+    }
+    
     Arvore arvore;
     inicializarArvore(&arvore);
     
     int opcao, subOpcao, valor;
     No *resultadoBusca;
+    unsigned long long antes;
+    
+    // Latências das operações do menu (opção 9, e o relatório ao sair)
+    static LatenciasMenu latencias;
+    
+    // Log das operações (opção 5); cada operação do menu é confirmada na hora
+    static LogOperacoes logOperacoes;
+    bool logAtivo = false;
+    char base[200];
+    
+    // Rastro das operações, se o nome do arquivo vier na linha de comando
+    static Rastro rastro;
+    bool rastroAtivo = argc > 1 && rastroAbrir(&rastro, argv[1]);
     
     do {
         exibirMenuPrincipal();
@@ -200,14 +714,28 @@ int main() {
             case 1:
                 printf("Digite o valor a ser inserido: ");
                 scanf("%d", &valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_INSERIR, valor);
+                }
+                antes = histogramaAgora();
                 arvore.raiz = inserir(arvore.raiz, valor);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                if (logAtivo) {
+                    registrarOperacao(&logOperacoes, &arvore, LOG_INSERIR, valor);
+                    logConfirmar(&logOperacoes);
+                }
                 printf("Valor %d inserido na árvore.\n", valor);
                 break;
                 
             case 2:
                 printf("Digite o valor a ser buscado: ");
                 scanf("%d", &valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_BUSCAR, valor);
+                }
+                antes = histogramaAgora();
                 resultadoBusca = buscar(arvore.raiz, valor);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
                 if (resultadoBusca != NULL) {
                     printf("Valor %d encontrado na árvore.\n", valor);
                 } else {
@@ -218,9 +746,18 @@ int main() {
             case 3:
                 printf("Digite o valor a ser removido: ");
                 scanf("%d", &valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_REMOVER, valor);
+                }
+                antes = histogramaAgora();
                 resultadoBusca = buscar(arvore.raiz, valor);
                 if (resultadoBusca != NULL) {
                     arvore.raiz = remover(arvore.raiz, valor);
+                    latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                    if (logAtivo) {
+                        registrarOperacao(&logOperacoes, &arvore, LOG_REMOVER, valor);
+                        logConfirmar(&logOperacoes);
+                    }
                     printf("Valor %d removido da árvore.\n", valor);
                 } else {
                     printf("Valor %d não encontrado na árvore.\n", valor);
@@ -235,6 +772,7 @@ int main() {
                     scanf("%d", &subOpcao);
                     
                     printf("Percorrendo árvore: ");
+                    antes = histogramaAgora();
                     switch (subOpcao) {
                         case 1:
                             preOrdem(arvore.raiz);
@@ -251,8 +789,56 @@ int main() {
                         default:
                             printf("Opção inválida!\n");
                     }
+                    if (subOpcao >= 1 && subOpcao <= 3) {
+                        latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
+                    }
+                }
+                break;
+                
+            case 5:
+                printf("Nome base dos arquivos do log: ");
+                scanf("%199s", base);
+                if (logAtivo) {
+                    gravarInstantaneo(&logOperacoes, &arvore);
+                    logFechar(&logOperacoes);
+                }
+                // A árvore atual é substituída pela recuperada
+                logAtivo = abrirLog(&logOperacoes, &arvore, base, 1, INTERVALO_INSTANTANEO);
+                break;
+                
+            case 6: {
+                int grupo;
+                printf("Quantidade de operações: ");
+                scanf("%d", &valor);
+                printf("Operações por sincronização do log: ");
+                scanf("%d", &grupo);
+                if (valor > 0) {
+                    medirLog(valor, grupo);
+                }
+                break;
+            }
+                
+            case 7:
+                // Contagem desde a última consulta (ou desde o início)
+                imprimirContadores(&contadores);
+                zerarContadores(&contadores);
+                break;
+                
+            case 8: {
+                int maxThreads;
+                printf("Quantidade de chaves: ");
+                scanf("%d", &valor);
+                printf("Máximo de threads: ");
+                scanf("%d", &maxThreads);
+                if (valor > 0 && maxThreads > 0) {
+                    medirConstrucaoParalela(valor, maxThreads);
                 }
                 break;
+            }
+                
+            case 9:
+                latenciasImprimir(&latencias);
+                break;
                 
             case 0:
                 printf("Encerrando programa...\n");
@@ -264,9 +850,29 @@ int main() {
         
     } while (opcao != 0);
     
+    // Instantâneo final: o próximo início não precisa reaplicar o log
+    if (logAtivo) {
+        gravarInstantaneo(&logOperacoes, &arvore);
+        logFechar(&logOperacoes);
+    }
+    
+    if (rastroAtivo) {
+        if (rastroFechar(&rastro)) {
+            printf("Rastro com %lld operações gravado em %s.\n", rastro.operacoes, argv[1]);
+        } else {
+            printf("Erro: Falha ao gravar o rastro %s!\n", argv[1]);
+        }
+    }
+    
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+    
     // Liberar toda a memória alocada
     liberarArvore(arvore.raiz);
     printf("Memória liberada. Programa encerrado.\n");
     
     return 0;
-}
\ No newline at end of file
+}
+
+#endif
@@ -0,0 +1,342 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "conjunto.h"
+#include "histograma.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Comparação das estruturas de conjunto.h com cargas padronizadas, em CSV.
+// Compilar (as estruturas entram como módulos, sem os menus):
+//   gcc -O2 -DSEM_MAIN benchmark.c arvorebst.c arvoreRN.c arvore23.c lista.c -o benchmark -pthread -lm
+// (no Windows, acrescentar -lpsapi)
+//
+// Uso:
+//   benchmark                 todas as combinações de 10^3 a 10^6
+//   benchmark 8               todas as combinações de 10^3 a 10^8
+//   benchmark rn zipf mista 1000000
+//                             uma combinação (estrutura, chaves, carga, n)
+//
+// Cada combinação roda num processo separado (o programa chama a si mesmo),
+// então o pico de memória (RSS) é só o dela. O pico inclui o vetor de
+// posições da carga Zipf (4 bytes por operação), igual para todas as
+// estruturas. As cargas são repetíveis: a mesma semente em todas as execuções.
+//
+// Para acompanhar regressões entre commits: benchmark > resultados.csv
+//
+// Compilando todos os arquivos com -DCONTADORES=1, as últimas colunas trazem
+// os contadores de contadores.h da fase medida (comparações, nós visitados,
+// rotações, divisões...), que ajudam a explicar uma regressão; sem isso elas
+// saem zeradas.
+//
+// Com -DLATENCIAS=1 cada operação medida é cronometrada e vai para um
+// histograma do seu tipo (histograma.h), e depois da fase medida a árvore é
+// percorrida PERCURSOS_MEDIDOS vezes. As colunas finais trazem p50, p99,
+// p99,9 e o máximo em ns de inserção, busca, remoção e percurso (sem isso,
+// zeros). Os dois relógios por operação deixam ns_por_op um pouco maior.
+
+#define EXPOENTE_PADRAO 6
+#define LIMITE_QUADRATICO 10000    // Maior n para a lista e a BST com chaves em ordem
+#define TETA_ZIPF 0.99             // Expoente da distribuição Zipf (o mesmo do YCSB)
+#define PERCURSOS_MEDIDOS 10       // Percursos cronometrados com LATENCIAS
+
+#ifndef LATENCIAS
+#define LATENCIAS 0
+#endif
+
+// ===================== CARGAS =====================
+
+typedef enum { SEQUENCIAL, REVERSA, UNIFORME, ZIPF } TipoChaves;
+typedef enum { INSERCAO, LEITURA, MISTA } TipoCarga;
+
+static const char *nomesChaves[] = { "sequencial", "reversa", "uniforme", "zipf" };
+static const char *nomesCargas[] = { "insercao", "leitura", "mista" };
+
+// Tipos de operação, cada um com o seu histograma de latências
+typedef enum { OPERACAO_INSERCAO, OPERACAO_BUSCA, OPERACAO_REMOCAO, OPERACAO_PERCURSO, NUM_OPERACOES } TipoOperacao;
+
+// Estruturas, com o nome usado na linha de comando
+static const char *nomesEstruturas[] = { "bst", "rn", "23", "lista" };
+static const OperacoesConjunto *estruturas[] = { &conjuntoBST, &conjuntoRN, &conjuntoArvore23, &conjuntoLista };
+#define NUM_ESTRUTURAS 4
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+static unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Embaralhar i em [0, 2^31) sem repetir (bijeção): a i-ésima chave "aleatória"
+// pode ser recalculada a qualquer momento, sem guardar um vetor de chaves
+static int embaralhar(unsigned int i) {
+    i *= 2654435761u;
+    i ^= (i & 0x7FFFFFFFu) >> 15;
+    i *= 2246822519u;
+    return (int)(i & 0x7FFFFFFFu);
+}
+
+// Gerador Zipf de Gray et al. (o do YCSB): O(n) para preparar, O(1) por amostra
+typedef struct {
+    long long n;
+    double zetaN, alfa, eta, limite1;
+} GeradorZipf;
+
+static void iniciarZipf(GeradorZipf *zipf, long long n) {
+    double zeta2 = 1.0 + pow(0.5, TETA_ZIPF);
+    zipf->zetaN = 0;
+    for (long long i = 1; i <= n; i++) {
+        zipf->zetaN += 1.0 / pow((double)i, TETA_ZIPF);
+    }
+    zipf->n = n;
+    zipf->alfa = 1.0 / (1.0 - TETA_ZIPF);
+    zipf->eta = (1.0 - pow(2.0 / n, 1.0 - TETA_ZIPF)) / (1.0 - zeta2 / zipf->zetaN);
+    zipf->limite1 = zeta2;
+}
+
+// Posição em [0, n): a 0 é a mais frequente
+static long long amostrarZipf(GeradorZipf *zipf, unsigned int *estado) {
+    double u = (proximoAleatorio(estado) + 0.5) / 4294967296.0;
+    double uz = u * zipf->zetaN;
+    if (uz < 1.0) return 0;
+    if (uz < zipf->limite1) return 1;
+    long long posicao = (long long)(zipf->n * pow(zipf->eta * u - zipf->eta + 1.0, zipf->alfa));
+    return posicao < zipf->n ? posicao : zipf->n - 1;
+}
+
+// Chave da posição j (0 <= j < n) na carga inicial; posições j >= n são
+// chaves novas, usadas pelas inserções das cargas de leitura e mista
+static int chaveDaPosicao(TipoChaves tipo, long long j, long long n) {
+    switch (tipo) {
+        case SEQUENCIAL: return (int)j;
+        case REVERSA: return (int)(n - 1 - j);
+        default: return embaralhar((unsigned int)j);
+    }
+}
+
+// ===================== MEDIÇÃO =====================
+
+// Pico de memória do processo em KB
+static long picoMemoriaKB(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS contadores;
+    GetProcessMemoryInfo(GetCurrentProcess(), &contadores, sizeof(contadores));
+    return (long)(contadores.PeakWorkingSetSize / 1024);
+#else
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+#ifdef __APPLE__
+    return uso.ru_maxrss / 1024;  // No macOS vem em bytes
+#else
+    return uso.ru_maxrss;
+#endif
+#endif
+}
+
+// Segundos decorridos desde o instante inicio
+static double segundosDesde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Visitante dos percursos medidos: soma as chaves (o percurso não fica vazio)
+static void somarChave(int chave, void *contexto) {
+    *(long long*)contexto += chave;
+}
+
+// Rodar uma combinação e escrever a linha do CSV. São n operações medidas:
+//   insercao: n inserções das chaves na ordem da distribuição
+//   leitura:  carga de n chaves (não medida), depois 95% buscas e 5% inserções
+//   mista:    carga de n chaves (não medida), depois 50% buscas, 25%
+//             inserções de chaves novas e 25% remoções
+// Com chaves sequenciais e reversas as buscas e remoções seguem a ordem da
+// carga; com uniforme, posições aleatórias; com Zipf, posições Zipf.
+static int rodarCombinacao(int estrutura, TipoChaves tipoChaves, TipoCarga tipoCarga, long long n) {
+    // Posições Zipf calculadas antes, fora do tempo medido
+    int *posicoesZipf = NULL;
+    if (tipoChaves == ZIPF) {
+        posicoesZipf = (int*)malloc(sizeof(int) * n);
+        if (posicoesZipf == NULL) {
+            fprintf(stderr, "Erro: Falha na alocação de memória!\n");
+            return 1;
+        }
+        GeradorZipf zipf;
+        iniciarZipf(&zipf, n);
+        unsigned int estadoZipf = 88172645u;
+        for (long long i = 0; i < n; i++) {
+            posicoesZipf[i] = (int)amostrarZipf(&zipf, &estadoZipf);
+        }
+    }
+
+    Conjunto conjunto = conjuntoCriar(estruturas[estrutura]);
+    if (conjunto.estado == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória!\n");
+        free(posicoesZipf);
+        return 1;
+    }
+
+    // Carga inicial (não medida)
+    if (tipoCarga != INSERCAO) {
+        for (long long j = 0; j < n; j++) {
+            conjuntoInserir(&conjunto, chaveDaPosicao(tipoChaves, j, n));
+        }
+    }
+
+    // Histogramas de latência por tipo de operação (só com LATENCIAS)
+    static Histograma latencias[NUM_OPERACOES];
+    for (int o = 0; o < NUM_OPERACOES; o++) {
+        histogramaZerar(&latencias[o]);
+    }
+
+    unsigned int estado = 2463534242u;
+    long long novas = n;           // Próxima posição de chave nova
+    long long sucesso = 0;         // Operações que acharam, inseriram ou removeram
+
+    // Contadores só da fase medida
+    Contadores *contadores = conjuntoContadores(&conjunto);
+    zerarContadores(contadores);
+
+    clock_t inicio = clock();
+    for (long long i = 0; i < n; i++) {
+        long long j;
+        if (tipoChaves == ZIPF) j = posicoesZipf[i];
+        else if (tipoChaves == UNIFORME && tipoCarga != INSERCAO) j = proximoAleatorio(&estado) % n;
+        else j = i;
+
+        TipoOperacao operacao;
+        int chave;
+        unsigned int sorteio = tipoCarga == INSERCAO ? 0 : proximoAleatorio(&estado) % 100;
+        if (tipoCarga == INSERCAO) {
+            operacao = OPERACAO_INSERCAO;
+            chave = chaveDaPosicao(tipoChaves, j, n);
+        } else if (sorteio < (tipoCarga == LEITURA ? 95u : 50u)) {
+            operacao = OPERACAO_BUSCA;
+            chave = chaveDaPosicao(tipoChaves, j, n);
+        } else if (tipoCarga == LEITURA || sorteio < 75) {
+            // Chaves novas continuam a sequência (ou descem, na reversa)
+            long long nova = novas++;
+            operacao = OPERACAO_INSERCAO;
+            chave = tipoChaves == SEQUENCIAL ? (int)nova :
+                    tipoChaves == REVERSA ? (int)(n - 1 - nova) : embaralhar((unsigned int)nova);
+        } else {
+            operacao = OPERACAO_REMOCAO;
+            chave = chaveDaPosicao(tipoChaves, j, n);
+        }
+
+        unsigned long long antes = LATENCIAS ? histogramaAgora() : 0;
+        switch (operacao) {
+            case OPERACAO_INSERCAO: sucesso += conjuntoInserir(&conjunto, chave); break;
+            case OPERACAO_BUSCA: sucesso += conjuntoContem(&conjunto, chave); break;
+            default: sucesso += conjuntoRemover(&conjunto, chave); break;
+        }
+        if (LATENCIAS) {
+            histogramaRegistrar(&latencias[operacao], histogramaAgora() - antes);
+        }
+    }
+    double segundos = segundosDesde(inicio);
+    Contadores medidos = *contadores;
+
+    // Percursos completos, fora do tempo medido
+    if (LATENCIAS) {
+        long long soma = 0;
+        for (int p = 0; p < PERCURSOS_MEDIDOS; p++) {
+            unsigned long long antes = histogramaAgora();
+            conjuntoPercorrer(&conjunto, somarChave, &soma);
+            histogramaRegistrar(&latencias[OPERACAO_PERCURSO], histogramaAgora() - antes);
+        }
+    }
+
+    int altura = conjuntoAltura(&conjunto);
+    long long tamanho = conjuntoTamanho(&conjunto);
+    long pico = picoMemoriaKB();
+    conjuntoDestruir(&conjunto);
+    free(posicoesZipf);
+
+    if (segundos <= 0) segundos = 1e-9;
+    printf("%s,%s,%s,%lld,%lld,%.6f,%.0f,%.1f,%ld,%d,%lld,%lld,",
+           nomesEstruturas[estrutura], nomesChaves[tipoChaves], nomesCargas[tipoCarga], n, n,
+           segundos, n / segundos, segundos * 1e9 / n, pico, altura, tamanho, sucesso);
+    escreverContadoresCSV(stdout, &medidos);
+    for (int o = 0; o < NUM_OPERACOES; o++) {
+        printf(",");
+        histogramaEscreverCSV(stdout, &latencias[o]);
+    }
+    printf("\n");
+    fflush(stdout);
+    return 0;
+}
+
+// Combinações que levariam O(n^2): a lista sempre, e a BST com chaves em
+// ordem (vira uma lista, e a inserção recursiva estoura a pilha)
+static bool combinacaoQuadratica(int estrutura, TipoChaves tipoChaves) {
+    if (estruturas[estrutura] == &conjuntoLista) return true;
+    return estruturas[estrutura] == &conjuntoBST && (tipoChaves == SEQUENCIAL || tipoChaves == REVERSA);
+}
+
+// ===================== MAIN =====================
+
+// Índice de um nome numa lista de nomes (-1 se não estiver)
+static int procurarNome(const char *nome, const char **nomes, int quantidade) {
+    for (int i = 0; i < quantidade; i++) {
+        if (strcmp(nome, nomes[i]) == 0) return i;
+    }
+    return -1;
+}
+
+int main(int argc, char **argv) {
+    // Uma combinação
+    if (argc == 5) {
+        int estrutura = procurarNome(argv[1], nomesEstruturas, NUM_ESTRUTURAS);
+        int tipoChaves = procurarNome(argv[2], nomesChaves, 4);
+        int tipoCarga = procurarNome(argv[3], nomesCargas, 3);
+        long long n = atoll(argv[4]);
+        if (estrutura < 0 || tipoChaves < 0 || tipoCarga < 0 || n <= 0 || n > 1000000000LL) {
+            fprintf(stderr, "Combinação inválida: %s %s %s %s\n", argv[1], argv[2], argv[3], argv[4]);
+            return 1;
+        }
+        return rodarCombinacao(estrutura, (TipoChaves)tipoChaves, (TipoCarga)tipoCarga, n);
+    }
+
+    if (argc > 2) {
+        fprintf(stderr, "Uso: %s [expoente máximo] | %s estrutura chaves carga n\n", argv[0], argv[0]);
+        return 1;
+    }
+    int expoenteMaximo = argc == 2 ? atoi(argv[1]) : EXPOENTE_PADRAO;
+    if (expoenteMaximo < 3) expoenteMaximo = 3;
+    if (expoenteMaximo > 9) expoenteMaximo = 9;
+
+    // Todas as combinações, cada uma em um processo
+    printf("estrutura,chaves,carga,n,operacoes,segundos,ops_por_s,ns_por_op,rss_pico_kb,altura,tamanho_final,sucessos,"
+           CONTADORES_CABECALHO_CSV "," HISTOGRAMA_CABECALHO_CSV("insercao") "," HISTOGRAMA_CABECALHO_CSV("busca") ","
+           HISTOGRAMA_CABECALHO_CSV("remocao") "," HISTOGRAMA_CABECALHO_CSV("percurso") "\n");
+    fflush(stdout);
+    long long n = 1000;
+    for (int expoente = 3; expoente <= expoenteMaximo; expoente++, n *= 10) {
+        for (int estrutura = 0; estrutura < NUM_ESTRUTURAS; estrutura++) {
+            for (int tipoChaves = 0; tipoChaves < 4; tipoChaves++) {
+                if (n > LIMITE_QUADRATICO && combinacaoQuadratica(estrutura, (TipoChaves)tipoChaves)) {
+                    continue;
+                }
+                for (int tipoCarga = 0; tipoCarga < 3; tipoCarga++) {
+                    char comando[1024];
+                    snprintf(comando, sizeof(comando), "\"%s\" %s %s %s %lld", argv[0],
+                             nomesEstruturas[estrutura], nomesChaves[tipoChaves], nomesCargas[tipoCarga], n);
+                    if (system(comando) != 0) {
+                        fprintf(stderr, "Falhou: %s\n", comando);
+                    }
+                }
+            }
+        }
+    }
+    fprintf(stderr, "Lista e BST com chaves em ordem só até n = %d (custo quadrático).\n", LIMITE_QUADRATICO);
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "servidor.h"
+#include "histograma.h"
+
+// Gerador de carga para o modo servidor (servidor.h): mede vazão e latência
+// com várias profundidades de pipeline, isto é, quantos pedidos ficam em
+// trânsito ao mesmo tempo. Com profundidade 1 cada pedido espera a resposta
+// do anterior (como o menu); com profundidades maiores o servidor recebe
+// lotes e responde cada lote numa escrita só.
+//
+// Compilar:
+//   gcc -O2 carga.c -o carga
+//
+// Uso (o servidor já deve estar rodando, ex.: arvore23 -s /tmp/arvore23.sock):
+//   carga /tmp/arvore23.sock                      200000 pedidos por profundidade
+//   carga /tmp/arvore23.sock 1000000 1 8 64 512   pedidos e profundidades
+//
+// A carga tem 50% de buscas, 25% de inserções e 25% de remoções com chaves
+// uniformes em [0, CHAVES_CARGA), e uma consulta de intervalo (cerca de 30
+// chaves) a cada CADA_INTERVALO pedidos. Antes da medição o conjunto recebe
+// metade das chaves, todas distintas, sem medir; é a fração em que a carga se
+// mantém, já que inserções e remoções são igualmente prováveis. (Metade dos
+// pedidos com chaves sorteadas deixaria cerca de 63%, 1 - 1/e, por causa das
+// repetições.) A latência de um pedido vai do envio até a
+// chegada da sua resposta; as respostas que chegam na mesma leitura têm o
+// mesmo instante de chegada.
+//
+// A saída é CSV, uma linha por profundidade.
+
+#define CHAVES_CARGA 65536          // Espaço de chaves
+#define CADA_INTERVALO 100          // Pedidos entre consultas de intervalo
+#define LARGURA_INTERVALO 64        // Largura das consultas (cerca de metade das chaves presentes)
+#define PASSO_CARGA 40503u          // Ímpar perto de CHAVES_CARGA / φ (hash de Fibonacci)
+#define PROFUNDIDADE_MAXIMA 4096
+#define PEDIDOS_PADRAO 200000
+#define BUFFER_CARGA 65536
+
+#ifdef _WIN32
+
+int main(void) {
+    printf("Erro: O gerador de carga usa sockets Unix e não está disponível no Windows!\n");
+    return 1;
+}
+
+#else
+
+// Pedidos em trânsito, na ordem de envio (as respostas chegam nessa ordem)
+typedef struct {
+    unsigned char codigos[PROFUNDIDADE_MAXIMA];
+    unsigned long long enviados[PROFUNDIDADE_MAXIMA];   // Instante do envio (ns)
+    int primeiro;
+    int quantidade;
+} EmTransito;
+
+// Gerador pseudoaleatório simples (xorshift) para cargas repetíveis
+static unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Conectar ao servidor (-1 se não deu)
+static int conectar(const char *caminho) {
+    struct sockaddr_un endereco;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        fprintf(stderr, "Erro: Caminho do socket muito longo!\n");
+        return -1;
+    }
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&endereco, sizeof(endereco)) < 0) {
+        fprintf(stderr, "Erro: Não foi possível conectar a %s!\n", caminho);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Escrever o i-ésimo pedido da carga em bytes; retorna o tamanho. Na carga
+// inicial a chave é i * PASSO_CARGA módulo CHAVES_CARGA: como o passo é ímpar,
+// as chaves não se repetem, e saem espalhadas pelo espaço e fora de ordem (uma
+// BST não degenera).
+static int montarPedido(long long i, unsigned int *estado, bool carregando, unsigned char *bytes) {
+    int chave;
+    if (carregando) {
+        chave = (int)((unsigned int)i * PASSO_CARGA % CHAVES_CARGA);
+        bytes[0] = SERVIDOR_INSERIR;
+        servidorEscreverInteiro(bytes + 1, (uint32_t)chave);
+        return 5;
+    }
+
+    chave = (int)(proximoAleatorio(estado) % CHAVES_CARGA);
+    if (i % CADA_INTERVALO == CADA_INTERVALO - 1) {
+        bytes[0] = SERVIDOR_INTERVALO;
+        servidorEscreverInteiro(bytes + 1, (uint32_t)chave);
+        servidorEscreverInteiro(bytes + 5, (uint32_t)(chave + LARGURA_INTERVALO - 1));
+        return 9;
+    } else {
+        unsigned int sorteio = proximoAleatorio(estado) % 4;
+        bytes[0] = sorteio < 2 ? SERVIDOR_BUSCAR : sorteio == 2 ? SERVIDOR_INSERIR : SERVIDOR_REMOVER;
+    }
+    servidorEscreverInteiro(bytes + 1, (uint32_t)chave);
+    return 5;
+}
+
+// Mandar total pedidos mantendo até profundidade em trânsito. Com histograma,
+// registra a latência de cada um. Retorna quantos pedidos tiveram sucesso
+// (inserção nova, busca que achou, remoção de chave presente) e soma em
+// *chavesIntervalo as chaves devolvidas pelos intervalos; -1 se a conexão
+// falhou.
+static long long executarCarga(int fd, long long total, int profundidade, bool carregando, unsigned int *estado,
+                               Histograma *histograma, long long *chavesIntervalo) {
+    static unsigned char envio[PROFUNDIDADE_MAXIMA * 9];
+    static unsigned char recebidos[BUFFER_CARGA];
+    static EmTransito transito;
+    size_t usado = 0;
+    long long enviados = 0, respondidos = 0, sucessos = 0;
+    transito.primeiro = 0;
+    transito.quantidade = 0;
+
+    while (respondidos < total) {
+        // Completar a janela com pedidos novos, numa escrita só
+        size_t tamanhoEnvio = 0;
+        unsigned long long instante = histogramaAgora();
+        while (transito.quantidade < profundidade && enviados < total) {
+            unsigned char *pedido = envio + tamanhoEnvio;
+            tamanhoEnvio += montarPedido(enviados++, estado, carregando, pedido);
+            int posicao = (transito.primeiro + transito.quantidade++) % PROFUNDIDADE_MAXIMA;
+            transito.codigos[posicao] = pedido[0];
+            transito.enviados[posicao] = instante;
+        }
+        if (tamanhoEnvio > 0 && !servidorEscreverTudo(fd, envio, tamanhoEnvio)) return -1;
+
+        // Ler o que chegou e tirar da janela as respostas completas
+        ssize_t lidos = read(fd, recebidos + usado, sizeof(recebidos) - usado);
+        if (lidos < 0 && errno == EINTR) continue;
+        if (lidos <= 0) return -1;
+        usado += (size_t)lidos;
+        instante = histogramaAgora();
+
+        size_t lido = 0;
+        while (transito.quantidade > 0) {
+            unsigned char codigo = transito.codigos[transito.primeiro];
+            if (codigo == SERVIDOR_INTERVALO) {
+                if (lido + 4 > usado) break;
+                uint32_t quantidade = (uint32_t)servidorLerInteiro(recebidos + lido);
+                if (4 + 4 * (size_t)quantidade > sizeof(recebidos)) {
+                    fprintf(stderr, "Erro: Resposta de intervalo maior que o buffer!\n");
+                    return -1;
+                }
+                if (lido + 4 + 4 * (size_t)quantidade > usado) break;
+                lido += 4 + 4 * (size_t)quantidade;
+                *chavesIntervalo += quantidade;
+            } else {
+                if (lido + 1 > usado) break;
+                sucessos += recebidos[lido++];
+            }
+            if (histograma != NULL) {
+                histogramaRegistrar(histograma, instante - transito.enviados[transito.primeiro]);
+            }
+            transito.primeiro = (transito.primeiro + 1) % PROFUNDIDADE_MAXIMA;
+            transito.quantidade--;
+            respondidos++;
+        }
+        usado -= lido;
+        memmove(recebidos, recebidos + lido, usado);
+    }
+    return sucessos;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s socket [pedidos] [profundidades...]\n", argv[0]);
+        return 1;
+    }
+    long long pedidos = argc > 2 ? atoll(argv[2]) : PEDIDOS_PADRAO;
+    int padrao[] = { 1, 4, 16, 64, 256 };
+    int numProfundidades = argc > 3 ? argc - 3 : 5;
+    if (pedidos < 1) {
+        fprintf(stderr, "Quantidade de pedidos inválida!\n");
+        return 1;
+    }
+
+    int fd = conectar(argv[1]);
+    if (fd < 0) return 1;
+
+    // Metade das chaves, distintas, sem medir
+    unsigned int estado = 2463534242u;
+    long long chavesIntervalo = 0;
+    if (executarCarga(fd, CHAVES_CARGA / 2, 256, true, &estado, NULL, &chavesIntervalo) < 0) {
+        fprintf(stderr, "Erro: Conexão perdida!\n");
+        close(fd);
+        return 1;
+    }
+
+    static Histograma histograma;
+    printf("profundidade,pedidos,segundos,pedidos_por_s,sucessos,chaves_por_intervalo," HISTOGRAMA_CABECALHO_CSV("latencia_ns") "\n");
+    for (int p = 0; p < numProfundidades; p++) {
+        int profundidade = argc > 3 ? atoi(argv[3 + p]) : padrao[p];
+        if (profundidade < 1 || profundidade > PROFUNDIDADE_MAXIMA) {
+            fprintf(stderr, "Profundidade inválida: %d (de 1 a %d)\n", profundidade, PROFUNDIDADE_MAXIMA);
+            continue;
+        }
+
+        histogramaZerar(&histograma);
+        chavesIntervalo = 0;
+        unsigned long long inicio = histogramaAgora();
+        long long sucessos = executarCarga(fd, pedidos, profundidade, false, &estado, &histograma, &chavesIntervalo);
+        double segundos = (histogramaAgora() - inicio) / 1e9;
+        if (sucessos < 0) {
+            fprintf(stderr, "Erro: Conexão perdida!\n");
+            close(fd);
+            return 1;
+        }
+
+        long long intervalos = pedidos / CADA_INTERVALO;
+        printf("%d,%lld,%.6f,%.0f,%lld,%.1f,", profundidade, pedidos, segundos, pedidos / segundos, sucessos,
+               intervalos > 0 ? (double)chavesIntervalo / intervalos : 0.0);
+        histogramaEscreverCSV(stdout, &histograma);
+        printf("\n");
+        fflush(stdout);
+    }
+
+    close(fd);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,107 @@
+// Interface comum de conjunto ordenado de chaves int.
+//
+// arvorebst.c, arvoreRN.c, arvore23.c e lista.c podem ser compilados como
+// módulos, sem o menu e sem main, com -DSEM_MAIN:
+//
+//   gcc -c -DSEM_MAIN arvore23.c -o arvore23.o
+//
+// Todas as funções desses arquivos são static; cada módulo exporta só a sua
+// tabela de operações (conjuntoBST, conjuntoRN, conjuntoArvore23 e
+// conjuntoLista). Assim os módulos podem ser ligados no mesmo programa e
+// trocados atrás da mesma chamada:
+//
+//   Conjunto conjunto = conjuntoCriar(&conjuntoArvore23);
+//   conjuntoInserir(&conjunto, 42);
+//   conjuntoPercorrer(&conjunto, imprimirChave, NULL);
+//   conjuntoDestruir(&conjunto);
+//
+// Cada operação custa uma chamada indireta pela tabela. Os módulos guardam o
+// tamanho à parte, então conjuntoTamanho é O(1) em todos.
+
+#ifndef CONJUNTO_H
+#define CONJUNTO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "contadores.h"
+
+// Função chamada para cada chave, em ordem crescente, por conjuntoPercorrer
+typedef void (*ConjuntoVisitar)(int chave, void *contexto);
+
+// Operações de uma implementação de conjunto
+typedef struct {
+    const char *nome;
+    void* (*criar)(void);                       // Conjunto vazio (NULL se faltar memória)
+    bool (*inserir)(void *estado, int chave);   // false se a chave já estava
+    bool (*contem)(void *estado, int chave);
+    bool (*remover)(void *estado, int chave);   // false se a chave não estava
+    void (*percorrer)(void *estado, ConjuntoVisitar visitar, void *contexto);
+    void (*percorrerIntervalo)(void *estado, int inicio, int fim, ConjuntoVisitar visitar, void *contexto);
+    long long (*tamanho)(void *estado);
+    int (*altura)(void *estado);                // Nós no caminho mais longo da raiz (lista: o tamanho)
+    void (*destruir)(void *estado);
+    Contadores* (*contadores)(void);            // Contadores do módulo, comuns a todos os seus conjuntos
+} OperacoesConjunto;
+
+// Um conjunto: a implementação escolhida e o seu estado
+typedef struct {
+    const OperacoesConjunto *operacoes;
+    void *estado;
+} Conjunto;
+
+// Tabelas exportadas pelos módulos
+extern const OperacoesConjunto conjuntoBST;
+extern const OperacoesConjunto conjuntoRN;
+extern const OperacoesConjunto conjuntoArvore23;
+extern const OperacoesConjunto conjuntoLista;
+
+// Criar um conjunto vazio com a implementação indicada (estado NULL se faltar memória)
+static inline Conjunto conjuntoCriar(const OperacoesConjunto *operacoes) {
+    Conjunto conjunto = { operacoes, operacoes->criar() };
+    return conjunto;
+}
+
+static inline bool conjuntoInserir(Conjunto *conjunto, int chave) {
+    return conjunto->operacoes->inserir(conjunto->estado, chave);
+}
+
+static inline bool conjuntoContem(Conjunto *conjunto, int chave) {
+    return conjunto->operacoes->contem(conjunto->estado, chave);
+}
+
+static inline bool conjuntoRemover(Conjunto *conjunto, int chave) {
+    return conjunto->operacoes->remover(conjunto->estado, chave);
+}
+
+// Visitar as chaves em ordem crescente
+static inline void conjuntoPercorrer(Conjunto *conjunto, ConjuntoVisitar visitar, void *contexto) {
+    conjunto->operacoes->percorrer(conjunto->estado, visitar, contexto);
+}
+
+// Visitar em ordem crescente só as chaves de [inicio, fim]
+static inline void conjuntoPercorrerIntervalo(Conjunto *conjunto, int inicio, int fim, ConjuntoVisitar visitar, void *contexto) {
+    conjunto->operacoes->percorrerIntervalo(conjunto->estado, inicio, fim, visitar, contexto);
+}
+
+static inline long long conjuntoTamanho(Conjunto *conjunto) {
+    return conjunto->operacoes->tamanho(conjunto->estado);
+}
+
+static inline int conjuntoAltura(Conjunto *conjunto) {
+    return conjunto->operacoes->altura(conjunto->estado);
+}
+
+// Contadores de instrumentação da implementação (zerados sem -DCONTADORES=1)
+static inline Contadores* conjuntoContadores(Conjunto *conjunto) {
+    return conjunto->operacoes->contadores();
+}
+
+// Liberar o conjunto e todas as suas chaves
+static inline void conjuntoDestruir(Conjunto *conjunto) {
+    if (conjunto->estado != NULL) {
+        conjunto->operacoes->destruir(conjunto->estado);
+    }
+    conjunto->estado = NULL;
+}
+
+#endif
@@ -0,0 +1,77 @@
+// Contadores de instrumentação das operações das estruturas.
+//
+// Ligados com -DCONTADORES=1 (em todos os arquivos do programa); sem isso as
+// chamadas a CONTAR somem na compilação e os contadores ficam em zero. Cada
+// módulo tem um conjunto de contadores para todas as suas árvores, lido pela
+// função contadores da tabela de conjunto.h ou pelo menu de cada programa.
+//
+// Os incrementos são somas atômicas relaxadas, porque as operações de conjuntos
+// e as construções em lote em paralelo e os trabalhadores de particionado.c
+// contam de várias threads ao mesmo tempo. A leitura e o zeramento são feitos
+// com as threads já terminadas.
+
+#ifndef CONTADORES_H
+#define CONTADORES_H
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef CONTADORES
+#define CONTADORES 0
+#endif
+
+typedef struct {
+    unsigned long long comparacoes;     // Comparações de chaves
+    unsigned long long nosVisitados;    // Nós visitados nas descidas e percursos
+    unsigned long long rotacoes;        // Rotações (rubro-negra)
+    unsigned long long correcoes;       // Iterações das correções após inserção e remoção
+    unsigned long long divisoes;        // Divisões de nós (árvore B)
+    unsigned long long fusoes;          // Fusões de nós (árvore B)
+    unsigned long long redistribuicoes; // Redistribuições entre irmãos (árvore B)
+    unsigned long long alocacoes;       // Nós alocados
+    unsigned long long liberacoes;      // Nós liberados
+} Contadores;
+
+#if CONTADORES
+#define CONTAR(contadores, campo) ((void)__atomic_fetch_add(&(contadores).campo, 1ULL, __ATOMIC_RELAXED))
+#define CONTAR_VARIOS(contadores, campo, quantidade) \
+    ((void)__atomic_fetch_add(&(contadores).campo, (unsigned long long)(quantidade), __ATOMIC_RELAXED))
+#else
+#define CONTAR(contadores, campo) ((void)0)
+#define CONTAR_VARIOS(contadores, campo, quantidade) ((void)0)
+#endif
+
+// Cabeçalho das colunas escritas por escreverContadoresCSV
+#define CONTADORES_CABECALHO_CSV \
+    "comparacoes,nos_visitados,rotacoes,correcoes,divisoes,fusoes,redistribuicoes,alocacoes,liberacoes"
+
+static inline void zerarContadores(Contadores *contadores) {
+    memset(contadores, 0, sizeof(Contadores));
+}
+
+// Exibir os contadores, um por linha
+static inline void imprimirContadores(const Contadores *contadores) {
+    if (!CONTADORES) {
+        printf("Contadores desligados (compile com -DCONTADORES=1).\n");
+        return;
+    }
+    printf("Comparações:      %llu\n", contadores->comparacoes);
+    printf("Nós visitados:    %llu\n", contadores->nosVisitados);
+    printf("Rotações:         %llu\n", contadores->rotacoes);
+    printf("Correções:        %llu\n", contadores->correcoes);
+    printf("Divisões:         %llu\n", contadores->divisoes);
+    printf("Fusões:           %llu\n", contadores->fusoes);
+    printf("Redistribuições:  %llu\n", contadores->redistribuicoes);
+    printf("Alocações:        %llu\n", contadores->alocacoes);
+    printf("Liberações:       %llu\n", contadores->liberacoes);
+}
+
+// Escrever os contadores como colunas de CSV, na ordem do cabeçalho
+static inline void escreverContadoresCSV(FILE *arquivo, const Contadores *contadores) {
+    fprintf(arquivo, "%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu",
+            contadores->comparacoes, contadores->nosVisitados, contadores->rotacoes,
+            contadores->correcoes, contadores->divisoes, contadores->fusoes,
+            contadores->redistribuicoes, contadores->alocacoes, contadores->liberacoes);
+}
+
+#endif
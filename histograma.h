@@ -0,0 +1,151 @@
+// Histograma de latências no estilo HDR: baldes log-lineares, com
+// HISTOGRAMA_SUBDIVISOES baldes por potência de 2. Registrar um valor custa
+// um índice calculado com alguns deslocamentos e um incremento; o erro
+// relativo de um percentil é no máximo 1/HISTOGRAMA_SUBDIVISOES (cerca de 3%).
+// O máximo é guardado exato.
+//
+// Os valores são nanossegundos medidos com histogramaAgora (relógio
+// monotônico, clock_gettime). Cada thread deve registrar no seu próprio
+// histograma; no fim eles são somados com histogramaJuntar.
+
+#ifndef HISTOGRAMA_H
+#define HISTOGRAMA_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define HISTOGRAMA_BITS 5                               // log2 das subdivisões
+#define HISTOGRAMA_SUBDIVISOES (1 << HISTOGRAMA_BITS)   // Baldes por potência de 2
+#define HISTOGRAMA_MAGNITUDE 40                         // Valores até 2^40 ns (cerca de 18 minutos)
+#define HISTOGRAMA_BALDES ((HISTOGRAMA_MAGNITUDE - HISTOGRAMA_BITS + 1) * HISTOGRAMA_SUBDIVISOES)
+
+typedef struct {
+    unsigned long long baldes[HISTOGRAMA_BALDES];
+    unsigned long long contagem;
+    unsigned long long soma;
+    unsigned long long maximo;
+} Histograma;
+
+// Instante atual em nanossegundos (relógio monotônico)
+static inline unsigned long long histogramaAgora(void) {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return (unsigned long long)instante.tv_sec * 1000000000ULL + (unsigned long long)instante.tv_nsec;
+}
+
+static inline void histogramaZerar(Histograma *histograma) {
+    memset(histograma, 0, sizeof(Histograma));
+}
+
+// Balde de um valor: os menores que HISTOGRAMA_SUBDIVISOES têm um balde cada;
+// acima disso, cada potência de 2 é dividida em HISTOGRAMA_SUBDIVISOES partes
+static inline int histogramaBalde(unsigned long long valor) {
+    if (valor < HISTOGRAMA_SUBDIVISOES) return (int)valor;
+    if (valor >> HISTOGRAMA_MAGNITUDE) return HISTOGRAMA_BALDES - 1;
+
+    int magnitude = 63 - __builtin_clzll(valor);   // Posição do bit mais alto
+    int deslocamento = magnitude - HISTOGRAMA_BITS;
+    return ((deslocamento + 1) << HISTOGRAMA_BITS) + (int)((valor >> deslocamento) - HISTOGRAMA_SUBDIVISOES);
+}
+
+// Maior valor que cai no balde indicado
+static inline unsigned long long histogramaLimiteBalde(int balde) {
+    if (balde < HISTOGRAMA_SUBDIVISOES) return (unsigned long long)balde;
+
+    int deslocamento = (balde >> HISTOGRAMA_BITS) - 1;
+    unsigned long long base = (unsigned long long)((balde & (HISTOGRAMA_SUBDIVISOES - 1)) + HISTOGRAMA_SUBDIVISOES);
+    return ((base + 1) << deslocamento) - 1;
+}
+
+static inline void histogramaRegistrar(Histograma *histograma, unsigned long long valor) {
+    histograma->baldes[histogramaBalde(valor)]++;
+    histograma->contagem++;
+    histograma->soma += valor;
+    if (valor > histograma->maximo) histograma->maximo = valor;
+}
+
+// Somar ao destino os valores de outro histograma (de outra thread, por exemplo)
+static inline void histogramaJuntar(Histograma *destino, const Histograma *origem) {
+    for (int i = 0; i < HISTOGRAMA_BALDES; i++) {
+        destino->baldes[i] += origem->baldes[i];
+    }
+    destino->contagem += origem->contagem;
+    destino->soma += origem->soma;
+    if (origem->maximo > destino->maximo) destino->maximo = origem->maximo;
+}
+
+// Valor abaixo do qual (ou igual) ficam percentil% dos registros (0 se vazio).
+// É o limite superior do balde, nunca maior que o máximo registrado.
+static inline unsigned long long histogramaPercentil(const Histograma *histograma, double percentil) {
+    if (histograma->contagem == 0) return 0;
+
+    unsigned long long alvo = (unsigned long long)(percentil / 100.0 * histograma->contagem + 0.5);
+    if (alvo < 1) alvo = 1;
+    if (alvo > histograma->contagem) alvo = histograma->contagem;
+
+    unsigned long long acumulado = 0;
+    for (int i = 0; i < HISTOGRAMA_BALDES; i++) {
+        acumulado += histograma->baldes[i];
+        if (acumulado >= alvo) {
+            unsigned long long limite = histogramaLimiteBalde(i);
+            return limite < histograma->maximo ? limite : histograma->maximo;
+        }
+    }
+    return histograma->maximo;
+}
+
+// Exibir uma linha com a contagem, a média, p50, p99, p99,9 e o máximo (ns)
+static inline void histogramaImprimir(const char *nome, const Histograma *histograma) {
+    if (histograma->contagem == 0) {
+        printf("%s: sem registros\n", nome);
+        return;
+    }
+    printf("%s: n = %llu  média %.0f ns  p50 %llu ns  p99 %llu ns  p99,9 %llu ns  máx %llu ns\n",
+           nome, histograma->contagem, (double)histograma->soma / histograma->contagem,
+           histogramaPercentil(histograma, 50), histogramaPercentil(histograma, 99),
+           histogramaPercentil(histograma, 99.9), histograma->maximo);
+}
+
+// Cabeçalho das colunas de histogramaEscreverCSV, com o prefixo dado (ex.: "busca")
+#define HISTOGRAMA_CABECALHO_CSV(prefixo) prefixo "_p50," prefixo "_p99," prefixo "_p999," prefixo "_max"
+
+// Escrever p50, p99, p99,9 e o máximo (ns) como colunas de CSV
+static inline void histogramaEscreverCSV(FILE *arquivo, const Histograma *histograma) {
+    fprintf(arquivo, "%llu,%llu,%llu,%llu", histogramaPercentil(histograma, 50),
+            histogramaPercentil(histograma, 99), histogramaPercentil(histograma, 99.9), histograma->maximo);
+}
+
+// Latências das operações feitas pelo menu de um programa, uma por tipo. O
+// menu cronometra só a chamada da operação (sem a leitura do teclado); o
+// percurso inclui a impressão dos valores, que é o que ele faz.
+typedef enum { LATENCIA_INSERCAO, LATENCIA_BUSCA, LATENCIA_REMOCAO, LATENCIA_PERCURSO, NUM_LATENCIAS } TipoLatencia;
+
+typedef struct {
+    Histograma operacoes[NUM_LATENCIAS];
+} LatenciasMenu;
+
+// Registrar uma operação do tipo dado que começou no instante antes
+static inline void latenciasRegistrar(LatenciasMenu *latencias, TipoLatencia tipo, unsigned long long antes) {
+    histogramaRegistrar(&latencias->operacoes[tipo], histogramaAgora() - antes);
+}
+
+// Indica se alguma operação foi registrada
+static inline bool latenciasRegistradas(const LatenciasMenu *latencias) {
+    for (int t = 0; t < NUM_LATENCIAS; t++) {
+        if (latencias->operacoes[t].contagem > 0) return true;
+    }
+    return false;
+}
+
+// Exibir p50, p99, p99,9 e o máximo de cada tipo de operação
+static inline void latenciasImprimir(const LatenciasMenu *latencias) {
+    static const char *nomes[NUM_LATENCIAS] = { "Inserção", "Busca", "Remoção", "Percurso" };
+    printf("\n--- LATÊNCIAS DAS OPERAÇÕES DO MENU ---\n");
+    for (int t = 0; t < NUM_LATENCIAS; t++) {
+        histogramaImprimir(nomes[t], &latencias->operacoes[t]);
+    }
+}
+
+#endif
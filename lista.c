@@ -1,5 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "conjunto.h"
+#include "contadores.h"
+#include "rastro.h"
+#include "servidor.h"
+#include "histograma.h"
+
+// Como módulo (-DSEM_MAIN, ver conjunto.h), só a interface de conjunto fica:
+// as operações por posição do menu ficam de fora (#ifndef SEM_MAIN)
 
 typedef struct No {
     int valor;
@@ -13,29 +21,37 @@ typedef struct {
     int tamanho;
 } Lista;
 
-void inicializarLista(Lista *lista) {
+// Contadores de instrumentação de todas as listas do módulo (contadores.h)
+static Contadores contadores;
+
+static void inicializarLista(Lista *lista) {
     lista->inicio = NULL;
     lista->fim = NULL;
     lista->tamanho = 0;
 }
 
-int listaVazia(Lista *lista) {
+#ifndef SEM_MAIN
+static int listaVazia(Lista *lista) {
     return lista->inicio == NULL;
 }
+#endif
 
-No* criarNo(int valor) {
+static No* criarNo(int valor) {
     No *novoNo = (No*)malloc(sizeof(No));
     if (novoNo == NULL) {
         printf("Erro: Falha na alocação de memória!\n");
         return NULL;
     }
+    CONTAR(contadores, alocacoes);
     novoNo->valor = valor;
     novoNo->anterior = NULL;
     novoNo->proximo = NULL;
     return novoNo;
 }
 
-void inserirInicio(Lista *lista, int valor) {
+#ifndef SEM_MAIN
+
+static void inserirInicio(Lista *lista, int valor) {
     No *novoNo = criarNo(valor);
     if (novoNo == NULL) return;
     
@@ -51,7 +67,7 @@ void inserirInicio(Lista *lista, int valor) {
     printf("Valor %d inserido no início da lista.\n", valor);
 }
 
-void inserirPosicao(Lista *lista, int valor, int posicao) {
+static void inserirPosicao(Lista *lista, int valor, int posicao) {
     if (posicao < 1 || posicao > lista->tamanho + 1) {
         printf("Erro: Posicao inválida! A lista tem %d elementos.\n", lista->tamanho);
         return;
@@ -84,7 +100,7 @@ void inserirPosicao(Lista *lista, int valor, int posicao) {
     printf("Valor %d inserido na posicao %d.\n", valor, posicao);
 }
 
-void inserirFinal(Lista *lista, int valor) {
+static void inserirFinal(Lista *lista, int valor) {
     No *novoNo = criarNo(valor);
     if (novoNo == NULL) return;
     
@@ -100,15 +116,16 @@ void inserirFinal(Lista *lista, int valor) {
     printf("Valor %d inserido no final da lista.\n", valor);
 }
 
-void removerPosicao(Lista *lista, int posicao) {
+// Retorna se removeu; o valor removido fica em *removido
+static bool removerPosicao(Lista *lista, int posicao, int *removido) {
     if (listaVazia(lista)) {
         printf("Erro: Lista vazia! Não é possível remover.\n");
-        return;
+        return false;
     }
     
     if (posicao < 1 || posicao > lista->tamanho) {
         printf("Erro: Posicao inválida! A lista tem %d elementos.\n", lista->tamanho);
-        return;
+        return false;
     }
     
     No *noRemover;
@@ -138,12 +155,15 @@ void removerPosicao(Lista *lista, int posicao) {
     
     int valorRemovido = noRemover->valor;
     free(noRemover);
+    CONTAR(contadores, liberacoes);
     lista->tamanho--;
     
     printf("Valor %d removido da posicao %d.\n", valorRemovido, posicao);
+    *removido = valorRemovido;
+    return true;
 }
 
-int buscarValor(Lista *lista, int valor) {
+static int buscarValor(Lista *lista, int valor) {
     if (listaVazia(lista)) {
         printf("Lista vazia! Valor não encontrado.\n");
         return -1;
@@ -165,7 +185,7 @@ int buscarValor(Lista *lista, int valor) {
     return -1;
 }
 
-void listarElementos(Lista *lista) {
+static void listarElementos(Lista *lista) {
     if (listaVazia(lista)) {
         printf("Lista vazia!\n");
         return;
@@ -202,13 +222,14 @@ void listarElementos(Lista *lista) {
     printf("==========================\n");
 }
 
-void destruirLista(Lista *lista) {
+static void destruirLista(Lista *lista) {
     No *atual = lista->inicio;
     No *proximo;
     
     while (atual != NULL) {
         proximo = atual->proximo;
         free(atual);
+        CONTAR(contadores, liberacoes);
         atual = proximo;
     }
     
@@ -218,7 +239,131 @@ void destruirLista(Lista *lista) {
     printf("Lista destruída e memória liberada.\n");
 }
 
-void exibirMenu() {
+#endif
+
+// Interface de conjunto (conjunto.h): a lista mantida em ordem crescente e
+// sem repetidos. Inserir, buscar e remover são O(n); inserir em ordem
+// crescente é O(1), pelo fim.
+
+static void* criarConjuntoLista(void) {
+    Lista *lista = (Lista*)malloc(sizeof(Lista));
+    if (lista == NULL) return NULL;
+    inicializarLista(lista);
+    return lista;
+}
+
+// Primeiro nó com valor >= chave (NULL se não houver)
+static No* primeiroMaiorOuIgual(Lista *lista, int chave) {
+    CONTAR(contadores, comparacoes);  // Com o fim
+    if (lista->fim == NULL || lista->fim->valor < chave) return NULL;
+    
+    No *atual = lista->inicio;
+    while (atual->valor < chave) {
+        CONTAR(contadores, nosVisitados);
+        CONTAR(contadores, comparacoes);
+        atual = atual->proximo;
+    }
+    CONTAR(contadores, nosVisitados);  // O nó devolvido
+    CONTAR(contadores, comparacoes);
+    return atual;
+}
+
+static bool inserirConjuntoLista(void *estado, int chave) {
+    Lista *lista = (Lista*)estado;
+    No *seguinte = primeiroMaiorOuIgual(lista, chave);
+    if (seguinte != NULL && seguinte->valor == chave) return false;
+    
+    No *novoNo = criarNo(chave);
+    if (novoNo == NULL) return false;
+    
+    // Ligar antes de seguinte (ou no fim)
+    novoNo->proximo = seguinte;
+    novoNo->anterior = seguinte != NULL ? seguinte->anterior : lista->fim;
+    if (novoNo->anterior != NULL) {
+        novoNo->anterior->proximo = novoNo;
+    } else {
+        lista->inicio = novoNo;
+    }
+    if (seguinte != NULL) {
+        seguinte->anterior = novoNo;
+    } else {
+        lista->fim = novoNo;
+    }
+    lista->tamanho++;
+    return true;
+}
+
+static bool contemConjuntoLista(void *estado, int chave) {
+    No *no = primeiroMaiorOuIgual((Lista*)estado, chave);
+    return no != NULL && no->valor == chave;
+}
+
+static bool removerConjuntoLista(void *estado, int chave) {
+    Lista *lista = (Lista*)estado;
+    No *no = primeiroMaiorOuIgual(lista, chave);
+    if (no == NULL || no->valor != chave) return false;
+    
+    if (no->anterior != NULL) {
+        no->anterior->proximo = no->proximo;
+    } else {
+        lista->inicio = no->proximo;
+    }
+    if (no->proximo != NULL) {
+        no->proximo->anterior = no->anterior;
+    } else {
+        lista->fim = no->anterior;
+    }
+    free(no);
+    CONTAR(contadores, liberacoes);
+    lista->tamanho--;
+    return true;
+}
+
+static void percorrerConjuntoLista(void *estado, ConjuntoVisitar visitar, void *contexto) {
+    for (No *atual = ((Lista*)estado)->inicio; atual != NULL; atual = atual->proximo) {
+        visitar(atual->valor, contexto);
+    }
+}
+
+static void percorrerIntervaloLista(void *estado, int inicio, int fim, ConjuntoVisitar visitar, void *contexto) {
+    for (No *atual = primeiroMaiorOuIgual((Lista*)estado, inicio); atual != NULL && atual->valor <= fim; atual = atual->proximo) {
+        visitar(atual->valor, contexto);
+    }
+}
+
+static long long tamanhoConjuntoLista(void *estado) {
+    return ((Lista*)estado)->tamanho;
+}
+
+// Uma busca pode percorrer a lista inteira
+static int alturaConjuntoLista(void *estado) {
+    return ((Lista*)estado)->tamanho;
+}
+
+static Contadores* contadoresLista(void) {
+    return &contadores;
+}
+
+static void destruirConjuntoLista(void *estado) {
+    No *atual = ((Lista*)estado)->inicio;
+    while (atual != NULL) {
+        No *proximo = atual->proximo;
+        free(atual);
+        CONTAR(contadores, liberacoes);
+        atual = proximo;
+    }
+    free(estado);
+}
+
+const OperacoesConjunto conjuntoLista = {
+    "Lista", criarConjuntoLista, inserirConjuntoLista, contemConjuntoLista, removerConjuntoLista,
+    percorrerConjuntoLista, percorrerIntervaloLista, tamanhoConjuntoLista, alturaConjuntoLista, destruirConjuntoLista,
+    contadoresLista
+};
+
+#ifndef SEM_MAIN
+
+static void exibirMenu() {
     printf("\n=== LISTA DUPLAMENTE ENCADEADA ===\n");
     printf("1. Inserir no inicio\n");
     printf("2. Inserir em posicao especifica\n");
@@ -227,14 +372,31 @@ void exibirMenu() {
     printf("5. Buscar valor\n");
     printf("6. Listar elementos\n");
     printf("7. Sair\n");
+    printf("8. Latencias das operacoes do menu\n");
     printf("Escolha uma opcao: ");
 }
 
-int main() {
+// Com um nome de arquivo na linha de comando, as inserções, buscas e remoções
+// do menu são gravadas nele (rastro.h, replay.c); a remoção por posição entra
+// com o valor removido. Com -s e o caminho de um socket, a lista atende
+// pedidos pelo socket em vez de abrir o menu (servidor.h, carga.c).
+int main(int argc, char **argv) {
+    // Modo servidor: lista -s caminho.sock
+    if (argc > 2 && strcmp(argv[1], "-s") == 0) {
+        return servirConjunto(&conjuntoLista, argv[2]);
+    }
+    
     Lista lista;
     inicializarLista(&lista);
     
-    int opcao, valor, posicao;
+    int opcao, valor, posicao, tamanhoAntes;
+    unsigned long long antes;
+    
+    // Latências das operações do menu (opção 8, e o relatório ao sair)
+    static LatenciasMenu latencias;
+    
+    static Rastro rastro;
+    bool rastroAtivo = argc > 1 && rastroAbrir(&rastro, argv[1]);
     
     do {
         exibirMenu();
@@ -244,49 +406,98 @@ int main() {
             case 1:
                 printf("Digite o valor a ser inserido no inicio: ");
                 scanf("%d", &valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_INSERIR, valor);
+                }
+                antes = histogramaAgora();
                 inserirInicio(&lista, valor);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
                 break;
                 
             case 2:
                 printf("Digite o valor a ser inserido: ");
                 scanf("%d", &valor);
+                tamanhoAntes = lista.tamanho;  // A posição pode ser recusada
                 printf("Digite a posicao (1 a %d): ", lista.tamanho + 1);
                 scanf("%d", &posicao);
+                antes = histogramaAgora();
                 inserirPosicao(&lista, valor, posicao);
+                if (lista.tamanho > tamanhoAntes) {
+                    latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
+                }
+                if (rastroAtivo && lista.tamanho > tamanhoAntes) {
+                    rastroRegistrar(&rastro, RASTRO_INSERIR, valor);
+                }
                 break;
                 
             case 3:
                 printf("Digite o valor a ser inserido no final: ");
                 scanf("%d", &valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_INSERIR, valor);
+                }
+                antes = histogramaAgora();
                 inserirFinal(&lista, valor);
+                latenciasRegistrar(&latencias, LATENCIA_INSERCAO, antes);
                 break;
                 
             case 4:
                 printf("Digite a posicao a ser removida (1 a %d): ", lista.tamanho);
                 scanf("%d", &posicao);
-                removerPosicao(&lista, posicao);
+                antes = histogramaAgora();
+                if (removerPosicao(&lista, posicao, &valor)) {
+                    latenciasRegistrar(&latencias, LATENCIA_REMOCAO, antes);
+                    if (rastroAtivo) {
+                        rastroRegistrar(&rastro, RASTRO_REMOVER, valor);
+                    }
+                }
                 break;
                 
             case 5:
                 printf("Digite o valor a ser buscado: ");
                 scanf("%d", &valor);
+                if (rastroAtivo) {
+                    rastroRegistrar(&rastro, RASTRO_BUSCAR, valor);
+                }
+                antes = histogramaAgora();
                 buscarValor(&lista, valor);
+                latenciasRegistrar(&latencias, LATENCIA_BUSCA, antes);
                 break;
                 
             case 6:
+                antes = histogramaAgora();
                 listarElementos(&lista);
+                latenciasRegistrar(&latencias, LATENCIA_PERCURSO, antes);
                 break;
                 
             case 7:
                 printf("Encerrando programa...\n");
                 break;
                 
+            case 8:
+                latenciasImprimir(&latencias);
+                break;
+                
             default:
                 printf("Opcao inválida! Tente novamente.\n");
         }
         
     } while (opcao != 7);
     
+    if (rastroAtivo) {
+        if (rastroFechar(&rastro)) {
+            printf("Rastro com %lld operações gravado em %s.\n", rastro.operacoes, argv[1]);
+        } else {
+            printf("Erro: Falha ao gravar o rastro %s!\n", argv[1]);
+        }
+    }
+    
+    if (latenciasRegistradas(&latencias)) {
+        latenciasImprimir(&latencias);
+    }
+    
     destruirLista(&lista);
     return 0;
-}
\ No newline at end of file
+}
+
+#endif
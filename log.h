@@ -0,0 +1,315 @@
+// Log de escrita antecipada (write-ahead log) para as árvores de chaves int.
+//
+// Cada inserção ou remoção é acrescentada a <base>.log antes de ser
+// considerada feita. As operações são confirmadas em grupo: o registro vai
+// para um buffer e só a cada tamanhoGrupo operações (ou em logConfirmar) o
+// buffer é gravado e o arquivo sincronizado com o disco, um fsync para o
+// grupo inteiro. Operações ainda no buffer se perdem numa queda.
+//
+// De tempos em tempos o programa grava um instantâneo com as chaves em ordem
+// (<base>.inst) e o log recomeça vazio. A recuperação carrega o instantâneo
+// em lote, sem passar pela inserção, e reaplica só o que está no log.
+//
+// Estruturas que guardam um dado associado a cada chave (arvore23.c) gravam
+// o dado junto: no registro de inserção, que então quer dizer "a chave passa
+// a ter este dado" (inserir ou trocar o dado), e no instantâneo, depois das
+// chaves. As outras registram a própria chave como dado e o ignoram.
+//
+// Reaplicar é idempotente, porque as árvores são conjuntos (inserir uma
+// chave existente ou remover uma ausente não muda nada, e uma inserção com
+// dado deixa o último dado gravado). Por isso, se o programa cair entre
+// gravar o instantâneo e esvaziar o log, reaplicar o log antigo sobre o
+// instantâneo novo dá o mesmo resultado.
+//
+// Cada registro tem 12 bytes com um byte de verificação; a leitura para no
+// primeiro registro incompleto ou inválido (gravação interrompida).
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define logSincronizarArquivo(arquivo) _commit(_fileno(arquivo))
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#define logSincronizarArquivo(arquivo) fsync(fileno(arquivo))
+#endif
+
+#define LOG_INSERIR 'I'
+#define LOG_REMOVER 'R'
+#define LOG_GRUPO_MAXIMO 4096            // Maior grupo de confirmação
+#define LOG_MAGIA_INSTANTANEO 0x54534E49u // "INST"
+#define LOG_MAGIA_INSTANTANEO_DADOS 0x44534E49u // "INSD": chaves seguidas dos dados
+
+// Registro de uma operação, como fica gravado no arquivo
+typedef struct {
+    int32_t chave;
+    int32_t dado;                   // Dado associado à chave (ou a própria chave)
+    uint8_t operacao;               // LOG_INSERIR ou LOG_REMOVER
+    uint8_t reservado[2];
+    uint8_t verificacao;            // Detecta registros incompletos
+} RegistroLog;
+
+// Log de operações de uma árvore
+typedef struct {
+    FILE *arquivo;                  // <base>.log, aberto para gravação
+    char nomeLog[260];
+    char nomeInstantaneo[260];
+    RegistroLog pendentes[LOG_GRUPO_MAXIMO];
+    int numPendentes;
+    int tamanhoGrupo;               // Operações por sincronização
+    long long intervaloInstantaneo; // Operações entre instantâneos (0 = nunca)
+    long long desdeInstantaneo;     // Operações no log atual
+
+    // Estatísticas
+    long long operacoes;            // Operações registradas
+    long long sincronizacoes;       // Chamadas a fsync
+} LogOperacoes;
+
+// Aplicar uma operação reaplicada do log à estrutura
+typedef void (*LogAplicar)(void *estrutura, char operacao, int chave, int dado);
+
+// Substituir a estrutura pelas n chaves ordenadas do instantâneo; dados é
+// NULL se o instantâneo foi gravado sem eles
+typedef void (*LogCarregar)(void *estrutura, const int *chaves, const int *dados, int n);
+
+// Byte de verificação de um registro
+static inline uint8_t logVerificacao(const RegistroLog *registro) {
+    uint32_t x = (uint32_t)registro->chave ^ ((uint32_t)registro->dado * 0x9E3779B1u);
+    return (uint8_t)(0xA5 ^ registro->operacao ^ x ^ (x >> 8) ^ (x >> 16) ^ (x >> 24));
+}
+
+// Abrir o log <base>.log (as operações são acrescentadas ao final)
+static inline bool logAbrir(LogOperacoes *log, const char *base, int tamanhoGrupo, long long intervaloInstantaneo) {
+    snprintf(log->nomeLog, sizeof(log->nomeLog), "%s.log", base);
+    snprintf(log->nomeInstantaneo, sizeof(log->nomeInstantaneo), "%s.inst", base);
+
+    log->arquivo = fopen(log->nomeLog, "ab");
+    if (log->arquivo == NULL) {
+        printf("Erro: Não foi possível abrir %s!\n", log->nomeLog);
+        return false;
+    }
+
+    if (tamanhoGrupo < 1) tamanhoGrupo = 1;
+    if (tamanhoGrupo > LOG_GRUPO_MAXIMO) tamanhoGrupo = LOG_GRUPO_MAXIMO;
+    log->tamanhoGrupo = tamanhoGrupo;
+    log->intervaloInstantaneo = intervaloInstantaneo;
+    log->numPendentes = 0;
+    log->desdeInstantaneo = 0;
+    log->operacoes = 0;
+    log->sincronizacoes = 0;
+    return true;
+}
+
+// Sincronizar o diretório do arquivo, para que um rename feito nele chegue ao
+// disco (no Windows não há como abrir o diretório; o rename fica por conta do
+// sistema de arquivos)
+static inline bool logSincronizarDiretorio(const char *caminho) {
+#ifdef _WIN32
+    (void)caminho;
+    return true;
+#else
+    char diretorio[260];
+    const char *barra = strrchr(caminho, '/');
+    if (barra == NULL) {
+        strcpy(diretorio, ".");
+    } else if (barra == caminho) {
+        strcpy(diretorio, "/");
+    } else {
+        snprintf(diretorio, sizeof(diretorio), "%.*s", (int)(barra - caminho), caminho);
+    }
+
+    int fd = open(diretorio, O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+#endif
+}
+
+// Gravar as operações pendentes e sincronizar o arquivo (fim do grupo). Se a
+// gravação ou a sincronização falhar, o grupo não está no disco: o programa
+// para em vez de seguir como se as operações estivessem confirmadas.
+static inline void logConfirmar(LogOperacoes *log) {
+    if (log->numPendentes == 0) return;
+
+    if (fwrite(log->pendentes, sizeof(RegistroLog), log->numPendentes, log->arquivo) != (size_t)log->numPendentes) {
+        printf("Erro: Falha ao gravar %s!\n", log->nomeLog);
+        exit(1);
+    }
+    if (fflush(log->arquivo) != 0 || logSincronizarArquivo(log->arquivo) != 0) {
+        printf("Erro: Falha ao sincronizar %s; as últimas %d operações podem não estar no disco!\n",
+               log->nomeLog, log->numPendentes);
+        exit(1);
+    }
+    log->sincronizacoes++;
+    log->numPendentes = 0;
+}
+
+// Registrar uma operação com o dado associado à chave; o grupo é confirmado
+// quando enche
+static inline void logRegistrarDado(LogOperacoes *log, char operacao, int chave, int dado) {
+    RegistroLog *registro = &log->pendentes[log->numPendentes++];
+    registro->chave = chave;
+    registro->dado = dado;
+    registro->operacao = (uint8_t)operacao;
+    registro->reservado[0] = registro->reservado[1] = 0;
+    registro->verificacao = logVerificacao(registro);
+
+    log->operacoes++;
+    log->desdeInstantaneo++;
+    if (log->numPendentes == log->tamanhoGrupo) {
+        logConfirmar(log);
+    }
+}
+
+// Registrar uma operação de uma estrutura sem dados (o dado é a chave)
+static inline void logRegistrar(LogOperacoes *log, char operacao, int chave) {
+    logRegistrarDado(log, operacao, chave, chave);
+}
+
+// Indica se já passou o intervalo para um novo instantâneo
+static inline bool logPrecisaInstantaneo(LogOperacoes *log) {
+    return log->intervaloInstantaneo > 0 && log->desdeInstantaneo >= log->intervaloInstantaneo;
+}
+
+// Gravar o instantâneo com as n chaves em ordem (e os dados delas, se dados
+// não for NULL) e recomeçar o log vazio.
+// O instantâneo é gravado num arquivo temporário e renomeado por cima do
+// anterior, então uma queda no meio deixa o instantâneo antigo intacto. O
+// diretório é sincronizado depois do rename e antes de esvaziar o log: sem
+// isso, uma queda poderia deixar no disco o log vazio com o instantâneo antigo.
+static inline bool logGravarInstantaneo(LogOperacoes *log, const int *chaves, const int *dados, int n) {
+    char temporario[272];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", log->nomeInstantaneo);
+
+    // As operações pendentes já estão nas chaves, mas o log antigo só é
+    // descartado depois que o instantâneo estiver no disco
+    logConfirmar(log);
+
+    FILE *arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) {
+        printf("Erro: Não foi possível criar %s!\n", temporario);
+        return false;
+    }
+    uint32_t cabecalho[2] = { dados != NULL ? LOG_MAGIA_INSTANTANEO_DADOS : LOG_MAGIA_INSTANTANEO, (uint32_t)n };
+    bool ok = fwrite(cabecalho, sizeof(cabecalho), 1, arquivo) == 1 &&
+              (n == 0 || fwrite(chaves, sizeof(int), n, arquivo) == (size_t)n) &&
+              (n == 0 || dados == NULL || fwrite(dados, sizeof(int), n, arquivo) == (size_t)n);
+    ok = fflush(arquivo) == 0 && ok;
+    ok = logSincronizarArquivo(arquivo) == 0 && ok;
+    fclose(arquivo);
+    if (!ok) {
+        printf("Erro: Falha ao gravar %s!\n", temporario);
+        remove(temporario);
+        return false;
+    }
+
+#ifdef _WIN32
+    remove(log->nomeInstantaneo);  // No Windows, rename não substitui
+#endif
+    if (rename(temporario, log->nomeInstantaneo) != 0) {
+        printf("Erro: Falha ao renomear %s!\n", temporario);
+        return false;
+    }
+    if (!logSincronizarDiretorio(log->nomeInstantaneo)) {
+        // O log antigo continua valendo com qualquer um dos instantâneos
+        printf("Erro: Falha ao sincronizar o diretório de %s; o log não foi esvaziado!\n", log->nomeInstantaneo);
+        return false;
+    }
+
+    // Recomeçar o log vazio
+    fclose(log->arquivo);
+    log->arquivo = fopen(log->nomeLog, "wb");
+    if (log->arquivo == NULL) {
+        printf("Erro: Não foi possível recriar %s!\n", log->nomeLog);
+        exit(1);
+    }
+    logSincronizarArquivo(log->arquivo);
+    log->desdeInstantaneo = 0;
+    return true;
+}
+
+// Recuperar a estrutura: carregar o instantâneo (se houver) e reaplicar o
+// log. Informa quantas chaves vieram do instantâneo e quantos registros do
+// log foram reaplicados. Deve ser chamada logo depois de logAbrir; em
+// seguida grave um instantâneo, que também descarta um final incompleto do
+// log (senão as próximas operações ficariam depois do registro inválido).
+static inline bool logRecuperar(LogOperacoes *log, void *estrutura, LogCarregar carregar, LogAplicar aplicar,
+                                int *numChaves, long long *numRegistros) {
+    *numChaves = 0;
+    *numRegistros = 0;
+
+    // Instantâneo
+    FILE *arquivo = fopen(log->nomeInstantaneo, "rb");
+    if (arquivo != NULL) {
+        uint32_t cabecalho[2];
+        if (fread(cabecalho, sizeof(cabecalho), 1, arquivo) != 1 ||
+            (cabecalho[0] != LOG_MAGIA_INSTANTANEO && cabecalho[0] != LOG_MAGIA_INSTANTANEO_DADOS)) {
+            printf("Erro: %s não é um instantâneo válido!\n", log->nomeInstantaneo);
+            fclose(arquivo);
+            return false;
+        }
+        int n = (int)cabecalho[1];
+        bool comDados = cabecalho[0] == LOG_MAGIA_INSTANTANEO_DADOS;
+        int *chaves = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+        int *dados = comDados ? (int*)malloc(sizeof(int) * (n > 0 ? n : 1)) : NULL;
+        if (chaves == NULL || (comDados && dados == NULL)) {
+            printf("Erro: Falha na alocação de memória!\n");
+            free(chaves);
+            free(dados);
+            fclose(arquivo);
+            return false;
+        }
+        if (n > 0 && (fread(chaves, sizeof(int), n, arquivo) != (size_t)n ||
+                      (comDados && fread(dados, sizeof(int), n, arquivo) != (size_t)n))) {
+            printf("Erro: Instantâneo %s incompleto!\n", log->nomeInstantaneo);
+            free(chaves);
+            free(dados);
+            fclose(arquivo);
+            return false;
+        }
+        fclose(arquivo);
+        carregar(estrutura, chaves, dados, n);
+        free(chaves);
+        free(dados);
+        *numChaves = n;
+    }
+
+    // Operações do log, em blocos
+    arquivo = fopen(log->nomeLog, "rb");
+    if (arquivo != NULL) {
+        RegistroLog bloco[1024];
+        size_t lidos;
+        bool valido = true;
+        while (valido && (lidos = fread(bloco, sizeof(RegistroLog), 1024, arquivo)) > 0) {
+            for (size_t i = 0; i < lidos; i++) {
+                if (bloco[i].verificacao != logVerificacao(&bloco[i]) ||
+                    (bloco[i].operacao != LOG_INSERIR && bloco[i].operacao != LOG_REMOVER)) {
+                    valido = false;
+                    break;
+                }
+                aplicar(estrutura, (char)bloco[i].operacao, bloco[i].chave, bloco[i].dado);
+                (*numRegistros)++;
+            }
+        }
+        fclose(arquivo);
+    }
+    log->desdeInstantaneo = *numRegistros;
+    return true;
+}
+
+// Confirmar o que estiver pendente e fechar o log
+static inline void logFechar(LogOperacoes *log) {
+    logConfirmar(log);
+    fclose(log->arquivo);
+}
+
+#endif
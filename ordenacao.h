@@ -0,0 +1,270 @@
+// Ordenação paralela com remoção de repetidos, para montar as árvores em lote
+// a partir de chaves fora de ordem (carregarEmParalelo em arvorebst.c,
+// arvoreRN.c e arvore23.c).
+//
+// É uma ordenação por baldes: a faixa [mínimo, máximo] das chaves é dividida
+// em até ORDENACAO_BALDES baldes de mesma largura (potência de 2). Cada thread
+// conta e espalha um pedaço do vetor, com posições próprias em cada balde, e
+// depois as threads pegam baldes inteiros, ordenam com radix sort (só os bits
+// abaixo da largura do balde) e tiram os repetidos, que sempre caem no mesmo
+// balde. No fim cada balde é copiado para a sua posição final. Tudo é O(n)
+// por passada, sem comparações.
+//
+// Com chaves concentradas numa parte pequena da faixa (muito desiguais) os
+// baldes ficam desbalanceados e a última fase perde paralelismo.
+
+#ifndef ORDENACAO_H
+#define ORDENACAO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define ORDENACAO_BALDES_BITS 12
+#define ORDENACAO_BALDES (1 << ORDENACAO_BALDES_BITS)
+#define ORDENACAO_MAX_THREADS 256
+
+// Estado compartilhado de uma ordenação
+typedef struct {
+    int *valores;
+    uint32_t *auxiliar;         // Chaves deslocadas (chave - mínimo), espalhadas nos baldes
+    uint32_t *reserva;          // Segundo vetor do radix sort
+    int n;
+    int threads;
+    int minimo;
+    int deslocamento;           // Balde de uma chave: (chave - mínimo) >> deslocamento
+    int (*contagens)[ORDENACAO_BALDES];  // Chaves de cada balde em cada pedaço
+    int inicioBalde[ORDENACAO_BALDES + 1];
+    int unicos[ORDENACAO_BALDES];        // Chaves distintas de cada balde
+    int destino[ORDENACAO_BALDES];       // Posição final de cada balde
+    atomic_int proximoBalde;             // Próximo balde a ordenar
+    int minimos[ORDENACAO_MAX_THREADS];
+    int maximos[ORDENACAO_MAX_THREADS];
+} Ordenacao;
+
+// Argumento de cada thread
+typedef struct {
+    Ordenacao *ordenacao;
+    int indice;
+} ParteOrdenacao;
+
+// Pedaço [*inicio, *fim) do vetor que cabe à thread
+static inline void ordenacaoPedaco(const Ordenacao *ordenacao, int indice, int *inicio, int *fim) {
+    *inicio = (int)((long long)ordenacao->n * indice / ordenacao->threads);
+    *fim = (int)((long long)ordenacao->n * (indice + 1) / ordenacao->threads);
+}
+
+// Executar funcao em ordenacao->threads threads (a última é a própria chamadora)
+static inline void ordenacaoExecutar(Ordenacao *ordenacao, void* (*funcao)(void*)) {
+    pthread_t threads[ORDENACAO_MAX_THREADS];
+    ParteOrdenacao partes[ORDENACAO_MAX_THREADS];
+    bool criada[ORDENACAO_MAX_THREADS];
+
+    for (int t = 0; t < ordenacao->threads; t++) {
+        partes[t].ordenacao = ordenacao;
+        partes[t].indice = t;
+        criada[t] = t < ordenacao->threads - 1 &&
+                    pthread_create(&threads[t], NULL, funcao, &partes[t]) == 0;
+    }
+    // As que não puderam ser criadas rodam aqui mesmo
+    for (int t = 0; t < ordenacao->threads; t++) {
+        if (!criada[t]) funcao(&partes[t]);
+    }
+    for (int t = 0; t < ordenacao->threads - 1; t++) {
+        if (criada[t]) pthread_join(threads[t], NULL);
+    }
+}
+
+// Fase 1: mínimo e máximo de cada pedaço
+static inline void* ordenacaoFaixa(void *argumento) {
+    ParteOrdenacao *parte = (ParteOrdenacao*)argumento;
+    Ordenacao *ordenacao = parte->ordenacao;
+    int inicio, fim;
+    ordenacaoPedaco(ordenacao, parte->indice, &inicio, &fim);
+
+    int minimo = ordenacao->valores[inicio], maximo = minimo;
+    for (int i = inicio + 1; i < fim; i++) {
+        int valor = ordenacao->valores[i];
+        if (valor < minimo) minimo = valor;
+        if (valor > maximo) maximo = valor;
+    }
+    ordenacao->minimos[parte->indice] = minimo;
+    ordenacao->maximos[parte->indice] = maximo;
+    return NULL;
+}
+
+// Balde de um valor
+static inline int ordenacaoBalde(const Ordenacao *ordenacao, int valor) {
+    return (int)(((uint32_t)valor - (uint32_t)ordenacao->minimo) >> ordenacao->deslocamento);
+}
+
+// Fase 2: quantas chaves do pedaço caem em cada balde
+static inline void* ordenacaoContar(void *argumento) {
+    ParteOrdenacao *parte = (ParteOrdenacao*)argumento;
+    Ordenacao *ordenacao = parte->ordenacao;
+    int *contagem = ordenacao->contagens[parte->indice];
+    int inicio, fim;
+    ordenacaoPedaco(ordenacao, parte->indice, &inicio, &fim);
+
+    memset(contagem, 0, sizeof(int) * ORDENACAO_BALDES);
+    for (int i = inicio; i < fim; i++) {
+        contagem[ordenacaoBalde(ordenacao, ordenacao->valores[i])]++;
+    }
+    return NULL;
+}
+
+// Fase 3: espalhar o pedaço nos baldes (as contagens viraram posições de escrita)
+static inline void* ordenacaoEspalhar(void *argumento) {
+    ParteOrdenacao *parte = (ParteOrdenacao*)argumento;
+    Ordenacao *ordenacao = parte->ordenacao;
+    int *posicao = ordenacao->contagens[parte->indice];
+    int inicio, fim;
+    ordenacaoPedaco(ordenacao, parte->indice, &inicio, &fim);
+
+    for (int i = inicio; i < fim; i++) {
+        int valor = ordenacao->valores[i];
+        ordenacao->auxiliar[posicao[ordenacaoBalde(ordenacao, valor)]++] =
+            (uint32_t)valor - (uint32_t)ordenacao->minimo;
+    }
+    return NULL;
+}
+
+// Radix sort de n chaves pelos bits abaixo de bits, 8 por passada. O resultado
+// fica em chaves (a última passada, se ímpar, é copiada de volta).
+static inline void ordenacaoRadix(uint32_t *chaves, uint32_t *reserva, int n, int bits) {
+    uint32_t *origem = chaves, *saida = reserva;
+    for (int desloc = 0; desloc < bits; desloc += 8) {
+        int contagem[257] = { 0 };
+        for (int i = 0; i < n; i++) {
+            contagem[((origem[i] >> desloc) & 0xFF) + 1]++;
+        }
+        for (int d = 0; d < 256; d++) {
+            contagem[d + 1] += contagem[d];
+        }
+        for (int i = 0; i < n; i++) {
+            saida[contagem[(origem[i] >> desloc) & 0xFF]++] = origem[i];
+        }
+        uint32_t *troca = origem;
+        origem = saida;
+        saida = troca;
+    }
+    if (origem != chaves) {
+        memcpy(chaves, origem, sizeof(uint32_t) * n);
+    }
+}
+
+// Fase 4: ordenar os baldes, pegos um a um, e tirar os repetidos
+static inline void* ordenacaoOrdenarBaldes(void *argumento) {
+    Ordenacao *ordenacao = ((ParteOrdenacao*)argumento)->ordenacao;
+    int balde;
+    while ((balde = atomic_fetch_add_explicit(&ordenacao->proximoBalde, 1, memory_order_relaxed)) < ORDENACAO_BALDES) {
+        int inicio = ordenacao->inicioBalde[balde];
+        int n = ordenacao->inicioBalde[balde + 1] - inicio;
+        if (n == 0) {
+            ordenacao->unicos[balde] = 0;
+            continue;
+        }
+
+        uint32_t *chaves = ordenacao->auxiliar + inicio;
+        ordenacaoRadix(chaves, ordenacao->reserva + inicio, n, ordenacao->deslocamento);
+        int unicos = 1;
+        for (int i = 1; i < n; i++) {
+            if (chaves[i] != chaves[unicos - 1]) chaves[unicos++] = chaves[i];
+        }
+        ordenacao->unicos[balde] = unicos;
+    }
+    return NULL;
+}
+
+// Fase 5: copiar os baldes da thread para a posição final, desfazendo o deslocamento
+static inline void* ordenacaoCopiar(void *argumento) {
+    ParteOrdenacao *parte = (ParteOrdenacao*)argumento;
+    Ordenacao *ordenacao = parte->ordenacao;
+    for (int balde = parte->indice; balde < ORDENACAO_BALDES; balde += ordenacao->threads) {
+        const uint32_t *chaves = ordenacao->auxiliar + ordenacao->inicioBalde[balde];
+        int *saida = ordenacao->valores + ordenacao->destino[balde];
+        for (int i = 0; i < ordenacao->unicos[balde]; i++) {
+            saida[i] = (int)(chaves[i] + (uint32_t)ordenacao->minimo);
+        }
+    }
+    return NULL;
+}
+
+// Ordenar os n valores em ordem crescente, sem repetidos, com até threads
+// threads. Retorna a quantidade de valores distintos (no começo do vetor),
+// ou -1 se faltar memória.
+static inline int ordenarSemRepetidos(int *valores, int n, int threads) {
+    if (n <= 0) return 0;
+    if (threads < 1) threads = 1;
+    if (threads > ORDENACAO_MAX_THREADS) threads = ORDENACAO_MAX_THREADS;
+    if (threads > n) threads = n;
+
+    Ordenacao *ordenacao = (Ordenacao*)malloc(sizeof(Ordenacao));
+    uint32_t *auxiliar = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    uint32_t *reserva = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    int (*contagens)[ORDENACAO_BALDES] = (int (*)[ORDENACAO_BALDES])malloc(sizeof(int) * ORDENACAO_BALDES * threads);
+    if (ordenacao == NULL || auxiliar == NULL || reserva == NULL || contagens == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(ordenacao);
+        free(auxiliar);
+        free(reserva);
+        free(contagens);
+        return -1;
+    }
+    ordenacao->valores = valores;
+    ordenacao->auxiliar = auxiliar;
+    ordenacao->reserva = reserva;
+    ordenacao->n = n;
+    ordenacao->threads = threads;
+    ordenacao->contagens = contagens;
+    atomic_init(&ordenacao->proximoBalde, 0);
+
+    // Largura dos baldes: a menor potência de 2 que cobre a faixa com ORDENACAO_BALDES
+    ordenacaoExecutar(ordenacao, ordenacaoFaixa);
+    int minimo = ordenacao->minimos[0], maximo = ordenacao->maximos[0];
+    for (int t = 1; t < threads; t++) {
+        if (ordenacao->minimos[t] < minimo) minimo = ordenacao->minimos[t];
+        if (ordenacao->maximos[t] > maximo) maximo = ordenacao->maximos[t];
+    }
+    uint32_t faixa = (uint32_t)maximo - (uint32_t)minimo;
+    ordenacao->minimo = minimo;
+    ordenacao->deslocamento = 0;
+    while ((faixa >> ordenacao->deslocamento) >= ORDENACAO_BALDES) {
+        ordenacao->deslocamento++;
+    }
+
+    // Posição de escrita de cada pedaço em cada balde: baldes em ordem e,
+    // dentro do balde, pedaços em ordem
+    ordenacaoExecutar(ordenacao, ordenacaoContar);
+    int posicao = 0;
+    for (int balde = 0; balde < ORDENACAO_BALDES; balde++) {
+        ordenacao->inicioBalde[balde] = posicao;
+        for (int t = 0; t < threads; t++) {
+            int quantidade = contagens[t][balde];
+            contagens[t][balde] = posicao;
+            posicao += quantidade;
+        }
+    }
+    ordenacao->inicioBalde[ORDENACAO_BALDES] = posicao;
+    ordenacaoExecutar(ordenacao, ordenacaoEspalhar);
+
+    ordenacaoExecutar(ordenacao, ordenacaoOrdenarBaldes);
+    int distintos = 0;
+    for (int balde = 0; balde < ORDENACAO_BALDES; balde++) {
+        ordenacao->destino[balde] = distintos;
+        distintos += ordenacao->unicos[balde];
+    }
+    ordenacaoExecutar(ordenacao, ordenacaoCopiar);
+
+    free(contagens);
+    free(reserva);
+    free(auxiliar);
+    free(ordenacao);
+    return distintos;
+}
+
+#endif
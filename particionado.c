@@ -0,0 +1,598 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "conjunto.h"
+
+// Conjunto ordenado particionado entre núcleos. As chaves são divididas por
+// hash entre N partições; cada partição tem uma thread trabalhadora que é a
+// única dona de uma árvore rubro-negra (conjuntoRN), então a árvore não
+// precisa de nenhuma trava.
+//
+// Os clientes mandam as operações em lotes de até TAMANHO_LOTE. Cada par
+// (cliente, partição) tem uma fila própria, um anel de LOTES_POR_FILA lotes
+// com um produtor e um consumidor: o cliente preenche o lote e publica com
+// um contador atômico, o trabalhador processa e marca o lote como concluído.
+// Não há travas nem chamadas ao sistema no caminho, só esperas com
+// sched_yield quando a fila está vazia (trabalhador) ou cheia (cliente).
+//
+// Uma consulta de intervalo vai para todas as partições (cada uma devolve as
+// suas chaves em ordem) e o cliente intercala os resultados.
+//
+// Compilar com:
+//   gcc -O2 -DSEM_MAIN particionado.c arvoreRN.c -o particionado -pthread -lm
+//
+// Uso (mede de 1 até o máximo de partições, dobrando):
+//   particionado [partições] [operações] [uniforme|zipf] [clientes]
+//
+// Com chaves Zipf as chaves populares concentram a carga em poucas
+// partições; o desequilíbrio (operações da partição mais carregada sobre a
+// média) mostra quanto isso limita a aceleração.
+
+#define TAMANHO_LOTE 256            // Operações por lote
+#define LOTES_POR_FILA 8            // Lotes em trânsito por fila
+#define CONSULTAS_INTERVALO 1000    // Consultas de intervalo medidas
+#define TETA_ZIPF 0.99              // Expoente da distribuição Zipf (o mesmo do YCSB)
+
+#define LINHA_CACHE 64
+
+typedef enum { PEDIDO_INSERIR, PEDIDO_BUSCAR, PEDIDO_REMOVER, PEDIDO_INTERVALO } TipoPedido;
+
+// Uma operação de um lote (fim só na consulta de intervalo)
+typedef struct {
+    int chave;
+    int fim;
+    TipoPedido tipo;
+} Pedido;
+
+// Chaves em ordem crescente (resultado de um intervalo)
+typedef struct {
+    int *chaves;
+    long long tamanho;
+    long long capacidade;
+} VetorChaves;
+
+// Lote de operações. O cliente escreve os pedidos antes de publicar; o
+// trabalhador escreve os resultados antes de marcar concluido.
+typedef struct {
+    int n;
+    Pedido pedidos[TAMANHO_LOTE];
+    bool resultados[TAMANHO_LOTE];
+    VetorChaves intervalo;          // Chaves da consulta de intervalo, se houver
+    bool temIntervalo;
+    atomic_int concluido;
+} Lote;
+
+// Fila de um cliente para uma partição: o lote i fica em lotes[i % LOTES_POR_FILA]
+typedef struct {
+    Lote lotes[LOTES_POR_FILA];
+    _Alignas(LINHA_CACHE) atomic_uint publicados;   // Escrito pelo cliente
+    unsigned colhidos;                              // Resultados recolhidos (só o cliente)
+    _Alignas(LINHA_CACHE) unsigned consumidos;      // Lotes processados (só o trabalhador)
+} Fila;
+
+typedef struct Servico Servico;
+
+// Uma partição: a árvore, a thread dona dela e as filas de todos os clientes
+typedef struct {
+    _Alignas(LINHA_CACHE) Servico *servico;
+    Fila *filas;                    // Uma por cliente
+    Conjunto conjunto;              // Só a thread trabalhadora usa
+    pthread_t thread;
+    atomic_llong operacoes;         // Operações processadas
+} Particao;
+
+struct Servico {
+    int numParticoes;
+    int numClientes;
+    Particao *particoes;
+    atomic_int parar;
+};
+
+// Resultado parcial de uma partição numa consulta de intervalo
+typedef struct {
+    VetorChaves chaves;
+    long long posicao;              // Próxima chave a intercalar
+} ParcialIntervalo;
+
+// Um cliente: usado por uma thread só
+typedef struct {
+    Servico *servico;
+    int indice;
+    long long sucessos;             // Operações que acharam, inseriram ou removeram
+    ParcialIntervalo *parciais;     // Um por partição
+} Cliente;
+
+// ===================== FUNÇÕES AUXILIARES =====================
+
+// Gerador pseudoaleatório simples (xorshift) para medições repetíveis
+static unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Embaralhar i em [0, 2^31) sem repetir (bijeção)
+static int embaralhar(unsigned int i) {
+    i *= 2654435761u;
+    i ^= (i & 0x7FFFFFFFu) >> 15;
+    i *= 2246822519u;
+    return (int)(i & 0x7FFFFFFFu);
+}
+
+// Instante atual em segundos (relógio monotônico)
+static double agora() {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return instante.tv_sec + instante.tv_nsec / 1e9;
+}
+
+// Partição de uma chave: hash multiplicativo levado para [0, numParticoes)
+static int particaoDe(Servico *servico, int chave) {
+    uint32_t hash = (uint32_t)chave * 2654435761u;
+    hash ^= hash >> 16;
+    return (int)(((uint64_t)hash * (uint64_t)servico->numParticoes) >> 32);
+}
+
+// Acrescentar uma chave ao vetor (visitante de conjuntoPercorrerIntervalo)
+static void acrescentarChave(int chave, void *contexto) {
+    VetorChaves *vetor = (VetorChaves*)contexto;
+    if (vetor->tamanho == vetor->capacidade) {
+        long long capacidade = vetor->capacidade > 0 ? vetor->capacidade * 2 : 256;
+        int *chaves = (int*)realloc(vetor->chaves, sizeof(int) * capacidade);
+        if (chaves == NULL) {
+            printf("Erro: Falha na alocação de memória!\n");
+            exit(1);
+        }
+        vetor->chaves = chaves;
+        vetor->capacidade = capacidade;
+    }
+    vetor->chaves[vetor->tamanho++] = chave;
+}
+
+// ===================== TRABALHADORES =====================
+
+// Executar os pedidos de um lote na árvore da partição
+static void processarLote(Particao *particao, Lote *lote) {
+    for (int i = 0; i < lote->n; i++) {
+        Pedido *pedido = &lote->pedidos[i];
+        switch (pedido->tipo) {
+            case PEDIDO_INSERIR:
+                lote->resultados[i] = conjuntoInserir(&particao->conjunto, pedido->chave);
+                break;
+            case PEDIDO_BUSCAR:
+                lote->resultados[i] = conjuntoContem(&particao->conjunto, pedido->chave);
+                break;
+            case PEDIDO_REMOVER:
+                lote->resultados[i] = conjuntoRemover(&particao->conjunto, pedido->chave);
+                break;
+            case PEDIDO_INTERVALO:
+                lote->intervalo.tamanho = 0;
+                conjuntoPercorrerIntervalo(&particao->conjunto, pedido->chave, pedido->fim,
+                                           acrescentarChave, &lote->intervalo);
+                lote->temIntervalo = true;
+                lote->resultados[i] = true;
+                break;
+        }
+    }
+    atomic_fetch_add_explicit(&particao->operacoes, lote->n, memory_order_relaxed);
+}
+
+// Thread trabalhadora: a árvore é criada, usada e destruída só aqui
+static void* trabalhador(void *argumento) {
+    Particao *particao = (Particao*)argumento;
+    Servico *servico = particao->servico;
+    particao->conjunto = conjuntoCriar(&conjuntoRN);
+    if (particao->conjunto.estado == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        exit(1);
+    }
+
+    // Parar só depois de esvaziar as filas
+    bool trabalhou = true;
+    while (trabalhou || !atomic_load_explicit(&servico->parar, memory_order_acquire)) {
+        trabalhou = false;
+        for (int c = 0; c < servico->numClientes; c++) {
+            Fila *fila = &particao->filas[c];
+            unsigned publicados = atomic_load_explicit(&fila->publicados, memory_order_acquire);
+            while (fila->consumidos != publicados) {
+                Lote *lote = &fila->lotes[fila->consumidos % LOTES_POR_FILA];
+                processarLote(particao, lote);
+                atomic_store_explicit(&lote->concluido, 1, memory_order_release);
+                fila->consumidos++;
+                trabalhou = true;
+            }
+        }
+        if (!trabalhou) sched_yield();
+    }
+
+    conjuntoDestruir(&particao->conjunto);
+    return NULL;
+}
+
+// Iniciar o serviço com as partições e as filas dos clientes
+static bool iniciarServico(Servico *servico, int numParticoes, int numClientes) {
+    servico->numParticoes = numParticoes;
+    servico->numClientes = numClientes;
+    atomic_init(&servico->parar, 0);
+    servico->particoes = (Particao*)aligned_alloc(LINHA_CACHE, sizeof(Particao) * numParticoes);
+    if (servico->particoes == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        return false;
+    }
+
+    for (int p = 0; p < numParticoes; p++) {
+        Particao *particao = &servico->particoes[p];
+        particao->servico = servico;
+        atomic_init(&particao->operacoes, 0);
+        particao->filas = (Fila*)aligned_alloc(LINHA_CACHE, sizeof(Fila) * numClientes);
+        if (particao->filas == NULL) {
+            printf("Erro: Falha na alocação de memória!\n");
+            exit(1);
+        }
+        for (int c = 0; c < numClientes; c++) {
+            Fila *fila = &particao->filas[c];
+            atomic_init(&fila->publicados, 0);
+            fila->colhidos = 0;
+            fila->consumidos = 0;
+            for (int i = 0; i < LOTES_POR_FILA; i++) {
+                Lote *lote = &fila->lotes[i];
+                lote->n = 0;
+                lote->intervalo.chaves = NULL;
+                lote->intervalo.tamanho = lote->intervalo.capacidade = 0;
+                lote->temIntervalo = false;
+                atomic_init(&lote->concluido, 0);
+            }
+        }
+        pthread_create(&particao->thread, NULL, trabalhador, particao);
+    }
+    return true;
+}
+
+// Encerrar o serviço (os clientes já devem ter descarregado os seus lotes)
+static void encerrarServico(Servico *servico) {
+    atomic_store_explicit(&servico->parar, 1, memory_order_release);
+    for (int p = 0; p < servico->numParticoes; p++) {
+        Particao *particao = &servico->particoes[p];
+        pthread_join(particao->thread, NULL);
+        for (int c = 0; c < servico->numClientes; c++) {
+            for (int i = 0; i < LOTES_POR_FILA; i++) {
+                free(particao->filas[c].lotes[i].intervalo.chaves);
+            }
+        }
+        free(particao->filas);
+    }
+    free(servico->particoes);
+}
+
+// ===================== CLIENTES =====================
+
+static void iniciarCliente(Cliente *cliente, Servico *servico, int indice) {
+    cliente->servico = servico;
+    cliente->indice = indice;
+    cliente->sucessos = 0;
+    cliente->parciais = (ParcialIntervalo*)calloc(servico->numParticoes, sizeof(ParcialIntervalo));
+    if (cliente->parciais == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        exit(1);
+    }
+}
+
+static void liberarCliente(Cliente *cliente) {
+    for (int p = 0; p < cliente->servico->numParticoes; p++) {
+        free(cliente->parciais[p].chaves.chaves);
+    }
+    free(cliente->parciais);
+}
+
+// Esperar o lote mais antigo da fila e recolher os resultados. O vetor de um
+// intervalo é trocado com o do cliente, sem cópia.
+static void colherLote(Cliente *cliente, int particao, Fila *fila) {
+    Lote *lote = &fila->lotes[fila->colhidos % LOTES_POR_FILA];
+    while (!atomic_load_explicit(&lote->concluido, memory_order_acquire)) {
+        sched_yield();
+    }
+
+    for (int i = 0; i < lote->n; i++) {
+        if (lote->pedidos[i].tipo != PEDIDO_INTERVALO) cliente->sucessos += lote->resultados[i];
+    }
+    if (lote->temIntervalo) {
+        VetorChaves troca = cliente->parciais[particao].chaves;
+        cliente->parciais[particao].chaves = lote->intervalo;
+        lote->intervalo = troca;
+        lote->temIntervalo = false;
+    }
+
+    lote->n = 0;
+    atomic_store_explicit(&lote->concluido, 0, memory_order_relaxed);
+    fila->colhidos++;
+}
+
+// Lote sendo preenchido na fila (recolhe o mais antigo se o anel estiver cheio)
+static Lote* loteAtual(Cliente *cliente, int particao, Fila *fila) {
+    unsigned publicados = atomic_load_explicit(&fila->publicados, memory_order_relaxed);
+    if (publicados - fila->colhidos == LOTES_POR_FILA) {
+        colherLote(cliente, particao, fila);
+    }
+    return &fila->lotes[publicados % LOTES_POR_FILA];
+}
+
+// Entregar o lote atual ao trabalhador
+static void publicarLote(Fila *fila) {
+    unsigned publicados = atomic_load_explicit(&fila->publicados, memory_order_relaxed);
+    atomic_store_explicit(&fila->publicados, publicados + 1, memory_order_release);
+}
+
+// Publicar o lote atual se ele tiver pedidos. Com o anel cheio o lote da
+// posição seguinte ainda está em trânsito, e não há nada pendente.
+static void publicarPendente(Fila *fila) {
+    unsigned publicados = atomic_load_explicit(&fila->publicados, memory_order_relaxed);
+    if (publicados - fila->colhidos < LOTES_POR_FILA && fila->lotes[publicados % LOTES_POR_FILA].n > 0) {
+        publicarLote(fila);
+    }
+}
+
+// Acrescentar um pedido ao lote da partição; o lote é publicado quando enche
+static void enviarPedido(Cliente *cliente, int particao, Pedido pedido) {
+    Fila *fila = &cliente->servico->particoes[particao].filas[cliente->indice];
+    Lote *lote = loteAtual(cliente, particao, fila);
+    lote->pedidos[lote->n++] = pedido;
+    if (lote->n == TAMANHO_LOTE) {
+        publicarLote(fila);
+    }
+}
+
+// Enviar uma inserção, busca ou remoção (o resultado entra em cliente->sucessos
+// quando o lote for recolhido)
+static void clienteEnviar(Cliente *cliente, TipoPedido tipo, int chave) {
+    Pedido pedido = { chave, chave, tipo };
+    enviarPedido(cliente, particaoDe(cliente->servico, chave), pedido);
+}
+
+// Publicar os lotes incompletos e esperar todos os resultados
+static void clienteDescarregar(Cliente *cliente) {
+    Servico *servico = cliente->servico;
+    for (int p = 0; p < servico->numParticoes; p++) {
+        publicarPendente(&servico->particoes[p].filas[cliente->indice]);
+    }
+    for (int p = 0; p < servico->numParticoes; p++) {
+        Fila *fila = &servico->particoes[p].filas[cliente->indice];
+        while (fila->colhidos != atomic_load_explicit(&fila->publicados, memory_order_relaxed)) {
+            colherLote(cliente, p, fila);
+        }
+    }
+}
+
+// Visitar em ordem as chaves de [inicio, fim] de todas as partições. Retorna
+// a quantidade de chaves. As operações já enviadas por este cliente são
+// concluídas antes.
+static long long consultarIntervalo(Cliente *cliente, int inicio, int fim, ConjuntoVisitar visitar, void *contexto) {
+    Servico *servico = cliente->servico;
+    Pedido pedido = { inicio, fim, PEDIDO_INTERVALO };
+    for (int p = 0; p < servico->numParticoes; p++) {
+        cliente->parciais[p].chaves.tamanho = 0;
+        cliente->parciais[p].posicao = 0;
+        enviarPedido(cliente, p, pedido);
+    }
+    // Publica o lote de cada intervalo (um por lote) e espera as respostas
+    clienteDescarregar(cliente);
+
+    // Intercalar: as partições são poucas, então basta procurar a menor das
+    // próximas chaves a cada passo
+    long long total = 0;
+    while (true) {
+        int menor = -1;
+        for (int p = 0; p < servico->numParticoes; p++) {
+            ParcialIntervalo *parcial = &cliente->parciais[p];
+            if (parcial->posicao < parcial->chaves.tamanho &&
+                (menor < 0 || parcial->chaves.chaves[parcial->posicao] <
+                              cliente->parciais[menor].chaves.chaves[cliente->parciais[menor].posicao])) {
+                menor = p;
+            }
+        }
+        if (menor < 0) break;
+        ParcialIntervalo *parcial = &cliente->parciais[menor];
+        visitar(parcial->chaves.chaves[parcial->posicao++], contexto);
+        total++;
+    }
+    return total;
+}
+
+// ===================== MEDIÇÃO =====================
+
+// Gerador Zipf de Gray et al. (o do YCSB): O(n) para preparar, O(1) por amostra
+typedef struct {
+    long long n;
+    double zetaN, alfa, eta, limite1;
+} GeradorZipf;
+
+static void iniciarZipf(GeradorZipf *zipf, long long n) {
+    double zeta2 = 1.0 + pow(0.5, TETA_ZIPF);
+    zipf->zetaN = 0;
+    for (long long i = 1; i <= n; i++) {
+        zipf->zetaN += 1.0 / pow((double)i, TETA_ZIPF);
+    }
+    zipf->n = n;
+    zipf->alfa = 1.0 / (1.0 - TETA_ZIPF);
+    zipf->eta = (1.0 - pow(2.0 / n, 1.0 - TETA_ZIPF)) / (1.0 - zeta2 / zipf->zetaN);
+    zipf->limite1 = zeta2;
+}
+
+// Posição em [0, n): a 0 é a mais frequente
+static long long amostrarZipf(const GeradorZipf *zipf, unsigned int *estado) {
+    double u = (proximoAleatorio(estado) + 0.5) / 4294967296.0;
+    double uz = u * zipf->zetaN;
+    if (uz < 1.0) return 0;
+    if (uz < zipf->limite1) return 1;
+    long long posicao = (long long)(zipf->n * pow(zipf->eta * u - zipf->eta + 1.0, zipf->alfa));
+    return posicao < zipf->n ? posicao : zipf->n - 1;
+}
+
+// Parâmetros e sincronização de uma medição
+typedef struct {
+    Servico *servico;
+    long long chaves;               // Espaço de chaves: embaralhar(0 .. chaves - 1)
+    long long operacoes;            // Operações medidas de cada cliente
+    const GeradorZipf *zipf;        // NULL para chaves uniformes
+    atomic_int prontos;             // Clientes que terminaram a carga inicial
+    atomic_int largada;             // Liberado pela thread principal
+} Medicao;
+
+typedef struct {
+    Medicao *medicao;
+    Cliente cliente;
+    pthread_t thread;
+} ThreadCliente;
+
+// Cliente da medição: carrega metade das suas chaves, espera a largada e faz
+// 50% buscas, 25% inserções e 25% remoções
+static void* executarCliente(void *argumento) {
+    ThreadCliente *dados = (ThreadCliente*)argumento;
+    Medicao *medicao = dados->medicao;
+    Cliente *cliente = &dados->cliente;
+    int numClientes = medicao->servico->numClientes;
+
+    for (long long j = cliente->indice; j < medicao->chaves; j += 2LL * numClientes) {
+        clienteEnviar(cliente, PEDIDO_INSERIR, embaralhar((unsigned int)j));
+    }
+    clienteDescarregar(cliente);
+    cliente->sucessos = 0;
+
+    atomic_fetch_add(&medicao->prontos, 1);
+    while (!atomic_load(&medicao->largada)) sched_yield();
+
+    unsigned int estado = 2463534242u + 97u * (unsigned int)cliente->indice;
+    for (long long i = 0; i < medicao->operacoes; i++) {
+        long long j = medicao->zipf != NULL ? amostrarZipf(medicao->zipf, &estado)
+                                            : proximoAleatorio(&estado) % medicao->chaves;
+        int chave = embaralhar((unsigned int)j);
+        unsigned int sorteio = proximoAleatorio(&estado) % 4;
+        TipoPedido tipo = sorteio < 2 ? PEDIDO_BUSCAR : sorteio == 2 ? PEDIDO_INSERIR : PEDIDO_REMOVER;
+        clienteEnviar(cliente, tipo, chave);
+    }
+    clienteDescarregar(cliente);
+    return NULL;
+}
+
+// Visitante das consultas medidas: só conta
+static void contarChave(int chave, void *contexto) {
+    (void)chave;
+    (*(long long*)contexto)++;
+}
+
+// Medir uma configuração; retorna as operações por segundo
+static double medir(int numParticoes, int numClientes, long long operacoes, const GeradorZipf *zipf) {
+    Servico servico;
+    if (!iniciarServico(&servico, numParticoes, numClientes)) return 0;
+
+    Medicao medicao;
+    medicao.servico = &servico;
+    medicao.chaves = operacoes;
+    medicao.operacoes = operacoes / numClientes;
+    medicao.zipf = zipf;
+    atomic_init(&medicao.prontos, 0);
+    atomic_init(&medicao.largada, 0);
+
+    ThreadCliente *clientes = (ThreadCliente*)malloc(sizeof(ThreadCliente) * numClientes);
+    long long *antes = (long long*)malloc(sizeof(long long) * numParticoes);
+    if (clientes == NULL || antes == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        exit(1);
+    }
+    for (int c = 0; c < numClientes; c++) {
+        clientes[c].medicao = &medicao;
+        iniciarCliente(&clientes[c].cliente, &servico, c);
+        pthread_create(&clientes[c].thread, NULL, executarCliente, &clientes[c]);
+    }
+
+    // Carga inicial fora do tempo medido
+    while (atomic_load(&medicao.prontos) < numClientes) sched_yield();
+    for (int p = 0; p < numParticoes; p++) {
+        antes[p] = atomic_load(&servico.particoes[p].operacoes);
+    }
+    double inicio = agora();
+    atomic_store(&medicao.largada, 1);
+    long long sucessos = 0;
+    for (int c = 0; c < numClientes; c++) {
+        pthread_join(clientes[c].thread, NULL);
+        sucessos += clientes[c].cliente.sucessos;
+    }
+    double segundos = agora() - inicio;
+
+    // Desequilíbrio: operações da partição mais carregada sobre a média
+    long long total = 0, maximo = 0, minimo = -1;
+    for (int p = 0; p < numParticoes; p++) {
+        long long feitas = atomic_load(&servico.particoes[p].operacoes) - antes[p];
+        total += feitas;
+        if (feitas > maximo) maximo = feitas;
+        if (minimo < 0 || feitas < minimo) minimo = feitas;
+    }
+    double media = (double)total / numParticoes;
+
+    // Consultas de intervalo (as threads dos clientes já terminaram, então a
+    // thread principal pode usar a fila do cliente 0)
+    Cliente *consultas = &clientes[0].cliente;
+    unsigned int estado = 88172645u;
+    long long encontradas = 0;
+    double inicioConsultas = agora();
+    for (int q = 0; q < CONSULTAS_INTERVALO; q++) {
+        int inicioIntervalo = (int)(proximoAleatorio(&estado) & 0x7FFFFFFF);
+        int largura = (int)(0x7FFFFFFFLL * 100 / operacoes);  // Cerca de 50 chaves
+        int fimIntervalo = inicioIntervalo > 0x7FFFFFFF - largura ? 0x7FFFFFFF : inicioIntervalo + largura;
+        consultarIntervalo(consultas, inicioIntervalo, fimIntervalo, contarChave, &encontradas);
+    }
+    double tempoConsultas = agora() - inicioConsultas;
+
+    double vazao = total / segundos;
+    printf("%2d partições: %10.0f ops/s  (%lld sucessos)  desequilíbrio máx/média %.2f, mín/média %.2f  "
+           "intervalo %.1f us (%.1f chaves)\n",
+           numParticoes, vazao, sucessos, maximo / media, minimo / media,
+           tempoConsultas * 1e6 / CONSULTAS_INTERVALO, (double)encontradas / CONSULTAS_INTERVALO);
+    fflush(stdout);
+
+    for (int c = 0; c < numClientes; c++) {
+        liberarCliente(&clientes[c].cliente);
+    }
+    encerrarServico(&servico);
+    free(clientes);
+    free(antes);
+    return vazao;
+}
+
+int main(int argc, char **argv) {
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    int maxParticoes = argc > 1 ? atoi(argv[1]) : (int)(nucleos > 0 ? nucleos : 1);
+    long long operacoes = argc > 2 ? atoll(argv[2]) : 2000000;
+    bool usarZipf = argc > 3 && argv[3][0] == 'z';
+    int numClientes = argc > 4 ? atoi(argv[4]) : 1;
+    if (maxParticoes < 1 || operacoes < 1000 || numClientes < 1) {
+        fprintf(stderr, "Uso: %s [partições] [operações] [uniforme|zipf] [clientes]\n", argv[0]);
+        return 1;
+    }
+
+    GeradorZipf zipf;
+    if (usarZipf) iniciarZipf(&zipf, operacoes);
+
+    printf("%lld operações (50%% buscas, 25%% inserções, 25%% remoções), chaves %s, %d cliente(s), %ld núcleo(s)\n",
+           operacoes, usarZipf ? "Zipf" : "uniformes", numClientes, nucleos);
+    double base = 0;
+    for (int particoes = 1; particoes <= maxParticoes; ) {
+        double vazao = medir(particoes, numClientes, operacoes, usarZipf ? &zipf : NULL);
+        if (particoes == 1) base = vazao;
+        else if (base > 0) printf("   aceleração sobre 1 partição: %.2fx\n", vazao / base);
+
+        // Dobrar, medindo também o máximo quando ele não é potência de 2
+        if (particoes == maxParticoes) break;
+        particoes = particoes * 2 <= maxParticoes ? particoes * 2 : maxParticoes;
+    }
+    return 0;
+}
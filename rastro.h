@@ -0,0 +1,156 @@
+// Rastro das operações de um programa, para reproduzir depois (replay.c).
+//
+// Os menus de arvorebst.c, arvoreRN.c, arvore23.c e lista.c gravam o rastro
+// quando recebem o nome do arquivo na linha de comando:
+//
+//   arvore23 trafego.rastro
+//
+// O arquivo começa com a magia RASTRO_MAGIA (4 bytes) e cada operação ocupa
+// 5 bytes: o código (RASTRO_INSERIR, RASTRO_BUSCAR ou RASTRO_REMOVER) e a
+// chave em 4 bytes little-endian. A gravação passa por um buffer e só vai para
+// o arquivo quando ele enche e em rastroFechar.
+//
+// Só a chave é guardada: a reprodução usa a interface de conjunto.h, então
+// repetidos na lista ou na rubro-negra do menu viram operações de conjunto.
+
+#ifndef RASTRO_H
+#define RASTRO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define RASTRO_INSERIR 'I'
+#define RASTRO_BUSCAR 'B'
+#define RASTRO_REMOVER 'R'
+#define RASTRO_MAGIA 0x4F525452u        // "RTRO" em little-endian
+#define RASTRO_TAMANHO_REGISTRO 5       // Código + chave
+#define RASTRO_BUFFER 65536             // Bytes acumulados antes de gravar
+
+// Uma operação do rastro, como fica na memória durante a reprodução
+typedef struct {
+    int32_t chave;
+    char operacao;
+} OperacaoRastro;
+
+// Rastro sendo gravado
+typedef struct {
+    FILE *arquivo;
+    unsigned char buffer[RASTRO_BUFFER];
+    size_t usado;
+    long long operacoes;    // Operações registradas
+    bool erro;
+} Rastro;
+
+// Gravar o que está no buffer
+static inline void rastroDescarregar(Rastro *rastro) {
+    if (rastro->usado > 0 && fwrite(rastro->buffer, 1, rastro->usado, rastro->arquivo) != rastro->usado) {
+        rastro->erro = true;
+    }
+    rastro->usado = 0;
+}
+
+// Escrever um inteiro de 32 bits little-endian no buffer
+static inline void rastroEscreverInteiro(Rastro *rastro, uint32_t valor) {
+    for (int i = 0; i < 4; i++) {
+        rastro->buffer[rastro->usado++] = (unsigned char)(valor >> (8 * i));
+    }
+}
+
+// Criar o arquivo do rastro (substitui um anterior)
+static inline bool rastroAbrir(Rastro *rastro, const char *nome) {
+    rastro->arquivo = fopen(nome, "wb");
+    if (rastro->arquivo == NULL) {
+        printf("Erro: Não foi possível criar %s!\n", nome);
+        return false;
+    }
+    rastro->usado = 0;
+    rastro->operacoes = 0;
+    rastro->erro = false;
+    rastroEscreverInteiro(rastro, RASTRO_MAGIA);
+    return true;
+}
+
+// Registrar uma operação
+static inline void rastroRegistrar(Rastro *rastro, char operacao, int chave) {
+    if (rastro->usado + RASTRO_TAMANHO_REGISTRO > RASTRO_BUFFER) {
+        rastroDescarregar(rastro);
+    }
+    rastro->buffer[rastro->usado++] = (unsigned char)operacao;
+    rastroEscreverInteiro(rastro, (uint32_t)chave);
+    rastro->operacoes++;
+}
+
+// Gravar o restante e fechar (false se alguma gravação falhou)
+static inline bool rastroFechar(Rastro *rastro) {
+    rastroDescarregar(rastro);
+    if (fclose(rastro->arquivo) != 0) {
+        rastro->erro = true;
+    }
+    return !rastro->erro;
+}
+
+// Ler o rastro inteiro para a memória. Um final incompleto (programa
+// interrompido no meio de uma gravação) é ignorado. Devolve o vetor alocado
+// (liberar com free) e a quantidade de operações, ou NULL em caso de erro.
+static inline OperacaoRastro* rastroCarregar(const char *nome, long long *n) {
+    *n = 0;
+    FILE *arquivo = fopen(nome, "rb");
+    if (arquivo == NULL) {
+        printf("Erro: Não foi possível abrir %s!\n", nome);
+        return NULL;
+    }
+
+    unsigned char cabecalho[4];
+    fseek(arquivo, 0, SEEK_END);
+    long tamanho = ftell(arquivo);
+    fseek(arquivo, 0, SEEK_SET);
+    if (tamanho < 4 || fread(cabecalho, 1, 4, arquivo) != 4 ||
+        (cabecalho[0] | cabecalho[1] << 8 | cabecalho[2] << 16 | (uint32_t)cabecalho[3] << 24) != RASTRO_MAGIA) {
+        printf("Erro: %s não é um rastro válido!\n", nome);
+        fclose(arquivo);
+        return NULL;
+    }
+
+    long long quantidade = (tamanho - 4) / RASTRO_TAMANHO_REGISTRO;
+    OperacaoRastro *operacoes = (OperacaoRastro*)malloc(sizeof(OperacaoRastro) * (quantidade > 0 ? quantidade : 1));
+    unsigned char *bloco = (unsigned char*)malloc(RASTRO_BUFFER);
+    if (operacoes == NULL || bloco == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        free(operacoes);
+        free(bloco);
+        fclose(arquivo);
+        return NULL;
+    }
+
+    // Em blocos de registros inteiros
+    long long lidas = 0;
+    const size_t porBloco = RASTRO_BUFFER / RASTRO_TAMANHO_REGISTRO;
+    while (lidas < quantidade) {
+        size_t pedir = quantidade - lidas < (long long)porBloco ? (size_t)(quantidade - lidas) : porBloco;
+        if (fread(bloco, RASTRO_TAMANHO_REGISTRO, pedir, arquivo) != pedir) break;
+        for (size_t i = 0; i < pedir; i++) {
+            const unsigned char *registro = bloco + i * RASTRO_TAMANHO_REGISTRO;
+            char operacao = (char)registro[0];
+            if (operacao != RASTRO_INSERIR && operacao != RASTRO_BUSCAR && operacao != RASTRO_REMOVER) {
+                printf("Erro: Operação inválida na posição %lld de %s!\n", lidas, nome);
+                free(operacoes);
+                free(bloco);
+                fclose(arquivo);
+                return NULL;
+            }
+            operacoes[lidas].operacao = operacao;
+            operacoes[lidas].chave = (int32_t)(registro[1] | registro[2] << 8 | registro[3] << 16 |
+                                               (uint32_t)registro[4] << 24);
+            lidas++;
+        }
+    }
+
+    free(bloco);
+    fclose(arquivo);
+    *n = lidas;
+    return operacoes;
+}
+
+#endif
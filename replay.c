@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "conjunto.h"
+#include "rastro.h"
+
+// Reprodução de um rastro (rastro.h) nas estruturas de conjunto.h, na
+// velocidade máxima: o rastro é lido inteiro antes e o laço medido só chama
+// a interface, sem entrada e saída.
+// Compilar (as estruturas entram como módulos, sem os menus):
+//   gcc -O2 -DSEM_MAIN replay.c arvorebst.c arvoreRN.c arvore23.c lista.c -o replay -pthread
+//
+// Uso:
+//   replay trafego.rastro                 todas as estruturas, uma vez
+//   replay trafego.rastro 23 5            só a árvore 2-3, melhor de 5
+//
+// A lista custa O(n) por operação: em rastros grandes, escolha a estrutura.
+//
+// A saída é CSV, uma linha por estrutura. Os sucessos (inserções de chaves
+// novas, buscas que acharam e remoções de chaves presentes) têm que ser
+// iguais em todas as estruturas e em todas as versões de uma mesma: assim uma
+// comparação A/B de duas versões também confere que o resultado não mudou.
+// Com -DCONTADORES=1 as colunas finais trazem os contadores (contadores.h)
+// da última repetição.
+
+static const char *nomesEstruturas[] = { "bst", "rn", "23", "lista" };
+static const OperacoesConjunto *estruturas[] = { &conjuntoBST, &conjuntoRN, &conjuntoArvore23, &conjuntoLista };
+#define NUM_ESTRUTURAS 4
+
+// Instante atual em segundos (relógio monotônico)
+static double agora() {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return instante.tv_sec + instante.tv_nsec / 1e9;
+}
+
+// Reproduzir o rastro numa estrutura, repeticoes vezes, e escrever a linha do
+// CSV com a melhor repetição
+static int reproduzir(int estrutura, const OperacaoRastro *operacoes, long long n, int repeticoes) {
+    double melhor = 0;
+    long long sucessos = 0, tamanho = 0;
+    int altura = 0;
+    Contadores medidos;
+
+    for (int r = 0; r < repeticoes; r++) {
+        Conjunto conjunto = conjuntoCriar(estruturas[estrutura]);
+        if (conjunto.estado == NULL) {
+            fprintf(stderr, "Erro: Falha na alocação de memória!\n");
+            return 1;
+        }
+        Contadores *contadores = conjuntoContadores(&conjunto);
+        zerarContadores(contadores);
+
+        long long sucessosRepeticao = 0;
+        double inicio = agora();
+        for (long long i = 0; i < n; i++) {
+            switch (operacoes[i].operacao) {
+                case RASTRO_INSERIR: sucessosRepeticao += conjuntoInserir(&conjunto, operacoes[i].chave); break;
+                case RASTRO_BUSCAR: sucessosRepeticao += conjuntoContem(&conjunto, operacoes[i].chave); break;
+                default: sucessosRepeticao += conjuntoRemover(&conjunto, operacoes[i].chave); break;
+            }
+        }
+        double segundos = agora() - inicio;
+        medidos = *contadores;
+
+        if (r == 0 || segundos < melhor) melhor = segundos;
+        sucessos = sucessosRepeticao;
+        tamanho = conjuntoTamanho(&conjunto);
+        altura = conjuntoAltura(&conjunto);
+        conjuntoDestruir(&conjunto);
+    }
+
+    if (melhor <= 0) melhor = 1e-9;
+    printf("%s,%lld,%d,%.6f,%.1f,%.0f,%lld,%lld,%d,", nomesEstruturas[estrutura], n, repeticoes,
+           melhor, n > 0 ? melhor * 1e9 / n : 0.0, n / melhor, sucessos, tamanho, altura);
+    escreverContadoresCSV(stdout, &medidos);
+    printf("\n");
+    fflush(stdout);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 4) {
+        fprintf(stderr, "Uso: %s rastro [bst|rn|23|lista] [repetições]\n", argv[0]);
+        return 1;
+    }
+
+    int escolhida = -1;
+    if (argc >= 3) {
+        for (int i = 0; i < NUM_ESTRUTURAS; i++) {
+            if (strcmp(argv[2], nomesEstruturas[i]) == 0) escolhida = i;
+        }
+        if (escolhida < 0) {
+            fprintf(stderr, "Estrutura desconhecida: %s\n", argv[2]);
+            return 1;
+        }
+    }
+    int repeticoes = argc == 4 ? atoi(argv[3]) : 1;
+    if (repeticoes < 1) repeticoes = 1;
+
+    long long n;
+    OperacaoRastro *operacoes = rastroCarregar(argv[1], &n);
+    if (operacoes == NULL) return 1;
+
+    // Composição do rastro, para conferir que é o esperado
+    long long insercoes = 0, buscas = 0, remocoes = 0;
+    for (long long i = 0; i < n; i++) {
+        if (operacoes[i].operacao == RASTRO_INSERIR) insercoes++;
+        else if (operacoes[i].operacao == RASTRO_BUSCAR) buscas++;
+        else remocoes++;
+    }
+    fprintf(stderr, "%s: %lld operações (%lld inserções, %lld buscas, %lld remoções)\n",
+            argv[1], n, insercoes, buscas, remocoes);
+
+    printf("estrutura,operacoes,repeticoes,segundos,ns_por_op,ops_por_s,sucessos,tamanho_final,altura,"
+           CONTADORES_CABECALHO_CSV "\n");
+    int resultado = 0;
+    for (int i = 0; i < NUM_ESTRUTURAS; i++) {
+        if (escolhida < 0 || escolhida == i) {
+            resultado |= reproduzir(i, operacoes, n, repeticoes);
+        }
+    }
+
+    free(operacoes);
+    return resultado;
+}
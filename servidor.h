@@ -0,0 +1,428 @@
+// Modo servidor dos programas de árvore: o conjunto (conjunto.h) fica num
+// processo que atende pedidos por um socket Unix local, sem passar pelo menu.
+//
+//   arvore23 -s /tmp/arvore23.sock
+//
+// O protocolo é binário, com inteiros de 32 bits little-endian. Cada pedido é
+// um código seguido da chave (ou do intervalo):
+//
+//   'I' chave          inserir    -> 1 byte: 1 se a chave era nova
+//   'B' chave          buscar     -> 1 byte: 1 se achou
+//   'R' chave          remover    -> 1 byte: 1 se a chave estava
+//   'V' inicio fim     intervalo  -> quantidade (4 bytes) e as chaves em ordem
+//
+// O cliente pode mandar vários pedidos sem esperar as respostas (pipeline).
+// A cada leitura o servidor executa todos os pedidos completos que chegaram
+// como um lote e devolve as respostas, na ordem dos pedidos, numa escrita só.
+// Os sockets dos clientes não bloqueiam: o que o socket não aceitar na hora
+// fica na saída da conexão e é enviado quando o poll indicar espaço, sem
+// parar o atendimento dos outros clientes. Enquanto uma conexão tiver mais de
+// SERVIDOR_LIMITE_SAIDA bytes de respostas pendentes, o servidor não lê
+// pedidos novos dela (um cliente que não lê as respostas não faz a memória
+// crescer sem limite).
+// Dentro do lote, as inserções, buscas e remoções entre dois intervalos são
+// executadas em ordem de chave (pedidos da mesma chave na ordem de chegada):
+// o resultado é o mesmo, porque operações de chaves diferentes não interferem,
+// e as descidas passam da esquerda para a direita pela estrutura, reaproveitando
+// no cache o caminho do pedido anterior.
+//
+// Um código desconhecido encerra a conexão, depois de enviar as respostas dos
+// pedidos anteriores a ele. Se o cliente fecha a escrita (shutdown), o
+// servidor ainda executa os pedidos que chegaram e envia as respostas antes de
+// fechar. O servidor atende até SERVIDOR_MAX_CLIENTES conexões em uma thread
+// só (a estrutura não é compartilhada entre threads) e termina com Ctrl+C ou
+// SIGTERM. carga.c é o gerador de carga correspondente.
+
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "conjunto.h"
+
+#define SERVIDOR_INSERIR 'I'
+#define SERVIDOR_BUSCAR 'B'
+#define SERVIDOR_REMOVER 'R'
+#define SERVIDOR_INTERVALO 'V'
+#define SERVIDOR_MAX_CLIENTES 64
+#define SERVIDOR_BUFFER 65536           // Bytes de pedidos lidos por vez
+#define SERVIDOR_LIMITE_SAIDA (4 * SERVIDOR_BUFFER)  // Respostas pendentes que suspendem a leitura
+
+// Tamanho de um pedido com o código dado (0 se o código é desconhecido)
+static inline int servidorTamanhoPedido(unsigned char codigo) {
+    switch (codigo) {
+        case SERVIDOR_INSERIR:
+        case SERVIDOR_BUSCAR:
+        case SERVIDOR_REMOVER:
+            return 5;
+        case SERVIDOR_INTERVALO:
+            return 9;
+        default:
+            return 0;
+    }
+}
+
+// Ler e escrever inteiros de 32 bits little-endian
+static inline int32_t servidorLerInteiro(const unsigned char *bytes) {
+    return (int32_t)(bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t)bytes[3] << 24);
+}
+
+static inline void servidorEscreverInteiro(unsigned char *bytes, uint32_t valor) {
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (unsigned char)(valor >> (8 * i));
+    }
+}
+
+#ifdef _WIN32
+
+static inline int servirConjunto(const OperacoesConjunto *operacoes, const char *caminho) {
+    (void)operacoes;
+    (void)caminho;
+    printf("Erro: O modo servidor usa sockets Unix e não está disponível no Windows!\n");
+    return 1;
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Respostas de um lote, acumuladas para uma escrita só
+typedef struct {
+    unsigned char *bytes;
+    size_t usado;
+    size_t capacidade;
+} SaidaServidor;
+
+// Uma conexão, os bytes de pedidos ainda incompletos e as respostas que o
+// socket ainda não aceitou (saida.bytes[enviado, saida.usado))
+typedef struct {
+    int fd;
+    unsigned char entrada[SERVIDOR_BUFFER];
+    size_t usado;
+    SaidaServidor saida;
+    size_t enviado;
+    bool encerrando;    // Código desconhecido: fechar depois de enviar a saída
+    bool fimEntrada;    // O cliente fechou a escrita: atender o que já chegou e fechar
+} ConexaoServidor;
+
+// Um pedido pontual do lote, para executar em ordem de chave
+typedef struct {
+    int32_t chave;
+    int posicao;        // Ordem no trecho (desempate e lugar da resposta)
+    unsigned char codigo;
+} PedidoServidor;
+
+static volatile sig_atomic_t servidorParar = 0;
+
+static inline void servidorSinal(int sinal) {
+    (void)sinal;
+    servidorParar = 1;
+}
+
+// Garantir espaço para mais bytes na saída
+static inline void servidorReservar(SaidaServidor *saida, size_t bytes) {
+    if (saida->usado + bytes <= saida->capacidade) return;
+
+    size_t capacidade = saida->capacidade > 0 ? saida->capacidade : SERVIDOR_BUFFER;
+    while (capacidade < saida->usado + bytes) {
+        capacidade *= 2;
+    }
+    unsigned char *novos = (unsigned char*)realloc(saida->bytes, capacidade);
+    if (novos == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        exit(1);
+    }
+    saida->bytes = novos;
+    saida->capacidade = capacidade;
+}
+
+// Visitante da consulta de intervalo: acrescenta a chave à resposta
+static inline void servidorAcrescentarChave(int chave, void *contexto) {
+    SaidaServidor *saida = (SaidaServidor*)contexto;
+    servidorReservar(saida, 4);
+    servidorEscreverInteiro(saida->bytes + saida->usado, (uint32_t)chave);
+    saida->usado += 4;
+}
+
+static inline int servidorCompararPedidos(const void *a, const void *b) {
+    const PedidoServidor *x = (const PedidoServidor*)a;
+    const PedidoServidor *y = (const PedidoServidor*)b;
+    if (x->chave != y->chave) return x->chave < y->chave ? -1 : 1;
+    return x->posicao - y->posicao;
+}
+
+// Executar os n pedidos pontuais em ordem de chave; a resposta de cada um vai
+// para respostas[posicao]
+static inline void servidorExecutarTrecho(Conjunto *conjunto, PedidoServidor *pedidos, int n, unsigned char *respostas) {
+    qsort(pedidos, n, sizeof(PedidoServidor), servidorCompararPedidos);
+    for (int i = 0; i < n; i++) {
+        bool resultado;
+        switch (pedidos[i].codigo) {
+            case SERVIDOR_INSERIR: resultado = conjuntoInserir(conjunto, pedidos[i].chave); break;
+            case SERVIDOR_BUSCAR: resultado = conjuntoContem(conjunto, pedidos[i].chave); break;
+            default: resultado = conjuntoRemover(conjunto, pedidos[i].chave); break;
+        }
+        respostas[pedidos[i].posicao] = resultado;
+    }
+}
+
+// Executar os pedidos completos de bytes[0, n) e acumular as respostas na
+// saída. Retorna quantos bytes foram consumidos; num código desconhecido para
+// ali e marca *invalido. Também para quando a saída passa de
+// SERVIDOR_LIMITE_SAIDA bytes: o resto fica para quando ela esvaziar.
+static inline size_t servidorExecutarLote(Conjunto *conjunto, const unsigned char *bytes, size_t n,
+                                          SaidaServidor *saida, PedidoServidor *pedidos, long long *executados,
+                                          bool *invalido) {
+    size_t lido = 0;
+    *invalido = false;
+    while (lido < n && !*invalido && saida->usado < SERVIDOR_LIMITE_SAIDA) {
+        // Trecho de pedidos pontuais até o próximo intervalo (ou o fim)
+        int quantidade = 0;
+        while (lido < n && bytes[lido] != SERVIDOR_INTERVALO) {
+            int tamanho = servidorTamanhoPedido(bytes[lido]);
+            if (tamanho == 0) {
+                *invalido = true;
+                break;
+            }
+            if (lido + tamanho > n) break;
+            pedidos[quantidade].codigo = bytes[lido];
+            pedidos[quantidade].chave = servidorLerInteiro(bytes + lido + 1);
+            pedidos[quantidade].posicao = quantidade;
+            quantidade++;
+            lido += tamanho;
+        }
+        if (quantidade > 0) {
+            servidorReservar(saida, quantidade);
+            servidorExecutarTrecho(conjunto, pedidos, quantidade, saida->bytes + saida->usado);
+            saida->usado += quantidade;
+            *executados += quantidade;
+        }
+
+        // Intervalo: a quantidade vai na frente das chaves, preenchida depois
+        if (*invalido || lido + 9 > n || bytes[lido] != SERVIDOR_INTERVALO) break;
+        int inicio = servidorLerInteiro(bytes + lido + 1);
+        int fim = servidorLerInteiro(bytes + lido + 5);
+        lido += 9;
+        servidorReservar(saida, 4);
+        size_t posicaoQuantidade = saida->usado;
+        saida->usado += 4;
+        conjuntoPercorrerIntervalo(conjunto, inicio, fim, servidorAcrescentarChave, saida);
+        servidorEscreverInteiro(saida->bytes + posicaoQuantidade,
+                                (uint32_t)((saida->usado - posicaoQuantidade - 4) / 4));
+        (*executados)++;
+    }
+    return lido;
+}
+
+// Escrever tudo num socket bloqueante (o socket pode aceitar só parte de uma
+// vez); é o que o cliente (carga.c) usa
+static inline bool servidorEscreverTudo(int fd, const unsigned char *bytes, size_t n) {
+    while (n > 0) {
+        ssize_t escritos = write(fd, bytes, n);
+        if (escritos < 0 && errno == EINTR) continue;
+        if (escritos <= 0) return false;
+        bytes += escritos;
+        n -= (size_t)escritos;
+    }
+    return true;
+}
+
+// Respostas da conexão ainda não enviadas
+static inline size_t servidorPendente(const ConexaoServidor *conexao) {
+    return conexao->saida.usado - conexao->enviado;
+}
+
+// Enviar o quanto o socket (não bloqueante) aceitar da saída da conexão.
+// Retorna false se a conexão falhou.
+static inline bool servidorEnviar(ConexaoServidor *conexao) {
+    while (servidorPendente(conexao) > 0) {
+        ssize_t escritos = write(conexao->fd, conexao->saida.bytes + conexao->enviado, servidorPendente(conexao));
+        if (escritos < 0 && errno == EINTR) continue;
+        if (escritos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;  // Resto no próximo POLLOUT
+        if (escritos <= 0) return false;
+        conexao->enviado += (size_t)escritos;
+    }
+    conexao->saida.usado = 0;
+    conexao->enviado = 0;
+    return true;
+}
+
+// Executar os pedidos completos da entrada da conexão e enviar as respostas.
+// Se o lote parou no limite da saída e o envio a esvaziou, continua com os
+// pedidos que sobraram (nenhum evento do poll chamaria de novo). Retorna
+// false se a conexão falhou.
+static inline bool servidorAtender(Conjunto *conjunto, ConexaoServidor *conexao, PedidoServidor *pedidos,
+                                   long long *executados, long long *lotes) {
+    for (;;) {
+        // O que já foi enviado sai da frente da saída antes do lote novo
+        if (conexao->enviado > 0) {
+            conexao->saida.usado -= conexao->enviado;
+            memmove(conexao->saida.bytes, conexao->saida.bytes + conexao->enviado, conexao->saida.usado);
+            conexao->enviado = 0;
+        }
+
+        bool invalido;
+        size_t consumidos = servidorExecutarLote(conjunto, conexao->entrada, conexao->usado,
+                                                 &conexao->saida, pedidos, executados, &invalido);
+        if (consumidos > 0) (*lotes)++;
+        // Os pedidos antes de um código inválido ainda são respondidos
+        conexao->encerrando = invalido;
+
+        // O pedido incompleto do fim (ou os que esperam a saída esvaziar) vai
+        // para o começo do buffer
+        conexao->usado -= consumidos;
+        memmove(conexao->entrada, conexao->entrada + consumidos, conexao->usado);
+        if (!servidorEnviar(conexao)) return false;
+        if (consumidos == 0 || invalido || servidorPendente(conexao) >= SERVIDOR_LIMITE_SAIDA) return true;
+    }
+}
+
+// Atender pedidos no socket Unix caminho até Ctrl+C ou SIGTERM. Retorna o
+// código de saída do programa.
+static inline int servirConjunto(const OperacoesConjunto *operacoes, const char *caminho) {
+    struct sockaddr_un endereco;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        printf("Erro: Caminho do socket muito longo!\n");
+        return 1;
+    }
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+
+    int escuta = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(caminho);
+    if (escuta < 0 || bind(escuta, (struct sockaddr*)&endereco, sizeof(endereco)) < 0 || listen(escuta, SOMAXCONN) < 0) {
+        printf("Erro: Não foi possível escutar em %s!\n", caminho);
+        if (escuta >= 0) close(escuta);
+        return 1;
+    }
+
+    // Sem SA_RESTART: o sinal interrompe o poll e o laço termina
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = servidorSinal;
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+    signal(SIGPIPE, SIG_IGN);  // Cliente que fechou: a escrita falha e a conexão é encerrada
+
+    Conjunto conjunto = conjuntoCriar(operacoes);
+    ConexaoServidor *conexoes = (ConexaoServidor*)malloc(sizeof(ConexaoServidor) * SERVIDOR_MAX_CLIENTES);
+    PedidoServidor *pedidos = (PedidoServidor*)malloc(sizeof(PedidoServidor) * (SERVIDOR_BUFFER / 5));
+    if (conjunto.estado == NULL || conexoes == NULL || pedidos == NULL) {
+        printf("Erro: Falha na alocação de memória!\n");
+        conjuntoDestruir(&conjunto);
+        free(conexoes);
+        free(pedidos);
+        close(escuta);
+        unlink(caminho);
+        return 1;
+    }
+    struct pollfd eventos[SERVIDOR_MAX_CLIENTES + 1];
+    int numConexoes = 0;
+    long long executados = 0, lotes = 0;
+
+    printf("Servidor (%s) em %s. Ctrl+C para encerrar.\n", operacoes->nome, caminho);
+    fflush(stdout);
+
+    while (!servidorParar) {
+        eventos[0].fd = escuta;
+        eventos[0].events = numConexoes < SERVIDOR_MAX_CLIENTES ? POLLIN : 0;
+        for (int i = 0; i < numConexoes; i++) {
+            eventos[i + 1].fd = conexoes[i].fd;
+            eventos[i + 1].events = 0;
+            if (!conexoes[i].encerrando && !conexoes[i].fimEntrada &&
+                servidorPendente(&conexoes[i]) < SERVIDOR_LIMITE_SAIDA && conexoes[i].usado < SERVIDOR_BUFFER) {
+                eventos[i + 1].events |= POLLIN;
+            }
+            if (servidorPendente(&conexoes[i]) > 0) {
+                eventos[i + 1].events |= POLLOUT;
+            }
+        }
+        if (poll(eventos, numConexoes + 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        // Conexões de trás para frente: uma encerrada é trocada pela última
+        for (int i = numConexoes - 1; i >= 0; i--) {
+            short revents = eventos[i + 1].revents;
+            if (revents == 0) continue;
+
+            ConexaoServidor *conexao = &conexoes[i];
+            // Sem leitura pendente, POLLHUP quer dizer que as respostas não têm mais para onde ir
+            bool encerrar = (revents & (POLLERR | POLLNVAL)) != 0 ||
+                            ((revents & POLLHUP) && !(eventos[i + 1].events & POLLIN));
+            if (!encerrar && (revents & POLLOUT)) {
+                encerrar = !servidorEnviar(conexao);
+                // Pedidos já lidos que esperavam a saída esvaziar
+                if (!encerrar && !conexao->encerrando && servidorPendente(conexao) < SERVIDOR_LIMITE_SAIDA) {
+                    encerrar = !servidorAtender(&conjunto, conexao, pedidos, &executados, &lotes);
+                }
+            }
+            if (!encerrar && (eventos[i + 1].events & POLLIN) && (revents & (POLLIN | POLLHUP))) {
+                ssize_t lidos = read(conexao->fd, conexao->entrada + conexao->usado, SERVIDOR_BUFFER - conexao->usado);
+                if (lidos == 0) {
+                    // Fim dos pedidos (shutdown do cliente): as respostas ainda vão
+                    conexao->fimEntrada = true;
+                } else if (lidos < 0 && errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+                    encerrar = true;
+                } else if (lidos > 0) {
+                    conexao->usado += (size_t)lidos;
+                    encerrar = !servidorAtender(&conjunto, conexao, pedidos, &executados, &lotes);
+                }
+            }
+            // Sem saída pendente, servidorAtender já executou todos os pedidos completos
+            if (!encerrar && (conexao->encerrando || conexao->fimEntrada) && servidorPendente(conexao) == 0) {
+                encerrar = true;
+            }
+            if (encerrar) {
+                close(conexao->fd);
+                free(conexao->saida.bytes);
+                conexoes[i] = conexoes[--numConexoes];
+            }
+        }
+
+        if (eventos[0].revents & POLLIN) {
+            int fd = accept(escuta, NULL, NULL);
+            if (fd >= 0 && fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) < 0) {
+                close(fd);
+                fd = -1;
+            }
+            if (fd >= 0) {
+                ConexaoServidor *conexao = &conexoes[numConexoes++];
+                conexao->fd = fd;
+                conexao->usado = 0;
+                conexao->saida = (SaidaServidor){ NULL, 0, 0 };
+                conexao->enviado = 0;
+                conexao->encerrando = false;
+                conexao->fimEntrada = false;
+            }
+        }
+    }
+
+    printf("\nServidor encerrado: %lld pedidos em %lld lotes (%.1f por lote), %lld chaves no conjunto.\n",
+           executados, lotes, lotes > 0 ? (double)executados / lotes : 0.0, conjuntoTamanho(&conjunto));
+    for (int i = 0; i < numConexoes; i++) {
+        close(conexoes[i].fd);
+        free(conexoes[i].saida.bytes);
+    }
+    close(escuta);
+    unlink(caminho);
+    conjuntoDestruir(&conjunto);
+    free(pedidos);
+    free(conexoes);
+    return 0;
+}
+
+#endif
+
+#endif